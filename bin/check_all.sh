@@ -101,7 +101,7 @@ do
 done
 #
 # extra speed tests not run with option specified
-for option in onetape colpack optimize atomic memory boolsparsity
+for option in onetape colpack acyclic optimize atomic memory boolsparsity
 do
 	echo_eval speed/cppad/speed_cppad correct 432 $option
 done
@@ -0,0 +1,428 @@
+/* $Id$ */
+# ifndef CPPAD_C_KERNEL_INCLUDED
+# define CPPAD_C_KERNEL_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin c_kernel$$
+$spell
+	const
+	std
+	cmd
+	msg
+	dir
+	dlopen
+	ldl
+	hpp
+	cc
+	fPIC
+	str
+	dw
+	so
+	CppAD
+$$
+
+$index c_kernel$$
+$index compile, ADFun$$
+$index load, compiled ADFun$$
+$index shared library, ADFun$$
+
+$section Compile and Load C Source Code for an ADFun Object$$
+
+$head Syntax$$
+$codei%# include <cppad/c_kernel.hpp>
+%$$
+$codei%CppAD::c_kernel %kernel%(%name%, %source%, %err_msg%)
+%$$
+$codei%CppAD::c_kernel %kernel%(%name%, %source%, %err_msg%, %compile_cmd%)
+%$$
+$codei%CppAD::c_kernel %kernel%(
+	%name%, %source%, %err_msg%, %compile_cmd%, %dir%
+)
+%$$
+$icode%y% = %kernel%.Forward(0, %x%)
+%$$
+$icode%dy% = %kernel%.Forward(1, %dx%)
+%$$
+$icode%dw% = %kernel%.Reverse(1, %w%)
+%$$
+
+$head Purpose$$
+Compiles the C source code generated by $cref c_source$$
+into a shared library, loads the library (using $code dlopen$$), and
+evaluates the corresponding functions using the same syntax as
+$cref Forward$$ and $cref Reverse$$.
+
+$head Include$$
+This file is not included by $code cppad/cppad.hpp$$.
+It uses the POSIX routines $code dlopen$$, $code dlsym$$ and $code dlclose$$,
+so programs that include it must be linked with the corresponding library;
+e.g., using $code -ldl$$ on Linux.
+
+$head name$$
+This argument has prototype
+$codei%
+	const std::string& %name%
+%$$
+and is the $cref/name/c_source/name/$$ used to generate the source.
+It must be a valid C identifier; i.e., it must be non-empty,
+contain only the characters $code A-Z$$, $code a-z$$, $code 0-9$$
+and $code _$$, and not begin with a digit.
+Otherwise $icode err_msg$$ is set and nothing is compiled.
+
+$head source$$
+This argument has prototype
+$codei%
+	const std::string& %source%
+%$$
+and is the C source code written by
+$codei%
+	%f%.c_source(%name%, %os%)
+%$$
+where $icode os$$ is a $code std::ostringstream$$ and
+$icode%source% = %os%.str()%$$.
+
+$head err_msg$$
+This argument has prototype
+$codei%
+	std::string& %err_msg%
+%$$
+Its input value does not matter.
+If upon return it is empty, the library was compiled and loaded.
+Otherwise it contains a description of the error and
+$icode kernel$$ cannot be used.
+
+$head compile_cmd$$
+This argument has prototype
+$codei%
+	const std::string& %compile_cmd%
+%$$
+and its default value is $code cc -O2 -fPIC -shared$$.
+The source code is written to $icode%dir%/%name%.c%$$ and the command
+$codei%
+	%compile_cmd% '%dir%/%name%.c' -o '%dir%/lib%name%.so'
+%$$
+is executed using $code std::system$$.
+The two file names are single quoted (with any single quote in
+$icode dir$$ escaped) so that they are not interpreted by the shell.
+The value of $icode compile_cmd$$ is passed to the shell as is.
+
+$head dir$$
+This argument has prototype
+$codei%
+	const std::string& %dir%
+%$$
+and its default value is $code .$$ (the current working directory).
+It is the directory where the source file and library are written.
+
+$head Forward$$
+The vectors $icode x$$ and $icode dx$$ have size $icode n$$
+and the return values $icode y$$ and $icode dy$$ have size $icode m$$
+where $icode n$$ and $icode m$$ are the domain and range sizes for
+the function; see $cref/forward0/c_source/Functions/forward0/$$ and
+$cref/forward1/c_source/Functions/forward1/$$.
+The zero order values $icode x$$ are stored in $icode kernel$$ and must
+be set before first order forward or reverse mode is used.
+
+$head Reverse$$
+The vector $icode w$$ has size $icode m$$
+and the return value $icode dw$$ has size $icode n$$;
+see $cref/reverse1/c_source/Functions/reverse1/$$.
+
+$head Vector$$
+The type of $icode x$$, $icode dx$$, $icode w$$, and the return values
+is a $cref SimpleVector$$ class with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$code double$$.
+
+$children%
+	example/c_kernel.cpp
+%$$
+$head Example$$
+The file $cref c_kernel.cpp$$
+contains an example and test of this class.
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <cstdlib>
+# include <fstream>
+# include <string>
+# include <dlfcn.h>
+// define CPPAD_NULL
+# include <cppad/configure.hpp>
+# include <cppad/local/define.hpp>
+# include <cppad/vector.hpp>
+# include <cppad/check_simple_vector.hpp>
+# include <cppad/local/cppad_assert.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file c_kernel.hpp
+Compile and load the C source code generated by ADFun<double>::c_source.
+*/
+
+/*!
+Function object that evaluates a compiled and loaded ADFun<double>.
+*/
+class c_kernel {
+private:
+	/// type of the size functions in the library
+	typedef size_t (*size_fun_t)(void);
+	/// type of the zero order forward function in the library
+	typedef void (*forward0_fun_t)(const double*, double*, double*);
+	/// type of the first order forward and reverse functions in the library
+	typedef void (*order1_fun_t)(
+		const double*, double*, const double*, double*
+	);
+
+	/// handle for the library (null if not loaded)
+	void*          handle_;
+	/// zero order forward function
+	forward0_fun_t forward0_;
+	/// first order forward function
+	order1_fun_t   forward1_;
+	/// first order reverse function
+	order1_fun_t   reverse1_;
+	/// domain size
+	size_t         n_;
+	/// range size
+	size_t         m_;
+	/// have the zero order values been computed
+	bool           zero_done_;
+	/// values of the variables for the previous zero order forward
+	vector<double> v_;
+	/// work space for first order forward and reverse
+	vector<double> work_;
+
+	/// address of a symbol in the library (null if not found)
+	void* symbol(const std::string& name)
+	{	return dlsym(handle_, name.c_str()); }
+
+	/// is name a valid C identifier
+	static bool c_identifier(const std::string& name)
+	{	if( name.size() == 0 || ('0' <= name[0] && name[0] <= '9') )
+			return false;
+		for(size_t i = 0; i < name.size(); i++)
+		{	char c = name[i];
+			bool ok = ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z')
+			       || ('0' <= c && c <= '9') || c == '_';
+			if( ! ok )
+				return false;
+		}
+		return true;
+	}
+
+	/// single quote a file name for the shell
+	/// (each single quote in the name becomes '\'')
+	static std::string shell_quote(const std::string& file)
+	{	std::string result = "'";
+		for(size_t i = 0; i < file.size(); i++)
+		{	if( file[i] == '\'' )
+				result += "'\\''";
+			else
+				result += file[i];
+		}
+		result += "'";
+		return result;
+	}
+
+	// not implemented (the library handle cannot be shared)
+	c_kernel(const c_kernel& other);
+	void operator=(const c_kernel& other);
+public:
+	/*!
+	Compile and load the library.
+
+	\param name
+	is the prefix for the names of the C functions
+	(it must be a valid C identifier).
+
+	\param source
+	is the C source code.
+
+	\param err_msg
+	is empty upon return if no error occurred.
+	Otherwise it is an error message.
+
+	\param compile_cmd
+	is the command used to compile the source into a shared library.
+
+	\param dir
+	is the directory where the source and library are written.
+	*/
+	c_kernel(
+		const std::string& name                                   ,
+		const std::string& source                                 ,
+		std::string&       err_msg                                ,
+		const std::string& compile_cmd = "cc -O2 -fPIC -shared"   ,
+		const std::string& dir         = "."                      )
+	: handle_(CPPAD_NULL), forward0_(CPPAD_NULL),
+	  forward1_(CPPAD_NULL), reverse1_(CPPAD_NULL),
+	  n_(0), m_(0), zero_done_(false)
+	{	err_msg = "";
+		if( ! c_identifier(name) )
+		{	err_msg = "c_kernel: name is not a valid C identifier: " + name;
+			return;
+		}
+		std::string src_file = dir + "/" + name + ".c";
+		std::string lib_file = dir + "/lib" + name + ".so";
+
+		// write the source
+		std::ofstream src( src_file.c_str() );
+		src << source;
+		src.close();
+		if( ! src )
+		{	err_msg = "c_kernel: cannot write " + src_file;
+			return;
+		}
+
+		// compile the source
+		std::string cmd = compile_cmd + " " + shell_quote(src_file)
+			+ " -o " + shell_quote(lib_file);
+		if( std::system( cmd.c_str() ) != 0 )
+		{	err_msg = "c_kernel: command failed: " + cmd;
+			return;
+		}
+
+		// load the library
+		handle_ = dlopen(lib_file.c_str(), RTLD_NOW | RTLD_LOCAL);
+		if( handle_ == CPPAD_NULL )
+		{	err_msg = "c_kernel: dlopen failed: " + std::string( dlerror() );
+			return;
+		}
+
+		// functions in the library
+		// (conversion of the void* address to a function pointer)
+		size_fun_t domain, range, size_var;
+		*reinterpret_cast<void**>(&domain)    = symbol(name + "_domain");
+		*reinterpret_cast<void**>(&range)     = symbol(name + "_range");
+		*reinterpret_cast<void**>(&size_var)  = symbol(name + "_size_var");
+		*reinterpret_cast<void**>(&forward0_) = symbol(name + "_forward0");
+		*reinterpret_cast<void**>(&forward1_) = symbol(name + "_forward1");
+		*reinterpret_cast<void**>(&reverse1_) = symbol(name + "_reverse1");
+		if( domain == CPPAD_NULL || range == CPPAD_NULL ||
+			size_var == CPPAD_NULL || forward0_ == CPPAD_NULL ||
+			forward1_ == CPPAD_NULL || reverse1_ == CPPAD_NULL )
+		{	err_msg = "c_kernel: a function is missing from " + lib_file;
+			dlclose(handle_);
+			handle_ = CPPAD_NULL;
+			return;
+		}
+		n_ = domain();
+		m_ = range();
+		v_.resize( size_var() );
+		work_.resize( size_var() );
+	}
+	/// unload the library
+	~c_kernel(void)
+	{	if( handle_ != CPPAD_NULL )
+			dlclose(handle_);
+	}
+	/// domain size for the function
+	size_t Domain(void) const
+	{	return n_; }
+	/// range size for the function
+	size_t Range(void) const
+	{	return m_; }
+
+	/*!
+	Zero or first order forward mode.
+
+	\param q
+	is the order (zero or one).
+
+	\param xq
+	is the argument value (q = 0) or direction (q = 1).
+
+	\return
+	is the function value (q = 0) or directional derivative (q = 1).
+	*/
+	template <class Vector>
+	Vector Forward(size_t q, const Vector& xq)
+	{	CheckSimpleVector<double, Vector>();
+		CPPAD_ASSERT_KNOWN(
+			handle_ != CPPAD_NULL,
+			"c_kernel: the library was not loaded"
+		);
+		CPPAD_ASSERT_KNOWN(
+			q <= 1,
+			"c_kernel: Forward(q, xq): q is not zero or one"
+		);
+		CPPAD_ASSERT_KNOWN(
+			size_t( xq.size() ) == n_,
+			"c_kernel: Forward(q, xq): xq.size() is not equal domain size"
+		);
+		CPPAD_ASSERT_KNOWN(
+			q == 0 || zero_done_,
+			"c_kernel: Forward(1, xq): Forward(0, x) has not been called"
+		);
+		size_t j, i;
+		vector<double> x(n_), y(m_);
+		for(j = 0; j < n_; j++)
+			x[j] = xq[j];
+		if( q == 0 )
+		{	forward0_(x.data(), y.data(), v_.data());
+			zero_done_ = true;
+		}
+		else	forward1_(x.data(), y.data(), v_.data(), work_.data());
+		Vector yq(m_);
+		for(i = 0; i < m_; i++)
+			yq[i] = y[i];
+		return yq;
+	}
+	/*!
+	First order reverse mode.
+
+	\param q
+	is the order (must be one).
+
+	\param w
+	is the range space weight vector.
+
+	\return
+	is the derivative of the weighted sum of the range components.
+	*/
+	template <class Vector>
+	Vector Reverse(size_t q, const Vector& w)
+	{	CheckSimpleVector<double, Vector>();
+		CPPAD_ASSERT_KNOWN(
+			handle_ != CPPAD_NULL,
+			"c_kernel: the library was not loaded"
+		);
+		CPPAD_ASSERT_KNOWN(
+			q == 1,
+			"c_kernel: Reverse(q, w): q is not one"
+		);
+		CPPAD_ASSERT_KNOWN(
+			size_t( w.size() ) == m_,
+			"c_kernel: Reverse(q, w): w.size() is not equal range size"
+		);
+		CPPAD_ASSERT_KNOWN(
+			zero_done_,
+			"c_kernel: Reverse(1, w): Forward(0, x) has not been called"
+		);
+		size_t j, i;
+		vector<double> wm(m_), dw(n_);
+		for(i = 0; i < m_; i++)
+			wm[i] = w[i];
+		reverse1_(wm.data(), dw.data(), v_.data(), work_.data());
+		Vector dw_out(n_);
+		for(j = 0; j < n_; j++)
+			dw_out[j] = dw[j];
+		return dw_out;
+	}
+};
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -51,11 +51,18 @@ $childtable%
 	cppad/local/drivers.hpp%
 	cppad/local/fun_check.hpp%
 	cppad/local/optimize.hpp%
-	omh/check_for_nan.omh
+	omh/check_for_nan.omh%
+	omh/compact_tape.omh%
+	omh/parallel_team.omh%
+	cppad/local/c_source.hpp%
+	cppad/local/binary_tape.hpp%
+	cppad/local/binary_sparse.hpp
 %$$
 
 $end
 */
+// used by the ADFun parallel mode
+# include <cppad/local/parallel_sweep.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -140,6 +147,9 @@ private:
 	/// for_jac_sparse_set_.n_set() != 0  implies for_sparse_pack_ is empty.
 	CPPAD_INTERNAL_SPARSE_SET  for_jac_sparse_set_;
 
+	/// Parallel mode settings and level schedule for the operation sequence
+	parallel_sweep<Base> par_sweep_;
+
 // ------------------------------------------------------------
 // Private member functions
 
@@ -236,6 +246,25 @@ private:
 		      sparse_jacobian_work& work
 	);
 	// ------------------------------------------------------------
+	// copy zero order forward results (see doxygen in sparse_team.hpp)
+	void taylor0_assign(const ADFun& f);
+	// colors computed by one thread (see doxygen in sparse_team.hpp)
+	static void sparse_team_worker(size_t thread, void* info_vptr);
+	// split sparse Jacobian or Hessian colors among a team of threads
+	// (see doxygen in sparse_team.hpp)
+	template <class VectorBase, class VectorSize>
+	bool SparseTeam(
+		sparse_team_kind               kind        ,
+		size_t                         max_r       ,
+		const VectorBase&              w           ,
+		const CppAD::vector<size_t>&   color       ,
+		const VectorSize&              key         ,
+		const VectorSize&              index       ,
+		const CppAD::vector<size_t>&   order       ,
+		CppAD::vector<size_t>&         team_start  ,
+		VectorBase&                    result
+	);
+	// ------------------------------------------------------------
 	// combined sparse_set, sparse_list and sparse_pack version of 
 	// SparseHessian (see doxygen in sparse_hessian.hpp)
 	template <class VectorBase, class VectorSet, class VectorSize>
@@ -248,6 +277,29 @@ private:
 		      VectorBase&              hes         ,
 		      sparse_hessian_work&     work
 	);
+	// ------------------------------------------------------------
+	// fingerprint for the operation sequence
+	// (see doxygen in binary_sparse.hpp)
+	size_t fingerprint(unsigned int seed) const;
+	// write header, sparsity pattern, row, and col for write_sparse
+	// (see doxygen in binary_sparse.hpp)
+	template <class VectorSet, class VectorSize>
+	void write_sparse_common(
+		std::ostream&                  os          ,
+		binary_sparse_kind             kind        ,
+		const VectorSet&               p           ,
+		const VectorSize&              row         ,
+		const VectorSize&              col
+	) const;
+	// read information written by write_sparse_common
+	// (see doxygen in binary_sparse.hpp)
+	bool read_sparse_common(
+		std::istream&                  is          ,
+		binary_sparse_kind             kind        ,
+		CppAD::vector<size_t>&         pair        ,
+		CppAD::vector<size_t>&         row         ,
+		CppAD::vector<size_t>&         col
+	) const;
 // ------------------------------------------------------------
 public:
 	/// copy constructor
@@ -285,6 +337,23 @@ public:
 	bool check_for_nan(void) const
 	{	return check_for_nan_; }
 
+	/// set the compact form for the operator arguments
+	void compact_tape(bool value)
+	{	play_.compact_arg(value);
+		// level schedule does not support the compact form
+		par_sweep_.clear();
+	}
+	bool compact_tape(void) const
+	{	return play_.compact_arg(); }
+
+	/// set the parallel mode for this function object
+	void parallel_team(
+		typename parallel_sweep<Base>::team_work_t team_work ,
+		size_t                                     min_block = 1000 )
+	{	par_sweep_.set(team_work, min_block);
+		par_sweep_.clear();
+	}
+
 	/// assign a new operation sequence
 	template <typename ADvector>
 	void Dependent(const ADvector &x, const ADvector &y);
@@ -299,10 +368,18 @@ public:
 		const VectorBase& x, std::ostream& s = std::cout
 	);
 
+	/// forward mode user API, zero order for a batch of points.
+	template <typename VectorBase>
+	VectorBase forward0_batch(size_t n_point, const VectorBase& x);
+
 	/// reverse mode sweep
 	template <typename VectorBase>
 	VectorBase Reverse(size_t p, const VectorBase &v);
 
+	/// reverse mode user API, one order multiple weight vectors.
+	template <typename VectorBase>
+	VectorBase Reverse(size_t q, size_t r, const VectorBase& w);
+
 	// forward mode Jacobian sparsity 
 	// (see doxygen documentation in for_sparse_jac.hpp)
 	template <typename VectorSet>
@@ -357,6 +434,10 @@ public:
 	size_t size_op_arg(void) const
 	{	return play_.num_op_arg_rec(); }
 
+	/// number of bytes for the operator arguments in compact form
+	size_t size_op_arg_compact(void) const
+	{	return play_.num_op_arg_compact(); }
+
 	/// amount of memory required for the operation sequence
 	size_t size_op_seq(void) const
 	{	return play_.Memory(); }
@@ -525,6 +606,52 @@ public:
 	// Optimize the tape
 	// (see doxygen documentation in optimize.hpp)
 	void optimize(void);
+
+	/// C source code for zero and first order derivatives
+	bool c_source(const std::string& name, std::ostream& os);
+
+	/// write the operation sequence in binary form
+	void write_binary(std::ostream& os) const;
+
+	/// read an operation sequence written by write_binary
+	bool read_binary(std::istream& is);
+
+	/// write sparsity pattern and coloring for a sparse Jacobian
+	template <class VectorSet, class VectorSize>
+	void write_sparse(
+		std::ostream&               os   ,
+		const VectorSet&            p    ,
+		const VectorSize&           row  ,
+		const VectorSize&           col  ,
+		const sparse_jacobian_work& work
+	) const;
+	/// write sparsity pattern and coloring for a sparse Hessian
+	template <class VectorSet, class VectorSize>
+	void write_sparse(
+		std::ostream&               os   ,
+		const VectorSet&            p    ,
+		const VectorSize&           row  ,
+		const VectorSize&           col  ,
+		const sparse_hessian_work&  work
+	) const;
+	/// read information written by write_sparse for a sparse Jacobian
+	template <class VectorSet, class VectorSize>
+	bool read_sparse(
+		std::istream&               is   ,
+		VectorSet&                  p    ,
+		VectorSize&                 row  ,
+		VectorSize&                 col  ,
+		sparse_jacobian_work&       work
+	) const;
+	/// read information written by write_sparse for a sparse Hessian
+	template <class VectorSet, class VectorSize>
+	bool read_sparse(
+		std::istream&               is   ,
+		VectorSet&                  p    ,
+		VectorSize&                 row  ,
+		VectorSize&                 col  ,
+		sparse_hessian_work&        work
+	) const;
 	// ------------------- Deprecated -----------------------------
 
 	/// deprecated: assign a new operation sequence
@@ -581,6 +708,8 @@ public:
 # include <cppad/local/for_jac_sweep.hpp>
 # include <cppad/local/rev_jac_sweep.hpp>
 # include <cppad/local/rev_hes_sweep.hpp>
+# include <cppad/local/rev_edge_sweep.hpp>
+# include <cppad/local/rev_vec_sweep.hpp>
 
 // user interfaces
 # include <cppad/local/parallel_ad.hpp>
@@ -593,5 +722,8 @@ public:
 # include <cppad/local/fun_check.hpp>
 # include <cppad/local/omp_max_thread.hpp>
 # include <cppad/local/optimize.hpp> 
+# include <cppad/local/c_source.hpp>
+# include <cppad/local/binary_tape.hpp>
+# include <cppad/local/binary_sparse.hpp>
 
 # endif
@@ -3,7 +3,7 @@
 # define CPPAD_ASIN_OP_INCLUDED
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -125,7 +125,7 @@ inline void forward_asin_op_dir(
 	size_t k, ell;
 	size_t m = (q-1) * r + 1;
 	for(ell = 0; ell < r; ell ++)
-	{	Base uq = - 2.0 * x[m + ell] * x[0];
+	{	Base uq = - Base(2) * x[m + ell] * x[0];
 		for(k = 1; k < q; k++)
 			uq -= x[(k-1)*r+1+ell] * x[(q-k-1)*r+1+ell]; 
 		b[m+ell] = Base(0);
@@ -0,0 +1,729 @@
+/* $Id$ */
+# ifndef CPPAD_BINARY_SPARSE_INCLUDED
+# define CPPAD_BINARY_SPARSE_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin binary_sparse$$
+$spell
+	const
+	std
+	ostream
+	istream
+	bool
+	CppAD
+	sizeof
+	Jacobian
+	Hessian
+	jac
+	hes
+	VecAD
+$$
+
+$index binary_sparse$$
+$index write_sparse, ADFun$$
+$index read_sparse, ADFun$$
+$index save, sparsity pattern$$
+$index load, sparsity pattern$$
+$index file, sparse coloring$$
+
+$section Write and Read Sparse Derivative Information in Binary Form$$
+
+$head Syntax$$
+$icode%f%.write_sparse(%os%, %p%, %row%, %col%, %work%)
+%$$
+$icode%ok% = %f%.read_sparse(%is%, %p%, %row%, %col%, %work%)%$$
+
+$head Purpose$$
+Computing a sparsity pattern and the corresponding coloring,
+on the first call to $cref sparse_jacobian$$ or $cref sparse_hessian$$,
+can take a significant amount of time for large functions.
+These routines store this information,
+together with a fingerprint for the operation sequence in $icode f$$,
+in a binary file.
+Another process, that has the same operation sequence
+(for example, by using $cref binary_tape$$),
+can read the information and skip the calculation of the
+sparsity pattern and the coloring.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+	const ADFun<%Base%> %f%
+%$$
+
+$subhead Fingerprint$$
+The fingerprint is a hash code for the operators,
+the operator arguments,
+the $cref VecAD$$ vectors,
+and the independent and dependent variables in the
+operation sequence for $icode f$$.
+It does not depend on the value of the parameters
+(which do not affect the sparsity patterns),
+or on the $cref compact_tape$$ setting.
+
+$head os$$
+This argument has prototype
+$codei%
+	std::ostream& %os%
+%$$
+and should be opened in binary mode.
+
+$head is$$
+This argument has prototype
+$codei%
+	std::istream& %is%
+%$$
+and should be opened in binary mode.
+It is positioned at the beginning of the data written by
+$icode%f%.write_sparse(%os%, %...%)%$$.
+Upon return it is positioned directly after this data
+(if $icode ok$$ is true).
+
+$head p$$
+The argument $icode p$$ is a sparsity pattern with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$code bool$$ or $code std::set<size_t>$$.
+If $icode work$$ is a $code sparse_jacobian_work$$ object,
+$icode p$$ is a sparsity pattern for the Jacobian of $icode f$$
+(as in $cref/sparse_jacobian/sparse_jacobian/p/$$).
+If $icode work$$ is a $code sparse_hessian_work$$ object,
+$icode p$$ is a sparsity pattern for the Hessian
+(as in $cref/sparse_hessian/sparse_hessian/p/$$).
+The argument $icode p$$ is $code const$$ for $code write_sparse$$.
+If $icode ok$$ is true, the output value of $icode p$$ for
+$code read_sparse$$ is the pattern that was written
+(otherwise it is not changed).
+
+$head row, col$$
+These arguments are $cref SimpleVector$$ objects with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$code size_t$$.
+They specify the requested entries, as in
+$cref sparse_jacobian$$ and $cref sparse_hessian$$.
+The arguments are $code const$$ for $code write_sparse$$.
+If $icode ok$$ is true, the output value of $icode row$$ and $icode col$$
+for $code read_sparse$$ are the vectors that were written
+(otherwise they are not changed).
+
+$head work$$
+This argument is either a
+$cref/sparse_jacobian_work/sparse_jacobian/work/$$ or a
+$cref/sparse_hessian_work/sparse_hessian/work/$$ object.
+It is $code const$$ for $code write_sparse$$ and should have been used
+by a call to $code SparseJacobianForward$$, $code SparseJacobianReverse$$,
+or $code SparseHessian$$ with $icode p$$, $icode row$$ and $icode col$$.
+The coloring, and the other information that only depends on the
+sparsity pattern, is written.
+If $icode ok$$ is true, the output value of $icode work$$ for
+$code read_sparse$$ is the same as the object that was written
+and the next call to the sparse driver does not recompute the coloring
+(otherwise $icode work$$ is not changed).
+
+$head ok$$
+The return value has prototype
+$codei%
+	bool %ok%
+%$$
+It is false if the data does not begin with the expected header,
+if the data was written using a different version of CppAD,
+if $code sizeof(size_t)$$ is different from when the data was written,
+if it was written for a different kind of $icode work$$ object,
+if the fingerprint for $icode f$$ is not the same as when the data was
+written,
+if the end of $icode is$$ is reached before all of the data is read,
+or if the data does not pass some simple consistency checks.
+In this case, the sparsity pattern and coloring should be computed
+in the usual way (and can then be written for later use).
+
+$children%
+	example/binary_sparse.cpp
+%$$
+$head Example$$
+The file $cref binary_sparse.cpp$$
+contains an example and test of these operations.
+It returns true if it succeeds and false otherwise.
+
+$end
+-----------------------------------------------------------------------------
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file binary_sparse.hpp
+Write and read sparsity patterns and colorings in binary form.
+*/
+
+/*!
+\def CPPAD_BINARY_SPARSE_VERSION
+Version number for the binary form of the sparse derivative information.
+This must be changed whenever the binary form,
+or the information stored in the work objects, changes.
+*/
+# define CPPAD_BINARY_SPARSE_VERSION 1
+
+/*!
+Characters at the beginning of the binary form of sparse derivative
+information (the terminating '\\0' is not written).
+*/
+inline const char* binary_sparse_magic(void)
+{	return "CppADspr"; }
+
+/// write a size_t value
+inline void binary_sparse_write(std::ostream& os, size_t value)
+{	os.write(reinterpret_cast<const char*>(&value), sizeof(size_t)); }
+
+/// write a vector of size_t values (its length followed by its elements)
+template <class VectorSize>
+void binary_sparse_write(std::ostream& os, const VectorSize& vec)
+{	size_t i, length = vec.size();
+	binary_sparse_write(os, length);
+	for(i = 0; i < length; i++)
+		binary_sparse_write(os, size_t( vec[i] ));
+}
+
+/// write a string (its length followed by its characters)
+inline void binary_sparse_write(std::ostream& os, const std::string& str)
+{	binary_sparse_write(os, str.size());
+	os.write(str.data(), std::streamsize( str.size() ));
+}
+
+/// read a size_t value
+inline bool binary_sparse_read(std::istream& is, size_t& value)
+{	is.read(reinterpret_cast<char*>(&value), sizeof(size_t));
+	return bool(is);
+}
+
+/*!
+Read a vector of size_t values written by binary_sparse_write.
+
+\param is
+is the stream that the vector is read from.
+
+\param vec
+is the vector that is read (its size is set to the length of the vector).
+Its elements are added as they are read and checked,
+so that a length that is corrupted, or larger than the data in the stream,
+fails when the stream ends (instead of first allocating memory for
+all the elements).
+
+\param max_length
+is the maximum valid length for the vector.
+
+\param bound
+is the bound for the elements of the vector; i.e., the value
+<code>vec[i] < bound</code> for all valid i.
+
+\return
+is true if the vector was read and passes the checks above.
+*/
+inline bool binary_sparse_read(
+	std::istream& is, vector<size_t>& vec, size_t max_length, size_t bound)
+{	size_t i, length;
+	bool ok = binary_sparse_read(is, length);
+	ok     &= ok && length <= max_length;
+	vec.resize(0);
+	for(i = 0; ok && i < length; i++)
+	{	size_t value;
+		ok &= binary_sparse_read(is, value) && value < bound;
+		if( ok )
+			vec.push_back(value);
+	}
+	return ok;
+}
+
+/// read a string written by binary_sparse_write
+inline bool binary_sparse_read(std::istream& is, std::string& str)
+{	size_t length;
+	bool ok = binary_sparse_read(is, length);
+	ok     &= ok && length < 1000;
+	if( ! ok )
+		return false;
+	CppAD::vector<char> buffer(length + 1);
+	is.read(buffer.data(), std::streamsize(length) );
+	buffer[length] = '\0';
+	str = buffer.data();
+	return bool(is);
+}
+
+/*!
+Convert a sparsity pattern with elements of type bool to
+a list of (row, column) pairs.
+
+\param p
+is the sparsity pattern (with nr * nc elements in row major order).
+
+\param nr
+is the number of rows in the pattern.
+
+\param nc
+is the number of columns in the pattern.
+
+\param pair
+the input size of this vector must be zero.
+Upon return it contains the row and column index (in that order)
+for each possibly non-zero entry in the pattern.
+*/
+template <class VectorSet>
+void binary_sparse_pattern(
+	const VectorSet& p, size_t nr, size_t nc, vector<size_t>& pair, bool)
+{	CPPAD_ASSERT_KNOWN(
+		size_t( p.size() ) == nr * nc,
+		"write_sparse: p does not have the expected size"
+	);
+	size_t i, j;
+	for(i = 0; i < nr; i++)
+	{	for(j = 0; j < nc; j++) if( p[i * nc + j] )
+		{	pair.push_back(i);
+			pair.push_back(j);
+		}
+	}
+}
+/*!
+Convert a sparsity pattern with elements of type std::set<size_t> to
+a list of (row, column) pairs.
+
+\copydetails binary_sparse_pattern
+*/
+template <class VectorSet>
+void binary_sparse_pattern(
+	const VectorSet&        p    ,
+	size_t                  nr   ,
+	size_t                  nc   ,
+	vector<size_t>&         pair ,
+	const std::set<size_t>&      )
+{	CPPAD_ASSERT_KNOWN(
+		size_t( p.size() ) == nr,
+		"write_sparse: p does not have the expected size"
+	);
+	std::set<size_t>::const_iterator itr;
+	for(size_t i = 0; i < nr; i++)
+	{	for(itr = p[i].begin(); itr != p[i].end(); itr++)
+		{	CPPAD_ASSERT_KNOWN(
+				*itr < nc,
+				"write_sparse: an element of p is not less than its bound"
+			);
+			pair.push_back(i);
+			pair.push_back(*itr);
+		}
+	}
+}
+/*!
+Convert a list of (row, column) pairs to a sparsity pattern with
+elements of type bool.
+
+\param pair
+contains the row and column index (in that order)
+for each possibly non-zero entry in the pattern.
+
+\param nr
+is the number of rows in the pattern.
+
+\param nc
+is the number of columns in the pattern.
+
+\param p
+is the sparsity pattern corresponding to the pairs
+(with nr * nc elements in row major order).
+*/
+template <class VectorSet>
+void binary_sparse_pattern(
+	const vector<size_t>& pair, size_t nr, size_t nc, VectorSet& p, bool)
+{	size_t i, k;
+	p.resize(nr * nc);
+	for(i = 0; i < nr * nc; i++)
+		p[i] = false;
+	for(k = 0; k < pair.size(); k += 2)
+		p[ pair[k] * nc + pair[k+1] ] = true;
+}
+/*!
+Convert a list of (row, column) pairs to a sparsity pattern with
+elements of type std::set<size_t>.
+
+\copydetails binary_sparse_pattern
+*/
+template <class VectorSet>
+void binary_sparse_pattern(
+	const vector<size_t>&   pair ,
+	size_t                  nr   ,
+	size_t                       ,
+	VectorSet&              p    ,
+	const std::set<size_t>&      )
+{	size_t i, k;
+	p.resize(nr);
+	for(i = 0; i < nr; i++)
+		p[i].clear();
+	for(k = 0; k < pair.size(); k += 2)
+		p[ pair[k] ].insert( pair[k+1] );
+}
+// ---------------------------------------------------------------------------
+/*!
+Fingerprint for the operation sequence in this ADFun object.
+
+\param seed
+is the initial value for the hash code.
+Different seeds give (practically) independent fingerprints.
+
+\return
+is a hash code for the structure of the operation sequence;
+see player::fingerprint.
+The independent and dependent variable indices are also included.
+*/
+template <typename Base>
+size_t ADFun<Base>::fingerprint(unsigned int seed) const
+{	size_t i, n = ind_taddr_.size(), m = dep_taddr_.size();
+	unsigned int h = seed;
+	hash_mix(h, &num_var_tape_, sizeof(size_t) );
+	for(i = 0; i < n; i++)
+		hash_mix(h, &ind_taddr_[i], sizeof(size_t) );
+	for(i = 0; i < m; i++)
+	{	hash_mix(h, &dep_taddr_[i], sizeof(size_t) );
+		hash_mix(h, static_cast<unsigned int>( dep_parameter_[i] ) );
+	}
+	play_.fingerprint(h);
+	return hash_final(h);
+}
+/*!
+Write the header, sparsity pattern, and requested entries for
+sparse derivative information.
+
+\param os
+is the stream that the information is written to.
+
+\param kind
+is the kind of work object that is written after the header.
+
+\param p
+is the sparsity pattern. If kind is binary_sparse_jac (binary_sparse_hes)
+it is a Jacobian (Hessian) sparsity pattern.
+
+\param row
+is the row index for the requested entries.
+
+\param col
+is the column index for the requested entries.
+
+\par Header
+The following values are written (each as a size_t):
+CPPAD_BINARY_SPARSE_VERSION, sizeof(size_t), kind,
+two fingerprints (with seeds 0 and 1), Domain(), Range().
+*/
+template <typename Base>
+template <class VectorSet, class VectorSize>
+void ADFun<Base>::write_sparse_common(
+	std::ostream&       os   ,
+	binary_sparse_kind  kind ,
+	const VectorSet&    p    ,
+	const VectorSize&   row  ,
+	const VectorSize&   col  ) const
+{	size_t n = Domain();
+	size_t m = Range();
+	size_t nr = (kind == binary_sparse_jac) ? m : n;
+
+	// header
+	os.write(binary_sparse_magic(), 8);
+	binary_sparse_write(os, size_t( CPPAD_BINARY_SPARSE_VERSION ) );
+	binary_sparse_write(os, sizeof(size_t) );
+	binary_sparse_write(os, size_t(kind) );
+	binary_sparse_write(os, fingerprint(0) );
+	binary_sparse_write(os, fingerprint(1) );
+	binary_sparse_write(os, n);
+	binary_sparse_write(os, m);
+
+	// sparsity pattern as a list of pairs
+	typedef typename VectorSet::value_type Set_type;
+	vector<size_t> pair;
+	binary_sparse_pattern(p, nr, n, pair, Set_type() );
+	binary_sparse_write(os, pair);
+
+	// requested entries
+	CPPAD_ASSERT_KNOWN(
+		row.size() == col.size(),
+		"write_sparse: row and col do not have the same size"
+	);
+	binary_sparse_write(os, row);
+	binary_sparse_write(os, col);
+}
+/*!
+Read the header, sparsity pattern, and requested entries for
+sparse derivative information written by write_sparse_common.
+
+\param is
+is the stream that the information is read from.
+
+\param kind
+is the kind of work object that is expected after the header.
+
+\param pair [out]
+is the sparsity pattern as a list of pairs; see binary_sparse_pattern.
+
+\param row [out]
+is the row index for the requested entries.
+
+\param col [out]
+is the column index for the requested entries.
+
+\return
+is true if the information was read and passes some simple checks;
+e.g., the fingerprint for this operation sequence is the same as for the
+one that was written.
+*/
+template <typename Base>
+bool ADFun<Base>::read_sparse_common(
+	std::istream&          is   ,
+	binary_sparse_kind     kind ,
+	vector<size_t>&        pair ,
+	vector<size_t>&        row  ,
+	vector<size_t>&        col  ) const
+{	size_t i, n = Domain();
+	size_t m = Range();
+	size_t nr = (kind == binary_sparse_jac) ? m : n;
+
+	// header
+	char magic[8];
+	is.read(magic, 8);
+	bool ok = bool(is);
+	for(i = 0; ok && i < 8; i++)
+		ok &= magic[i] == binary_sparse_magic()[i];
+	size_t header[7];
+	for(i = 0; ok && i < 7; i++)
+		ok &= binary_sparse_read(is, header[i]);
+	ok &= ok && header[0] == CPPAD_BINARY_SPARSE_VERSION;
+	ok &= ok && header[1] == sizeof(size_t);
+	ok &= ok && header[2] == size_t(kind);
+	ok &= ok && header[3] == fingerprint(0);
+	ok &= ok && header[4] == fingerprint(1);
+	ok &= ok && header[5] == n;
+	ok &= ok && header[6] == m;
+
+	// sparsity pattern (row index bound nr and column index bound n)
+	ok &= ok && binary_sparse_read(is, pair, 2 * nr * n, std::max(nr, n) );
+	for(i = 0; ok && i < pair.size(); i += 2)
+		ok &= pair[i] < nr && pair[i+1] < n;
+
+	// requested entries
+	ok &= ok && binary_sparse_read(is, row, nr * n, nr);
+	ok &= ok && binary_sparse_read(is, col, nr * n, n);
+	ok &= ok && row.size() == col.size();
+
+	return ok;
+}
+// ---------------------------------------------------------------------------
+/*!
+Write sparsity pattern, requested entries, and coloring for a sparse Jacobian.
+
+\param os
+is the stream that the information is written to.
+
+\param p
+is the Jacobian sparsity pattern.
+
+\param row
+is the row index for the requested entries.
+
+\param col
+is the column index for the requested entries.
+
+\param work
+contains the coloring information
+(work.team_start is not written because it depends on the number of
+threads).
+*/
+template <typename Base>
+template <class VectorSet, class VectorSize>
+void ADFun<Base>::write_sparse(
+	std::ostream&               os   ,
+	const VectorSet&            p    ,
+	const VectorSize&           row  ,
+	const VectorSize&           col  ,
+	const sparse_jacobian_work& work ) const
+{	write_sparse_common(os, binary_sparse_jac, p, row, col);
+	binary_sparse_write(os, work.color_method);
+	binary_sparse_write(os, work.max_direction);
+	binary_sparse_write(os, work.order);
+	binary_sparse_write(os, work.color);
+}
+/*!
+Write sparsity pattern, requested entries, and coloring for a sparse Hessian.
+
+\param os
+is the stream that the information is written to.
+
+\param p
+is the Hessian sparsity pattern.
+
+\param row
+is the row index for the requested entries.
+
+\param col
+is the column index for the requested entries.
+
+\param work
+contains the coloring information
+(work.team_start is not written because it depends on the number of
+threads).
+*/
+template <typename Base>
+template <class VectorSet, class VectorSize>
+void ADFun<Base>::write_sparse(
+	std::ostream&               os   ,
+	const VectorSet&            p    ,
+	const VectorSize&           row  ,
+	const VectorSize&           col  ,
+	const sparse_hessian_work&  work ) const
+{	write_sparse_common(os, binary_sparse_hes, p, row, col);
+	binary_sparse_write(os, work.color_method);
+	binary_sparse_write(os, work.row);
+	binary_sparse_write(os, work.col);
+	binary_sparse_write(os, work.subs_from);
+	binary_sparse_write(os, work.subs_to);
+	binary_sparse_write(os, work.subs_index);
+	binary_sparse_write(os, work.order);
+	binary_sparse_write(os, work.color);
+}
+/*!
+Read sparsity pattern, requested entries, and coloring for a sparse Jacobian
+written by write_sparse.
+
+\param is
+is the stream that the information is read from.
+
+\param p [out]
+is the Jacobian sparsity pattern.
+
+\param row [out]
+is the row index for the requested entries.
+
+\param col [out]
+is the column index for the requested entries.
+
+\param work [out]
+contains the coloring information.
+
+\return
+is true if the information was read and passes some simple checks.
+If it is false, none of the output arguments are changed.
+*/
+template <typename Base>
+template <class VectorSet, class VectorSize>
+bool ADFun<Base>::read_sparse(
+	std::istream&               is   ,
+	VectorSet&                  p    ,
+	VectorSize&                 row  ,
+	VectorSize&                 col  ,
+	sparse_jacobian_work&       work ) const
+{	size_t k, n = Domain();
+	size_t m = Range();
+	vector<size_t> pair, r, c;
+	bool ok = read_sparse_common(is, binary_sparse_jac, pair, r, c);
+	size_t K = r.size();
+
+	// the color vector has size n for forward mode and m for reverse mode
+	sparse_jacobian_work w;
+	ok &= ok && binary_sparse_read(is, w.color_method);
+	ok &= ok && binary_sparse_read(is, w.max_direction);
+	ok &= ok && binary_sparse_read(is, w.order, K, K);
+	ok &= ok && binary_sparse_read(is, w.color, std::max(m, n), n + m + 1);
+	ok &= ok && (w.order.size() == K || w.order.size() == 0);
+	ok &= ok && (w.color.size() == n || w.color.size() == m
+		|| w.color.size() == 0 );
+	for(k = 0; ok && k < w.color.size(); k++)
+		ok &= w.color[k] <= w.color.size();
+	if( ! ok )
+		return false;
+
+	typedef typename VectorSet::value_type Set_type;
+	binary_sparse_pattern(pair, m, n, p, Set_type() );
+	row.resize(K);
+	col.resize(K);
+	for(k = 0; k < K; k++)
+	{	row[k] = r[k];
+		col[k] = c[k];
+	}
+	work.clear();
+	work = w;
+	return true;
+}
+/*!
+Read sparsity pattern, requested entries, and coloring for a sparse Hessian
+written by write_sparse.
+
+\param is
+is the stream that the information is read from.
+
+\param p [out]
+is the Hessian sparsity pattern.
+
+\param row [out]
+is the row index for the requested entries.
+
+\param col [out]
+is the column index for the requested entries.
+
+\param work [out]
+contains the coloring information.
+
+\return
+is true if the information was read and passes some simple checks.
+If it is false, none of the output arguments are changed.
+*/
+template <typename Base>
+template <class VectorSet, class VectorSize>
+bool ADFun<Base>::read_sparse(
+	std::istream&               is   ,
+	VectorSet&                  p    ,
+	VectorSize&                 row  ,
+	VectorSize&                 col  ,
+	sparse_hessian_work&        work ) const
+{	size_t k, n = Domain();
+	vector<size_t> pair, r, c;
+	bool ok = read_sparse_common(is, binary_sparse_hes, pair, r, c);
+	size_t K = r.size();
+
+	// the compressed values (work.row and work.col) can have more than K
+	// elements when substitution is used
+	sparse_hessian_work w;
+	size_t S = n * n + n;
+	ok &= ok && binary_sparse_read(is, w.color_method);
+	ok &= ok && binary_sparse_read(is, w.row, S, n);
+	ok &= ok && binary_sparse_read(is, w.col, S, n);
+	size_t n_value = w.row.size();
+	ok &= ok && binary_sparse_read(is, w.subs_from,  S, n_value);
+	ok &= ok && binary_sparse_read(is, w.subs_to,    S, n_value);
+	ok &= ok && binary_sparse_read(is, w.subs_index, K, n_value);
+	ok &= ok && binary_sparse_read(is, w.order, n_value, n_value);
+	ok &= ok && binary_sparse_read(is, w.color, n, n + 1);
+	ok &= ok && w.col.size() == n_value;
+	ok &= ok && w.subs_to.size() == w.subs_from.size();
+	ok &= ok && (w.subs_index.size() == K || w.subs_index.size() == 0);
+	ok &= ok && (n_value == K || w.subs_index.size() == K);
+	ok &= ok && w.order.size() == n_value;
+	ok &= ok && (w.color.size() == n || n_value == 0);
+	if( ! ok )
+		return false;
+
+	typedef typename VectorSet::value_type Set_type;
+	binary_sparse_pattern(pair, n, n, p, Set_type() );
+	row.resize(K);
+	col.resize(K);
+	for(k = 0; k < K; k++)
+	{	row[k] = r[k];
+		col[k] = c[k];
+	}
+	work.clear();
+	work = w;
+	return true;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -0,0 +1,343 @@
+/* $Id$ */
+# ifndef CPPAD_BINARY_TAPE_INCLUDED
+# define CPPAD_BINARY_TAPE_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin binary_tape$$
+$spell
+	const
+	std
+	ostream
+	istream
+	ios
+	fstream
+	bool
+	VecAD
+	CppAD
+	sizeof
+	addr_t
+	Taylor
+$$
+
+$index binary_tape$$
+$index write_binary, ADFun$$
+$index read_binary, ADFun$$
+$index save, operation sequence$$
+$index load, operation sequence$$
+$index file, operation sequence$$
+
+$section Write and Read an ADFun Operation Sequence in Binary Form$$
+
+$head Syntax$$
+$icode%f%.write_binary(%os%)
+%$$
+$icode%ok% = %g%.read_binary(%is%)%$$
+
+$head Purpose$$
+Recording an operation sequence and converting it to an $code ADFun$$ object
+can take a significant amount of time for large functions.
+These routines store the operation sequence for $icode f$$ in a binary file
+so that another $code ADFun$$ object $icode g$$
+(possibly in a different process) can use the operation sequence
+without recording it again.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+	const ADFun<%Base%> %f%
+%$$
+Only the operation sequence is written; e.g.,
+the $cref/Taylor coefficients/glossary/Taylor Coefficient/$$
+and $cref parallel_team$$ settings stored in $icode f$$ are not written.
+
+$head os$$
+This argument has prototype
+$codei%
+	std::ostream& %os%
+%$$
+and should be opened in binary mode; e.g.,
+$codei%
+	std::ofstream %os%(%file_name%, std::ios::binary)
+%$$
+
+$head g$$
+The object $icode g$$ has prototype
+$codei%
+	ADFun<%Base%> %g%
+%$$
+If $icode ok$$ is true, $icode g$$ contains the same operation sequence
+as the object that was written (and no Taylor coefficients).
+Otherwise, $icode g$$ contains an empty operation sequence
+(as if it were created by the default constructor).
+
+$head is$$
+This argument has prototype
+$codei%
+	std::istream& %is%
+%$$
+and should be opened in binary mode.
+It is positioned at the beginning of the data written by
+$icode%f%.write_binary(%os%)%$$.
+Upon return it is positioned directly after this data
+(if $icode ok$$ is true), so several operation sequences can be
+stored in the same file.
+
+$head ok$$
+The return value has prototype
+$codei%
+	bool %ok%
+%$$
+It is false if the data does not begin with the expected header,
+if the data was written using a different version of CppAD,
+if any of the sizes
+$code sizeof(size_t)$$,
+$code sizeof(CppAD::addr_t)$$,
+$code sizeof($$$icode Base$$$code )$$
+is different from when the data was written,
+if the end of $icode is$$ is reached before all of the data is read,
+or if the data does not pass some simple consistency checks.
+
+$head Base$$
+The type $icode Base$$ must be plain old data; e.g.,
+$code float$$ or $code double$$.
+The parameters are written as the bytes of the corresponding $icode Base$$
+values, so the file can only be read on a system that uses the same
+byte order and floating point representation.
+
+$head Atomic Functions$$
+The operation sequence identifies $cref atomic$$ and $cref Discrete$$
+functions by the order in which they were created.
+If the operation sequence uses such functions, the process reading it
+must create the same functions in the same order before using $icode g$$.
+
+$head Memory$$
+Each vector in the operation sequence is read with one call to
+$code read$$ directly into the memory that $icode g$$ uses for the
+vector; i.e., there is no conversion or copy of the individual
+operators, operator arguments, or parameters.
+
+$children%
+	example/binary_tape.cpp
+%$$
+$head Example$$
+The file $cref binary_tape.cpp$$
+contains an example and test of these operations.
+It returns true if it succeeds and false otherwise.
+
+$end
+-----------------------------------------------------------------------------
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file binary_tape.hpp
+Write and read the operation sequence for an ADFun object in binary form.
+*/
+
+/*!
+\def CPPAD_BINARY_TAPE_VERSION
+Version number for the binary form of an operation sequence.
+This must be changed whenever the binary form changes.
+The number of operators, <code>NumberOp</code>, is also written so that
+files using a different set of operator codes are rejected.
+*/
+# define CPPAD_BINARY_TAPE_VERSION 1
+
+/*!
+Characters at the beginning of the binary form of an operation sequence
+(the terminating '\\0' is not written).
+*/
+inline const char* binary_tape_magic(void)
+{	return "CppADtap"; }
+
+/*!
+Write the operation sequence for this ADFun object in binary form.
+
+\tparam Base
+is the base type for this ADFun object (must be plain old data).
+
+\param os
+is the stream that the operation sequence is written to.
+
+\par Header
+The following values are written (each as a size_t):
+CPPAD_BINARY_TAPE_VERSION, sizeof(size_t), sizeof(addr_t),
+sizeof(CPPAD_OP_CODE_TYPE), sizeof(Base), NumberOp.
+*/
+template <typename Base>
+void ADFun<Base>::write_binary(std::ostream& os) const
+{	CPPAD_ASSERT_KNOWN(
+		is_pod<Base>(),
+		"write_binary: Base is not plain old data"
+	);
+	size_t i, j;
+	size_t n = ind_taddr_.size();
+	size_t m = dep_taddr_.size();
+
+	// header
+	size_t header[6];
+	header[0] = CPPAD_BINARY_TAPE_VERSION;
+	header[1] = sizeof(size_t);
+	header[2] = sizeof(addr_t);
+	header[3] = sizeof(CPPAD_OP_CODE_TYPE);
+	header[4] = sizeof(Base);
+	header[5] = size_t( NumberOp );
+	os.write(binary_tape_magic(), 8);
+	os.write(reinterpret_cast<const char*>(header), sizeof(header) );
+
+	// has_been_optimized_, num_var_tape_, n, m
+	size_t info[4];
+	info[0] = size_t( has_been_optimized_ );
+	info[1] = num_var_tape_;
+	info[2] = n;
+	info[3] = m;
+	os.write(reinterpret_cast<const char*>(info), sizeof(info) );
+
+	// ind_taddr_, dep_taddr_, dep_parameter_
+	for(j = 0; j < n; j++)
+		os.write(reinterpret_cast<const char*>(&ind_taddr_[j]), sizeof(size_t));
+	for(i = 0; i < m; i++)
+	{	size_t dep[2];
+		dep[0] = dep_taddr_[i];
+		dep[1] = size_t( dep_parameter_[i] );
+		os.write(reinterpret_cast<const char*>(dep), sizeof(dep) );
+	}
+
+	// play_
+	play_.write_binary(os);
+}
+
+/*!
+Read an operation sequence, written by write_binary, into this ADFun object.
+
+\tparam Base
+is the base type for this ADFun object (must be plain old data).
+
+\param is
+is the stream that the operation sequence is read from.
+
+\return
+is true if the operation sequence was read.
+Otherwise this object has the same state as after the default constructor
+(except for check_for_nan_ and par_sweep_ settings).
+
+\par
+All of the private member data in ad_fun.hpp is set to correspond to the
+new operation sequence except for check_for_nan_ and the par_sweep_
+settings; i.e., the same as for Dependent.
+*/
+template <typename Base>
+bool ADFun<Base>::read_binary(std::istream& is)
+{	CPPAD_ASSERT_KNOWN(
+		is_pod<Base>(),
+		"read_binary: Base is not plain old data"
+	);
+	size_t i, j;
+
+	// start with an empty operation sequence
+	has_been_optimized_        = false;
+	compare_change_count_      = 1;
+	compare_change_number_     = 0;
+	compare_change_op_index_   = 0;
+	num_order_taylor_          = 0;
+	num_direction_taylor_      = 0;
+	cap_order_taylor_          = 0;
+	num_var_tape_              = 0;
+	ind_taddr_.resize(0);
+	dep_taddr_.resize(0);
+	dep_parameter_.resize(0);
+	taylor_.erase();
+	cskip_op_.erase();
+	load_op_.erase();
+	play_.Erase();
+	par_sweep_.clear();
+	for_jac_sparse_pack_.resize(0, 0);
+	for_jac_sparse_set_.resize(0,0);
+
+	// header
+	char magic[8];
+	is.read(magic, 8);
+	bool ok = bool(is);
+	for(i = 0; ok && i < 8; i++)
+		ok &= magic[i] == binary_tape_magic()[i];
+	size_t header[6];
+	if( ok )
+	{	is.read(reinterpret_cast<char*>(header), sizeof(header) );
+		ok &= bool(is);
+	}
+	ok &= ok && header[0] == CPPAD_BINARY_TAPE_VERSION;
+	ok &= ok && header[1] == sizeof(size_t);
+	ok &= ok && header[2] == sizeof(addr_t);
+	ok &= ok && header[3] == sizeof(CPPAD_OP_CODE_TYPE);
+	ok &= ok && header[4] == sizeof(Base);
+	ok &= ok && header[5] == size_t( NumberOp );
+
+	// has_been_optimized_, num_var_tape_, n, m
+	size_t info[4];
+	if( ok )
+	{	is.read(reinterpret_cast<char*>(info), sizeof(info) );
+		ok &= bool(is);
+	}
+	size_t n = 0, m = 0;
+	if( ok )
+	{	n = info[2];
+		m = info[3];
+		ok &= 0 < n && n < info[1] && 0 < m;
+	}
+
+	// ind_taddr_, dep_taddr_, dep_parameter_
+	// (grown as the elements are read so that a corrupted n or m
+	// fails when the stream ends instead of allocating its length)
+	for(j = 0; ok && j < n; j++)
+	{	size_t ind;
+		is.read(reinterpret_cast<char*>(&ind), sizeof(size_t));
+		ok &= bool(is) && ind == j + 1;
+		if( ok )
+			ind_taddr_.push_back(ind);
+	}
+	for(i = 0; ok && i < m; i++)
+	{	size_t dep[2];
+		is.read(reinterpret_cast<char*>(dep), sizeof(dep) );
+		ok &= bool(is) && 0 < dep[0] && dep[0] < info[1] && dep[1] <= 1;
+		if( ok )
+		{	dep_taddr_.push_back( dep[0] );
+			dep_parameter_.push_back( dep[1] == 1 );
+		}
+	}
+
+	// play_
+	ok &= ok && play_.read_binary(is);
+	ok &= ok && play_.num_var_rec() == info[1];
+	for(j = 0; ok && j < n; j++)
+		ok &= play_.GetOp(j+1) == InvOp;
+
+	if( ! ok )
+	{	play_.Erase();
+		ind_taddr_.resize(0);
+		dep_taddr_.resize(0);
+		dep_parameter_.resize(0);
+		return false;
+	}
+
+	// set the rest of the private member data in ad_fun.hpp
+	has_been_optimized_ = info[0] != 0;
+	num_var_tape_       = info[1];
+	cskip_op_.extend( play_.num_op_rec() );
+	load_op_.extend( play_.num_load_op_rec() );
+
+	return true;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
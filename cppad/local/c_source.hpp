@@ -0,0 +1,658 @@
+/* $Id$ */
+# ifndef CPPAD_C_SOURCE_INCLUDED
+# define CPPAD_C_SOURCE_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin c_source$$
+$spell
+	const
+	bool
+	std
+	ostream
+	ok
+	os
+	dw
+	VecAD
+	acos
+	asin
+	atan
+	sinh
+	cosh
+	tanh
+	erf
+	abs
+	sqrt
+	cos
+	CondExp
+	dlopen
+$$
+
+$index c_source$$
+$index source, generate C$$
+$index C, generate source$$
+$index compile, ADFun$$
+
+$section Generate C Source Code for an ADFun Object$$
+
+$head Syntax$$
+$icode%ok% = %f%.c_source(%name%, %os%)%$$
+
+$head Purpose$$
+Each call to $cref/f.Forward/Forward/$$ or $cref/f.Reverse/Reverse/$$
+interprets the operation sequence; i.e., it uses a $code switch$$
+statement to determine the operator corresponding to each variable.
+This routine writes C source code, that has one statement (or a few)
+for each operator, for the following calculations:
+zero order forward mode,
+first order forward mode in one direction,
+and first order reverse mode.
+The resulting code can be compiled and linked into a program,
+or compiled into a shared library and loaded while the program is running;
+see $cref c_kernel$$.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+	ADFun<%Base%> %f%
+%$$
+where $icode Base$$ is $code double$$.
+Note that $icode f$$ is not $code const$$
+(the playback location in its operation sequence is changed).
+
+$head name$$
+This argument has prototype
+$codei%
+	const std::string& %name%
+%$$
+It is the prefix for the names of the C functions and must be a valid
+C identifier.
+
+$head os$$
+This argument has prototype
+$codei%
+	std::ostream& %os%
+%$$
+The C source code is written to this stream.
+
+$head ok$$
+The return value has prototype
+$codei%
+	bool %ok%
+%$$
+It is true if all the operators in the operation sequence are supported;
+see $cref/operators/c_source/Operators/$$ below.
+Otherwise it is false and nothing is written to $icode os$$.
+
+$head Functions$$
+We use $icode n$$, $icode m$$, and $icode N$$ for the
+domain size, range size, and number of variables in $icode f$$;
+see $cref seq_property$$.
+The following functions are defined by the C source
+($icode name$$ is replaced by its value):
+
+$subhead size$$
+$codei%
+	size_t %name%_domain(void)
+	size_t %name%_range(void)
+	size_t %name%_size_var(void)
+%$$
+return $icode n$$, $icode m$$, and $icode N$$ respectively.
+
+$subhead forward0$$
+$codei%
+	void %name%_forward0(const double* %x%, double* %y%, double* %v%)
+%$$
+The vector $icode x$$ (length $icode n$$) is the argument value and
+the result $icode y$$ (length $icode m$$) is the corresponding function value.
+Upon return, $icode v$$ (length $icode N$$) contains the values of the
+variables that are used by the other functions.
+
+$subhead forward1$$
+$codei%
+	void %name%_forward1(
+		const double* %x1%, double* %y1%, const double* %v%, double* %v1%
+	)
+%$$
+The vector $icode x1$$ (length $icode n$$) is a direction in the domain
+space and $icode v$$ is the result of a previous call to
+$icode%name%_forward0%$$.
+The result $icode y1$$ (length $icode m$$) is the corresponding
+directional derivative.
+The vector $icode v1$$ (length $icode N$$) is used for work space.
+
+$subhead reverse1$$
+$codei%
+	void %name%_reverse1(
+		const double* %w%, double* %dw%, const double* %v%, double* %p%
+	)
+%$$
+The vector $icode w$$ (length $icode m$$) contains the range space weights
+and $icode v$$ is the result of a previous call to
+$icode%name%_forward0%$$.
+The result $icode dw$$ (length $icode n$$) is the derivative of the
+weighted sum of the function components.
+The vector $icode p$$ (length $icode N$$) is used for work space.
+
+$head Operators$$
+The following operators are supported:
+binary $code +$$, $code -$$, $code *$$, $code /$$,
+$code pow$$,
+$code abs$$, $code exp$$, $code log$$, $code sqrt$$, $code sin$$,
+$code cos$$, and $cref CondExp$$.
+The $cref/comparison operators/Compare/$$ are not checked and
+conditional skip operations (see $cref optimize$$) are not used.
+The other operators; e.g.,
+$code acos$$, $code asin$$, $code atan$$, $code tan$$,
+$code sinh$$, $code cosh$$, $code tanh$$, $code erf$$,
+$cref VecAD$$, $cref atomic$$, $cref Discrete$$, and $cref PrintFor$$,
+are not supported.
+
+$childtable%
+	cppad/c_kernel.hpp
+%$$
+
+$head Example$$
+The file $cref c_kernel.cpp$$
+contains an example and test of this operation.
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <algorithm>
+# include <sstream>
+# include <string>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file c_source.hpp
+Generate C source code for zero order forward, first order forward,
+and first order reverse mode.
+*/
+
+/*!
+C source code for an element of a vector.
+
+\param vec
+is the name of the vector.
+
+\param index
+is the index of the element.
+
+\return
+is the string <code>vec[index]</code>.
+*/
+inline std::string c_source_element(const char* vec, size_t index)
+{	std::ostringstream os;
+	os << vec << "[" << index << "]";
+	return os.str();
+}
+
+/*!
+C source code for a conditional expression operator argument.
+
+\param arg
+is the argument vector for the CExpOp operator.
+
+\param k
+is the index of the argument (0 left, 1 right, 2 if_true, 3 if_false).
+
+\param vec
+is the name of the vector that contains the variables.
+
+\return
+is the C source for the corresponding variable or parameter.
+*/
+inline std::string c_source_cexp_arg(
+	const addr_t* arg, size_t k, const char* vec)
+{	if( arg[1] & (1 << k) )
+		return c_source_element(vec, arg[2+k]);
+	return c_source_element("par", arg[2+k]);
+}
+
+/*!
+Write C source code for zero order forward, first order forward,
+and first order reverse mode.
+
+\tparam Base
+The type used during the forward mode computations; i.e., the corresponding
+recording of operations used the type AD<Base>.
+
+\param name
+is the prefix for the C function names.
+
+\param os
+is the stream where the C source code is written.
+
+\return
+is false (and nothing is written to os) if the operation sequence
+contains an operator that is not supported.
+*/
+template <typename Base>
+bool ADFun<Base>::c_source(const std::string& name, std::ostream& os)
+{	using std::string;
+	size_t i, j, k;
+
+	// number of independent variables
+	size_t n = ind_taddr_.size();
+
+	// number of dependent variables
+	size_t m = dep_taddr_.size();
+
+	// short hand for the C source for variables and parameters
+	// in the different functions
+	const char* v  = "v";
+	const char* v1 = "v1";
+	const char* pv = "p";
+	const char* pa = "par";
+
+	// C source for each of the functions
+	std::ostringstream f0, f1, r1;
+
+	// length of the reverse mode source for each operator
+	// (the operators are written in reverse order)
+	pod_vector<size_t> rev_length;
+
+	// C comparison operators (in CompareOp order)
+	const char* compare[] = { " < ", " <= ", " == ", " >= ", " > ", " != " };
+
+	OpCode        op;
+	const addr_t* arg;
+	size_t        i_op;
+	size_t        i_var;
+	play_.forward_start(op, arg, i_op, i_var);
+	CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+	bool more_operators = true;
+	while(more_operators)
+	{	play_.forward_next(op, arg, i_op, i_var);
+		string z   = c_source_element(v,  i_var);
+		string z1  = c_source_element(v1, i_var);
+		string pz  = c_source_element(pv, i_var);
+		std::ostringstream r;
+		switch( op )
+		{	// ----------------------------------------------------------
+			case AddpvOp:
+			case AddvvOp:
+			case DivpvOp:
+			case DivvpOp:
+			case DivvvOp:
+			case MulpvOp:
+			case MulvvOp:
+			case SubpvOp:
+			case SubvpOp:
+			case SubvvOp:
+			{	bool x_var = (op == AddvvOp) | (op == DivvpOp) |
+					(op == DivvvOp) | (op == MulvvOp) |
+					(op == SubvpOp) | (op == SubvvOp);
+				bool y_var = (op != DivvpOp) & (op != SubvpOp);
+				string x   = c_source_element(x_var ? v : pa, arg[0]);
+				string y   = c_source_element(y_var ? v : pa, arg[1]);
+				string x1  = c_source_element(v1, arg[0]);
+				string y1  = c_source_element(v1, arg[1]);
+				string px  = c_source_element(pv, arg[0]);
+				string py  = c_source_element(pv, arg[1]);
+				switch( op )
+				{	case AddpvOp:
+					f0 << z  << " = " << x << " + " << y << ";\n";
+					f1 << z1 << " = " << y1 << ";\n";
+					r  << py << " += " << pz << ";\n";
+					break;
+
+					case AddvvOp:
+					f0 << z  << " = " << x << " + " << y << ";\n";
+					f1 << z1 << " = " << x1 << " + " << y1 << ";\n";
+					r  << px << " += " << pz << ";\n";
+					r  << py << " += " << pz << ";\n";
+					break;
+
+					case DivpvOp:
+					f0 << z  << " = " << x << " / " << y << ";\n";
+					f1 << z1 << " = (- " << z << " * " << y1 << ") / "
+					   << y << ";\n";
+					r  << py << " -= " << pz << " / " << y << " * "
+					   << z << ";\n";
+					break;
+
+					case DivvpOp:
+					f0 << z  << " = " << x << " / " << y << ";\n";
+					f1 << z1 << " = " << x1 << " / " << y << ";\n";
+					r  << px << " += " << pz << " / " << y << ";\n";
+					break;
+
+					case DivvvOp:
+					f0 << z  << " = " << x << " / " << y << ";\n";
+					f1 << z1 << " = (" << x1 << " - " << z << " * "
+					   << y1 << ") / " << y << ";\n";
+					r  << px << " += " << pz << " / " << y << ";\n";
+					r  << py << " -= " << pz << " / " << y << " * "
+					   << z << ";\n";
+					break;
+
+					case MulpvOp:
+					f0 << z  << " = " << x << " * " << y << ";\n";
+					f1 << z1 << " = " << x << " * " << y1 << ";\n";
+					r  << py << " += " << pz << " * " << x << ";\n";
+					break;
+
+					case MulvvOp:
+					f0 << z  << " = " << x << " * " << y << ";\n";
+					f1 << z1 << " = " << x1 << " * " << y << " + "
+					   << x << " * " << y1 << ";\n";
+					r  << px << " += " << pz << " * " << y << ";\n";
+					r  << py << " += " << pz << " * " << x << ";\n";
+					break;
+
+					case SubpvOp:
+					f0 << z  << " = " << x << " - " << y << ";\n";
+					f1 << z1 << " = - " << y1 << ";\n";
+					r  << py << " -= " << pz << ";\n";
+					break;
+
+					case SubvpOp:
+					f0 << z  << " = " << x << " - " << y << ";\n";
+					f1 << z1 << " = " << x1 << ";\n";
+					r  << px << " += " << pz << ";\n";
+					break;
+
+					case SubvvOp:
+					f0 << z  << " = " << x << " - " << y << ";\n";
+					f1 << z1 << " = " << x1 << " - " << y1 << ";\n";
+					r  << px << " += " << pz << ";\n";
+					r  << py << " -= " << pz << ";\n";
+					break;
+
+					default:
+					CPPAD_ASSERT_UNKNOWN(false);
+				}
+			}
+			break;
+			// ----------------------------------------------------------
+			case AbsOp:
+			case ExpOp:
+			case LogOp:
+			case SqrtOp:
+			{	string x   = c_source_element(v,  arg[0]);
+				string x1  = c_source_element(v1, arg[0]);
+				string px  = c_source_element(pv, arg[0]);
+				switch( op )
+				{	case AbsOp:
+					f0 << z  << " = fabs(" << x << ");\n";
+					f1 << z1 << " = " << x << " > 0.0 ? " << x1 << " : ("
+					   << x << " < 0.0 ? - " << x1 << " : 0.0);\n";
+					r  << px << " += " << x << " > 0.0 ? " << pz << " : ("
+					   << x << " < 0.0 ? - " << pz << " : 0.0);\n";
+					break;
+
+					case ExpOp:
+					f0 << z  << " = exp(" << x << ");\n";
+					f1 << z1 << " = " << z << " * " << x1 << ";\n";
+					r  << px << " += " << pz << " * " << z << ";\n";
+					break;
+
+					case LogOp:
+					f0 << z  << " = log(" << x << ");\n";
+					f1 << z1 << " = " << x1 << " / " << x << ";\n";
+					r  << px << " += " << pz << " / " << x << ";\n";
+					break;
+
+					case SqrtOp:
+					f0 << z  << " = sqrt(" << x << ");\n";
+					f1 << z1 << " = " << x1 << " / (2.0 * " << z << ");\n";
+					r  << px << " += " << pz << " / (2.0 * " << z << ");\n";
+					break;
+
+					default:
+					CPPAD_ASSERT_UNKNOWN(false);
+				}
+			}
+			break;
+			// ----------------------------------------------------------
+			case CosOp:
+			case SinOp:
+			{	// the auxillary result is the other function
+				string x   = c_source_element(v,  arg[0]);
+				string x1  = c_source_element(v1, arg[0]);
+				string px  = c_source_element(pv, arg[0]);
+				size_t i_s = i_var;
+				size_t i_c = i_var - 1;
+				if( op == CosOp )
+					std::swap(i_s, i_c);
+				string s   = c_source_element(v,  i_s);
+				string c   = c_source_element(v,  i_c);
+				string s1  = c_source_element(v1, i_s);
+				string c1  = c_source_element(v1, i_c);
+				string ps  = c_source_element(pv, i_s);
+				string pc  = c_source_element(pv, i_c);
+				f0 << s  << " = sin(" << x << ");\n";
+				f0 << c  << " = cos(" << x << ");\n";
+				f1 << s1 << " = " << c << " * " << x1 << ";\n";
+				f1 << c1 << " = - " << s << " * " << x1 << ";\n";
+				r  << px << " += " << ps << " * " << c << " - "
+				   << pc << " * " << s << ";\n";
+			}
+			break;
+			// ----------------------------------------------------------
+			case PowpvOp:
+			case PowvpOp:
+			case PowvvOp:
+			{	// z_0 = log(x), z_1 = z_0 * y, z = pow(x, y)
+				bool x_var = op != PowpvOp;
+				bool y_var = op != PowvpOp;
+				string x   = c_source_element(x_var ? v : pa, arg[0]);
+				string y   = c_source_element(y_var ? v : pa, arg[1]);
+				string x1  = c_source_element(v1, arg[0]);
+				string y1  = c_source_element(v1, arg[1]);
+				string px  = c_source_element(pv, arg[0]);
+				string py  = c_source_element(pv, arg[1]);
+				string z_0   = c_source_element(v,  i_var - 2);
+				string z_1   = c_source_element(v,  i_var - 1);
+				string z1_0  = c_source_element(v1, i_var - 2);
+				string z1_1  = c_source_element(v1, i_var - 1);
+				string pz_0  = c_source_element(pv, i_var - 2);
+				string pz_1  = c_source_element(pv, i_var - 1);
+				f0 << z_0 << " = log(" << x << ");\n";
+				f0 << z_1 << " = " << z_0 << " * " << y << ";\n";
+				f0 << z   << " = pow(" << x << ", " << y << ");\n";
+				if( x_var )
+					f1 << z1_0 << " = " << x1 << " / " << x << ";\n";
+				else	f1 << z1_0 << " = 0.0;\n";
+				if( x_var & y_var ) f1 << z1_1 << " = " << z1_0 << " * "
+					<< y << " + " << z_0 << " * " << y1 << ";\n";
+				else if( x_var )
+					f1 << z1_1 << " = " << z1_0 << " * " << y << ";\n";
+				else	f1 << z1_1 << " = " << z_0 << " * " << y1 << ";\n";
+				f1 << z1 << " = " << z << " * " << z1_1 << ";\n";
+				r  << pz_1 << " += " << pz << " * " << z << ";\n";
+				if( y_var )
+					r << py << " += " << pz_1 << " * " << z_0 << ";\n";
+				if( x_var )
+				{	r << pz_0 << " += " << pz_1 << " * " << y << ";\n";
+					r << px << " += " << pz_0 << " / " << x << ";\n";
+				}
+			}
+			break;
+			// ----------------------------------------------------------
+			case CExpOp:
+			{	string cond = "(" + c_source_cexp_arg(arg, 0, v)
+					+ compare[ arg[0] ] + c_source_cexp_arg(arg, 1, v) + ")";
+				f0 << z << " = " << cond << " ? "
+				   << c_source_cexp_arg(arg, 2, v) << " : "
+				   << c_source_cexp_arg(arg, 3, v) << ";\n";
+				f1 << z1 << " = " << cond << " ? ";
+				if( arg[1] & 4 )
+					f1 << c_source_element(v1, arg[4]);
+				else	f1 << "0.0";
+				f1 << " : ";
+				if( arg[1] & 8 )
+					f1 << c_source_element(v1, arg[5]);
+				else	f1 << "0.0";
+				f1 << ";\n";
+				if( arg[1] & 4 ) r << "if" << cond << " "
+					<< c_source_element(pv, arg[4]) << " += " << pz << ";\n";
+				if( arg[1] & 8 ) r << "if( ! " << cond << " ) "
+					<< c_source_element(pv, arg[5]) << " += " << pz << ";\n";
+			}
+			break;
+			// ----------------------------------------------------------
+			case CSumOp:
+			{	f0 << z  << " = " << c_source_element(pa, arg[2]) << ";\n";
+				f1 << z1 << " = 0.0;\n";
+				size_t n_add = size_t(arg[0]);
+				size_t n_sub = size_t(arg[1]);
+				for(k = 0; k < n_add + n_sub; k++)
+				{	const char* sign = k < n_add ? " += " : " -= ";
+					f0 << z  << sign << c_source_element(v,  arg[3+k]) << ";\n";
+					f1 << z1 << sign << c_source_element(v1, arg[3+k]) << ";\n";
+					r  << c_source_element(pv, arg[3+k]) << sign << pz << ";\n";
+				}
+				// CSumOp has a variable number of arguments
+				play_.forward_csum(op, arg, i_op, i_var);
+			}
+			break;
+			// ----------------------------------------------------------
+			case ParOp:
+			f0 << z  << " = " << c_source_element(pa, arg[0]) << ";\n";
+			f1 << z1 << " = 0.0;\n";
+			break;
+			// ----------------------------------------------------------
+			case CSkipOp:
+			// all the operators are computed
+			// CSkipOp has a variable number of arguments
+			play_.forward_cskip(op, arg, i_op, i_var);
+			break;
+			// ----------------------------------------------------------
+			case EqpvOp:
+			case EqvvOp:
+			case LepvOp:
+			case LevpOp:
+			case LevvOp:
+			case LtpvOp:
+			case LtvpOp:
+			case LtvvOp:
+			case NepvOp:
+			case NevvOp:
+			// comparison operators are not checked
+			case InvOp:
+			// independent variables are set before the other operators
+			break;
+
+			case EndOp:
+			more_operators = false;
+			break;
+			// ----------------------------------------------------------
+			default:
+			// this operator is not supported
+			return false;
+		}
+		string rev = r.str();
+		if( rev.size() > 0 )
+		{	// save the reverse mode source in reverse order
+			r1 << rev;
+			rev_length[ rev_length.extend(1) ] = rev.size();
+		}
+	}
+
+	// parameters
+	size_t num_par = play_.num_par_rec();
+	os << "/* C source generated by CppAD::ADFun<Base>::c_source */\n";
+	os << "# include <math.h>\n";
+	os << "# include <stddef.h>\n";
+	os << "static const double " << name << "_par[] = {\n";
+	std::ostringstream value;
+	value.precision(17);
+	for(i = 0; i < num_par; i++)
+	{	Base par = play_.GetPar(i);
+		if( par != par )
+			os << "\tNAN,\n";
+		else if( par - par != par - par )
+		{	if( par > Base(0) )
+				os << "\tINFINITY,\n";
+			else	os << "\t-INFINITY,\n";
+		}
+		else
+		{	value.str("");
+			value << par;
+			os << "\t" << value.str() << ",\n";
+		}
+	}
+	if( num_par == 0 )
+		os << "\t0.0\n";
+	os << "};\n";
+
+	// sizes
+	os << "size_t " << name << "_domain(void)\n{\treturn "
+	   << n << "; }\n";
+	os << "size_t " << name << "_range(void)\n{\treturn "
+	   << m << "; }\n";
+	os << "size_t " << name << "_size_var(void)\n{\treturn "
+	   << num_var_tape_ << "; }\n";
+
+	// zero order forward
+	os << "void " << name << "_forward0("
+	   << "const double* x, double* y, double* v)\n";
+	os << "{\tconst double* par = " << name << "_par;\n";
+	for(j = 0; j < n; j++)
+		os << "\tv[" << ind_taddr_[j] << "] = x[" << j << "];\n";
+	string line;
+	std::istringstream lines( f0.str() );
+	while( std::getline(lines, line) )
+		os << "\t" << line << "\n";
+	for(i = 0; i < m; i++)
+		os << "\ty[" << i << "] = v[" << dep_taddr_[i] << "];\n";
+	os << "\treturn;\n}\n";
+
+	// first order forward
+	os << "void " << name << "_forward1("
+	   << "const double* x1, double* y1, const double* v, double* v1)\n";
+	os << "{\tconst double* par = " << name << "_par;\n";
+	os << "\t(void) par;\n";
+	for(j = 0; j < n; j++)
+		os << "\tv1[" << ind_taddr_[j] << "] = x1[" << j << "];\n";
+	lines.clear();
+	lines.str( f1.str() );
+	while( std::getline(lines, line) )
+		os << "\t" << line << "\n";
+	for(i = 0; i < m; i++)
+		os << "\ty1[" << i << "] = v1[" << dep_taddr_[i] << "];\n";
+	os << "\treturn;\n}\n";
+
+	// first order reverse
+	os << "void " << name << "_reverse1("
+	   << "const double* w, double* dw, const double* v, double* p)\n";
+	os << "{\tconst double* par = " << name << "_par;\n";
+	os << "\tsize_t i;\n";
+	os << "\t(void) par;\n";
+	os << "\tfor(i = 0; i < " << num_var_tape_ << "; i++)\n";
+	os << "\t\tp[i] = 0.0;\n";
+	for(i = 0; i < m; i++)
+		os << "\tp[" << dep_taddr_[i] << "] += w[" << i << "];\n";
+	string rev = r1.str();
+	size_t end = rev.size();
+	k = rev_length.size();
+	while( k-- )
+	{	size_t start = end - rev_length[k];
+		lines.clear();
+		lines.str( rev.substr(start, end - start) );
+		while( std::getline(lines, line) )
+			os << "\t" << line << "\n";
+		end = start;
+	}
+	for(j = 0; j < n; j++)
+		os << "\tdw[" << j << "] = p[" << ind_taddr_[j] << "];\n";
+	os << "\treturn;\n}\n";
+
+	return true;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -3,7 +3,7 @@
 # define CPPAD_CAPACITY_ORDER_INCLUDED
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -178,6 +178,7 @@ void ADFun<Base>::capacity_order(size_t c, size_t r)
 	// Allocate new taylor with requested number of orders and directions  
 	size_t new_len   = ( (c-1)*r + 1 ) * num_var_tape_;
 	pod_vector<Base> new_taylor;
+	new_taylor.set_tag(thread_alloc::taylor_tag);
 	new_taylor.extend(new_len);
 
 	// number of orders to copy
@@ -3,6 +3,8 @@
 # define CPPAD_COLOR_SYMMETRIC_INCLUDED
 
 # include <cppad/configure.hpp>
+# include <algorithm>
+# include <map>
 
 /* --------------------------------------------------------------------------
 CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
@@ -249,6 +251,529 @@ void color_symmetric_cppad(
 	return;
 }
 
+// --------------------------------------------------------------------------
+/*!
+Adjacency graph, for a symmetric sparse matrix, restricted to the rows
+that appear in the requested entries.
+
+\tparam VectorSet
+see color_symmetric_cppad.
+
+\param pattern [in]
+is a representation of the sparsity pattern for the matrix
+(see color_symmetric_cppad).
+An edge is included between i and j if either (i, j) or (j, i)
+is in the sparsity pattern, i != j, and both i and j appear in
+the row or col vectors.
+
+\param row [in]
+is a vector specifying which row indices to compute.
+
+\param col [in]
+is a vector, with the same size as row,
+that specifies which column indices to compute.
+
+\param adj_start [out]
+is a vector with size m+1 where m is the number of rows in the matrix.
+The neighbors of vertex i are
+<code>adj[ adj_start[i] ]</code> , ... ,
+<code>adj[ adj_start[i+1] - 1 ]</code>
+in increasing order.
+
+\param adj [out]
+is the list of neighbors for all the vertices.
+
+\return
+is a vector with size m. The i-th element is true (false)
+if i does (does not) appear in row or col.
+*/
+template <class VectorSet>
+CppAD::vector<bool> color_symmetric_graph(
+	VectorSet&                    pattern   ,
+	const CppAD::vector<size_t>&  row       ,
+	const CppAD::vector<size_t>&  col       ,
+	CppAD::vector<size_t>&        adj_start ,
+	CppAD::vector<size_t>&        adj       )
+{	size_t i, j, k;
+	size_t K = row.size();
+	size_t m = pattern.n_set();
+	CPPAD_ASSERT_UNKNOWN( m == pattern.end() );
+	CPPAD_ASSERT_UNKNOWN( col.size() == K );
+
+	// rows that appear in the requested entries
+	CppAD::vector<bool> needed(m);
+	for(i = 0; i < m; i++)
+		needed[i] = false;
+	for(k = 0; k < K; k++)
+	{	CPPAD_ASSERT_UNKNOWN( pattern.is_element(row[k], col[k]) );
+		needed[ row[k] ] = true;
+		needed[ col[k] ] = true;
+	}
+
+	// neighbors for each row (the pattern may not be symmetric)
+	CppAD::vector< std::set<size_t> > neighbor(m);
+	for(i = 0; i < m; i++) if( needed[i] )
+	{	pattern.begin(i);
+		j = pattern.next_element();
+		while( j != pattern.end() )
+		{	if( needed[j] && j != i )
+			{	neighbor[i].insert(j);
+				neighbor[j].insert(i);
+			}
+			j = pattern.next_element();
+		}
+	}
+
+	// compressed storage for the graph
+	std::set<size_t>::const_iterator itr;
+	adj_start.resize(m + 1);
+	adj_start[0] = 0;
+	for(i = 0; i < m; i++)
+		adj_start[i+1] = adj_start[i] + neighbor[i].size();
+	adj.resize( adj_start[m] );
+	for(i = 0; i < m; i++)
+	{	k = adj_start[i];
+		for(itr = neighbor[i].begin(); itr != neighbor[i].end(); itr++)
+			adj[k++] = *itr;
+	}
+	return needed;
+}
+// --------------------------------------------------------------------------
+/*!
+CppAD star coloring algorithm for determining which rows of a symmetric
+sparse matrix can be computed together.
+
+This is a greedy distance one coloring of the adjacency graph
+(see color_symmetric_graph) such that every path with four vertices
+uses at least three colors.
+It follows that, for each edge (i, j), either i is the only neighbor of j
+with color[i], or j is the only neighbor of i with color[j].
+The rows are colored in decreasing order of their degree.
+
+\copydetails color_symmetric_cppad
+*/
+template <class VectorSet>
+void color_symmetric_star(
+	VectorSet&              pattern   ,
+	CppAD::vector<size_t>&  row       ,
+	CppAD::vector<size_t>&  col       ,
+	CppAD::vector<size_t>&  color     )
+{	size_t c, i, j, k, v, w, x, y, o, ell;
+
+	size_t K = row.size();
+	size_t m = pattern.n_set();
+	CPPAD_ASSERT_UNKNOWN( color.size() == m );
+
+	// adjacency graph
+	CppAD::vector<size_t> adj_start, adj;
+	CppAD::vector<bool> needed =
+		color_symmetric_graph(pattern, row, col, adj_start, adj);
+
+	// order the rows decending by degree
+	CppAD::vector<size_t> key(m), order2row(m);
+	for(i = 0; i < m; i++)
+		key[i] = m - (adj_start[i+1] - adj_start[i]);
+	CppAD::index_sort(key, order2row);
+
+	// forbidden[c] == v means color c is forbidden for vertex v
+	// count[c] is number of neighbors of v with color c (when stamp[c] == v)
+	CppAD::vector<size_t> forbidden(m), count(m), stamp(m);
+	for(c = 0; c < m; c++)
+	{	forbidden[c] = m;
+		stamp[c]     = m;
+	}
+	for(i = 0; i < m; i++)
+		color[i] = m;
+
+	for(o = 0; o < m; o++) if( needed[ order2row[o] ] )
+	{	v = order2row[o];
+
+		// distance one neighbors
+		for(ell = adj_start[v]; ell < adj_start[v+1]; ell++)
+		{	w = adj[ell];
+			c = color[w];
+			if( c < m )
+			{	forbidden[c] = v;
+				if( stamp[c] != v )
+				{	stamp[c] = v;
+					count[c] = 0;
+				}
+				count[c]++;
+			}
+		}
+		for(ell = adj_start[v]; ell < adj_start[v+1]; ell++)
+		{	w = adj[ell];
+			if( color[w] < m )
+			{	for(size_t l2 = adj_start[w]; l2 < adj_start[w+1]; l2++)
+				{	x = adj[l2];
+					if( x == v || color[x] == m )
+						continue;
+					// path x - w - v - w2 with color[w2] == color[w],
+					// forbid the color of x
+					if( count[ color[w] ] > 1 )
+						forbidden[ color[x] ] = v;
+					// path v - w - x - y with color[y] == color[w],
+					// forbid the color of x
+					else if( forbidden[ color[x] ] != v )
+					{	for(size_t l3 = adj_start[x]; l3 < adj_start[x+1]; l3++)
+						{	y = adj[l3];
+							if( y != w && color[y] == color[w] )
+								forbidden[ color[x] ] = v;
+						}
+					}
+				}
+			}
+		}
+		// pick the color with smallest index
+		c = 0;
+		while( forbidden[c] == v )
+			c++;
+		CPPAD_ASSERT_UNKNOWN( c < m );
+		color[v] = c;
+	}
+
+	// determine which sparsity entries need to be reflected
+	for(k = 0; k < K; k++) if( row[k] != col[k] )
+	{	i = row[k];
+		j = col[k];
+		// number of neighbors of j with the same color as i
+		size_t n_same = 0;
+		for(ell = adj_start[j]; ell < adj_start[j+1]; ell++)
+			n_same += size_t( color[ adj[ell] ] == color[i] );
+		CPPAD_ASSERT_UNKNOWN( n_same > 0 );
+		if( n_same > 1 )
+		{	row[k] = j;
+			col[k] = i;
+# ifndef NDEBUG
+			n_same = 0;
+			for(ell = adj_start[i]; ell < adj_start[i+1]; ell++)
+				n_same += size_t( color[ adj[ell] ] == color[j] );
+			CPPAD_ASSERT_UNKNOWN( n_same == 1 );
+# endif
+		}
+	}
+
+	// colors that are used to compute a requested entry
+	CppAD::vector<size_t> new_color(m + 1);
+	for(c = 0; c <= m; c++)
+		new_color[c] = m;
+	for(k = 0; k < K; k++)
+		new_color[ color[ row[k] ] ] = 0;
+	size_t n_color = 0;
+	for(c = 0; c < m; c++) if( new_color[c] == 0 )
+		new_color[c] = n_color++;
+
+	// remove the colors that are not used
+	for(i = 0; i < m; i++)
+		color[i] = new_color[ color[i] ];
+	return;
+}
+// --------------------------------------------------------------------------
+/*!
+CppAD acyclic coloring algorithm for determining which rows of a symmetric
+sparse matrix can be computed together, and which substitutions recover
+the requested entries.
+
+This is a greedy distance one coloring of the adjacency graph
+(see color_symmetric_graph) such that the subgraph induced by
+each pair of colors has no cycles (is a forest).
+The rows are colored in decreasing order of their degree.
+The two colored trees are tracked with a disjoint set
+(union-find) structure that has one element for each
+pair (vertex, other color) that is connected by an edge.
+\n
+\n
+Let B be the compressed matrix where <code>B(j, c)</code> is the sum
+of the entries (j, i) with <code>color[i] == c</code>.
+The diagonal entry (i, i) is equal to <code>B(i, color[i])</code>.
+The entries in each two colored tree are recovered starting at its leaves:
+if j is a leaf connected to i, (i, j) is equal to
+<code>B(j, color[i])</code> and it is subtracted from
+<code>B(i, color[j])</code> before i is treated as a leaf.
+
+\tparam VectorSet
+see color_symmetric_cppad.
+
+\param pattern [in]
+see color_symmetric_cppad.
+
+\param row [in/out]
+On input, it is a vector specifying which row indices to compute.
+On output, it has size S equal to the number of compressed values
+and <code>(row[s], col[s])</code> specifies that the compressed value
+with index s is <code>B(col[s], color[ row[s] ])</code>.
+
+\param col [in/out]
+On input, it is a vector, with the same size as row,
+that specifies which column indices to compute.
+On output, see \c row.
+
+\param color [out]
+is a vector with size m.
+The input value of its elements does not matter.
+Upon return, it is an acyclic coloring for the rows of the sparse matrix.
+If color[i] == m, i does not appear in the input row or col vectors.
+
+\param subs_from [out]
+is the vector of compressed value indices that are subtracted
+during the substitution.
+
+\param subs_to [out]
+is a vector with the same size as \c subs_from.
+For t = 0 , ... , <code>subs_from.size()-1</code>, in order,
+<code>value[ subs_to[t] ] -= value[ subs_from[t] ]</code>
+where \c value is the vector of compressed values.
+
+\param subs_index [out]
+is a vector with the same size as the input \c row vector.
+After the substitution, <code>value[ subs_index[k] ]</code>
+is the k-th requested entry.
+*/
+template <class VectorSet>
+void color_symmetric_acyclic(
+	VectorSet&              pattern    ,
+	CppAD::vector<size_t>&  row        ,
+	CppAD::vector<size_t>&  col        ,
+	CppAD::vector<size_t>&  color      ,
+	CppAD::vector<size_t>&  subs_from  ,
+	CppAD::vector<size_t>&  subs_to    ,
+	CppAD::vector<size_t>&  subs_index )
+{	size_t c, e, i, j, k, r, u, v, w, o, ell;
+
+	size_t K = row.size();
+	size_t m = pattern.n_set();
+	CPPAD_ASSERT_UNKNOWN( color.size() == m );
+
+	// adjacency graph
+	CppAD::vector<size_t> adj_start, adj;
+	CppAD::vector<bool> needed =
+		color_symmetric_graph(pattern, row, col, adj_start, adj);
+
+	// order the rows decending by degree
+	CppAD::vector<size_t> key(m), order2row(m);
+	for(i = 0; i < m; i++)
+		key[i] = m - (adj_start[i+1] - adj_start[i]);
+	CppAD::index_sort(key, order2row);
+
+	// disjoint set element for each (vertex, other color) pair
+	typedef std::pair<size_t, size_t> pair_t;
+	std::map<pair_t, size_t> tree_element;
+	std::map<pair_t, size_t>::iterator itr;
+	CppAD::vector<size_t> tree_parent;
+
+	// forbidden[c] == v means color c is forbidden for vertex v
+	CppAD::vector<size_t> forbidden(m), root;
+	for(c = 0; c < m; c++)
+		forbidden[c] = m;
+	for(i = 0; i < m; i++)
+		color[i] = m;
+
+	for(o = 0; o < m; o++) if( needed[ order2row[o] ] )
+	{	v = order2row[o];
+
+		// distance one neighbors
+		for(ell = adj_start[v]; ell < adj_start[v+1]; ell++)
+		{	c = color[ adj[ell] ];
+			if( c < m )
+				forbidden[c] = v;
+		}
+		// pick the color with smallest index that does not create a
+		// two colored cycle; i.e., two neighbors in the same tree
+		c = 0;
+		bool ok = false;
+		while( ! ok )
+		{	while( forbidden[c] == v )
+				c++;
+			CPPAD_ASSERT_UNKNOWN( c < m );
+			root.resize(0);
+			ok = true;
+			for(ell = adj_start[v]; ell < adj_start[v+1]; ell++)
+			{	w = adj[ell];
+				if( color[w] == m )
+					continue;
+				itr = tree_element.find( pair_t(w, c) );
+				if( itr == tree_element.end() )
+					continue;
+				r = itr->second;
+				while( tree_parent[r] != r )
+					r = tree_parent[r] = tree_parent[ tree_parent[r] ];
+				for(size_t l2 = 0; l2 < root.size(); l2++)
+					ok &= root[l2] != r;
+				root.push_back(r);
+			}
+			if( ! ok )
+				c++;
+		}
+		color[v] = c;
+
+		// join the trees connected by the new edges
+		for(ell = adj_start[v]; ell < adj_start[v+1]; ell++)
+		{	w = adj[ell];
+			if( color[w] == m )
+				continue;
+			size_t element[2];
+			pair_t pair[2];
+			pair[0] = pair_t(v, color[w]);
+			pair[1] = pair_t(w, c);
+			for(size_t l2 = 0; l2 < 2; l2++)
+			{	itr = tree_element.find( pair[l2] );
+				if( itr == tree_element.end() )
+				{	r = tree_parent.size();
+					tree_parent.push_back(r);
+					tree_element[ pair[l2] ] = r;
+				}
+				else
+					r = itr->second;
+				while( tree_parent[r] != r )
+					r = tree_parent[r];
+				element[l2] = r;
+			}
+			CPPAD_ASSERT_UNKNOWN( element[0] != element[1] );
+			tree_parent[ element[0] ] = element[1];
+		}
+	}
+	// -----------------------------------------------------------------------
+	// compressed values B(j, c) that are used (one for each pair j, c)
+	std::map<pair_t, size_t> value_index;
+	CppAD::vector<size_t> rep(m), value_row, value_col;
+	for(i = 0; i < m; i++)
+	{	if( color[i] < m )
+			rep[ color[i] ] = i;
+	}
+	// diagonal entries
+	for(i = 0; i < m; i++) if( color[i] < m )
+	{	value_index[ pair_t(i, color[i]) ] = value_row.size();
+		value_row.push_back( i );
+		value_col.push_back( i );
+	}
+	// off diagonal entries
+	for(i = 0; i < m; i++) if( color[i] < m )
+	{	for(ell = adj_start[i]; ell < adj_start[i+1]; ell++)
+		{	c = color[ adj[ell] ];
+			if( value_index.find( pair_t(i, c) ) == value_index.end() )
+			{	value_index[ pair_t(i, c) ] = value_row.size();
+				value_row.push_back( rep[c] );
+				value_col.push_back( i );
+			}
+		}
+	}
+
+	// edges (i, j) with i < j, and the edge for each adjacency entry
+	CppAD::vector<size_t> edge_i, edge_j, edge_key, adj_edge( adj.size() );
+	for(i = 0; i < m; i++)
+	{	for(ell = adj_start[i]; ell < adj_start[i+1]; ell++)
+		{	j = adj[ell];
+			if( j < i )
+			{	// adjacency entry for (j, i) has already been set
+				const size_t* ptr = std::lower_bound(
+					adj.data() + adj_start[j], adj.data() + adj_start[j+1], i
+				);
+				adj_edge[ell] = adj_edge[ ptr - adj.data() ];
+			}
+			else
+			{	adj_edge[ell] = edge_i.size();
+				edge_i.push_back(i);
+				edge_j.push_back(j);
+				size_t c_min = std::min(color[i], color[j]);
+				size_t c_max = std::max(color[i], color[j]);
+				edge_key.push_back( c_min * m + c_max );
+			}
+		}
+	}
+	// sort the edges by the pair of colors
+	size_t n_edge = edge_i.size();
+	CppAD::vector<size_t> edge_order(n_edge);
+	CppAD::index_sort(edge_key, edge_order);
+
+	// recover the edges in each two colored forest starting at its leaves
+	CppAD::vector<size_t> edge_value(n_edge), degree(m), leaf;
+	CppAD::vector<bool>   edge_done(n_edge);
+	for(i = 0; i < m; i++)
+		degree[i] = 0;
+	subs_from.resize(0);
+	subs_to.resize(0);
+	size_t o_begin = 0;
+	while( o_begin < n_edge )
+	{	size_t o_end = o_begin + 1;
+		while( o_end < n_edge &&
+			edge_key[ edge_order[o_end] ] == edge_key[ edge_order[o_begin] ] )
+			o_end++;
+		for(o = o_begin; o < o_end; o++)
+		{	e = edge_order[o];
+			edge_done[e] = false;
+			degree[ edge_i[e] ]++;
+			degree[ edge_j[e] ]++;
+		}
+		leaf.resize(0);
+		for(o = o_begin; o < o_end; o++)
+		{	e = edge_order[o];
+			if( degree[ edge_i[e] ] == 1 )
+				leaf.push_back( edge_i[e] );
+			if( degree[ edge_j[e] ] == 1 )
+				leaf.push_back( edge_j[e] );
+		}
+		e = edge_order[o_begin];
+		size_t c_i = color[ edge_i[e] ];
+		size_t c_j = color[ edge_j[e] ];
+		while( leaf.size() > 0 )
+		{	u = leaf[ leaf.size() - 1 ];
+			leaf.resize( leaf.size() - 1 );
+			if( degree[u] == 0 )
+				continue;
+			CPPAD_ASSERT_UNKNOWN( degree[u] == 1 );
+
+			// the edge for this leaf that has not yet been recovered
+			c = (color[u] == c_i) ? c_j : c_i;
+			e = n_edge;
+			for(ell = adj_start[u]; ell < adj_start[u+1]; ell++)
+			{	if( color[ adj[ell] ] == c && ! edge_done[ adj_edge[ell] ] )
+					e = adj_edge[ell];
+			}
+			CPPAD_ASSERT_UNKNOWN( e < n_edge );
+			w = (edge_i[e] == u) ? edge_j[e] : edge_i[e];
+			edge_done[e] = true;
+			degree[u]--;
+			degree[w]--;
+
+			// entry (u, w) is B(u, color[w]), subtract it from B(w, color[u])
+			edge_value[e] = value_index[ pair_t(u, color[w]) ];
+			if( degree[w] > 0 )
+			{	subs_from.push_back( edge_value[e] );
+				subs_to.push_back( value_index[ pair_t(w, color[u]) ] );
+			}
+			if( degree[w] == 1 )
+				leaf.push_back(w);
+		}
+# ifndef NDEBUG
+		for(o = o_begin; o < o_end; o++)
+			CPPAD_ASSERT_UNKNOWN( edge_done[ edge_order[o] ] );
+# endif
+		o_begin = o_end;
+	}
+
+	// index in the compressed values for each requested entry
+	subs_index.resize(K);
+	for(k = 0; k < K; k++)
+	{	i = row[k];
+		j = col[k];
+		if( i == j )
+			subs_index[k] = value_index[ pair_t(i, color[i]) ];
+		else
+		{	const size_t* ptr = std::lower_bound(
+				adj.data() + adj_start[i], adj.data() + adj_start[i+1], j
+			);
+			CPPAD_ASSERT_UNKNOWN( *ptr == j );
+			subs_index[k] = edge_value[ adj_edge[ ptr - adj.data() ] ];
+		}
+	}
+
+	// compressed values are computed instead of the requested entries
+	row.resize( value_row.size() );
+	col.resize( value_col.size() );
+	row = value_row;
+	col = value_col;
+	return;
+}
 // --------------------------------------------------------------------------
 /*!
 Colpack algorithm for determining which rows of a symmetric sparse matrix 
@@ -119,15 +119,23 @@ inline void forward_cosh_op_dir(
 	// rest of this routine is identical for the following cases:
 	// forward_sin_op, forward_cos_op, forward_sinh_op, forward_cosh_op
 	// (except that there is a sign difference for the hyperbolic case).
-	size_t m = (q-1) * r + 1;
-	for(size_t ell = 0; ell < r; ell++)
+	// loop over directions is innermost so it accesses contiguous memory
+	size_t k, ell, m = (q-1) * r + 1;
+	for(ell = 0; ell < r; ell++)
 	{	s[m+ell] = Base(q) * x[m + ell] * c[0];
 		c[m+ell] = Base(q) * x[m + ell] * s[0];
-		for(size_t k = 1; k < q; k++)
-		{	s[m+ell] += Base(k) * x[(k-1)*r+1+ell] * c[(q-k-1)*r+1+ell];
-			c[m+ell] += Base(k) * x[(k-1)*r+1+ell] * s[(q-k-1)*r+1+ell];
+	}
+	for(k = 1; k < q; k++)
+	{	const Base* xk = x + (k-1)*r + 1;
+		const Base* ck = c + (q-k-1)*r + 1;
+		const Base* sk = s + (q-k-1)*r + 1;
+		for(ell = 0; ell < r; ell++)
+		{	s[m+ell] += Base(k) * xk[ell] * ck[ell];
+			c[m+ell] += Base(k) * xk[ell] * sk[ell];
 		}
-		s[m+ell] /= Base(q);
+	}
+	for(ell = 0; ell < r; ell++)
+	{	s[m+ell] /= Base(q);
 		c[m+ell] /= Base(q);
 	}
 }
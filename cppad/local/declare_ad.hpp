@@ -29,6 +29,20 @@ namespace CppAD {
 		CompareNe  // not equal
 	};
 
+	// kinds of sparse derivative calculations that can be split among
+	// a team of threads (see sparse_team.hpp)
+	enum sparse_team_kind
+	{	sparse_team_jac_for, // SparseJacobianForward (multiple directions)
+		sparse_team_jac_rev, // SparseJacobianReverse
+		sparse_team_hes      // SparseHessian
+	};
+
+	// kind of work object in the binary form of sparse derivative information
+	enum binary_sparse_kind
+	{	binary_sparse_jac, // sparse_jacobian_work
+		binary_sparse_hes  // sparse_hessian_work
+	};
+
 	// simple typedefs
 	typedef CPPAD_TAPE_ADDR_TYPE addr_t;
 	typedef CPPAD_TAPE_ID_TYPE   tape_id_t;
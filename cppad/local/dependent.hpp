@@ -307,6 +307,10 @@ void ADFun<Base>::Dependent(ADTape<Base> *tape, const ADvector &y)
 	// recording to the player and and erase the tape.
 	play_.get(tape->Rec_);
 
+	// par_sweep_
+	// level schedule corresponds to the previous operation sequence
+	par_sweep_.clear();
+
 	// ind_taddr_
 	// Note that play_ has been set, we can use it to check operators
 	ind_taddr_.resize(n);
@@ -105,13 +105,18 @@ inline void forward_divvv_op_dir(
 
 	// Using CondExp, it can make sense to divide by zero,
 	// so do not make it an error.
-	size_t m = (q-1) * r + 1;
-	for(size_t ell = 0; ell < r; ell++)
-	{	z[m+ell] = x[m+ell] - z[0] * y[m+ell];
-		for(size_t k = 1; k < q; k++)		
-			z[m+ell] -= z[(q-k-1)*r+1+ell] * y[(k-1)*r+1+ell];
-		z[m+ell] /= y[0];
+	// loop over directions is innermost so it accesses contiguous memory
+	size_t k, ell, m = (q-1) * r + 1;
+	for(ell = 0; ell < r; ell++)
+		z[m+ell] = x[m+ell] - z[0] * y[m+ell];
+	for(k = 1; k < q; k++)
+	{	const Base* zk = z + (q-k-1)*r + 1;
+		const Base* yk = y + (k-1)*r + 1;
+		for(ell = 0; ell < r; ell++)
+			z[m+ell] -= zk[ell] * yk[ell];
 	}
+	for(ell = 0; ell < r; ell++)
+		z[m+ell] /= y[0];
 }
 
 
@@ -296,13 +301,18 @@ inline void forward_divpv_op_dir(
 
 	// Using CondExp, it can make sense to divide by zero,
 	// so do not make it an error.
-	size_t m = (q-1) * r + 1;
-	for(size_t ell = 0; ell < r; ell++)
-	{	z[m+ell] = - z[0] * y[m+ell];
-		for(size_t k = 1; k < q; k++)
-			z[m+ell] -= z[(q-k-1)*r+1+ell] * y[(k-1)*r+1+ell];
-		z[m+ell] /= y[0];
+	// loop over directions is innermost so it accesses contiguous memory
+	size_t k, ell, m = (q-1) * r + 1;
+	for(ell = 0; ell < r; ell++)
+		z[m+ell] = - z[0] * y[m+ell];
+	for(k = 1; k < q; k++)
+	{	const Base* zk = z + (q-k-1)*r + 1;
+		const Base* yk = y + (k-1)*r + 1;
+		for(ell = 0; ell < r; ell++)
+			z[m+ell] -= zk[ell] * yk[ell];
 	}
+	for(ell = 0; ell < r; ell++)
+		z[m+ell] /= y[0];
 }
 
 /*!
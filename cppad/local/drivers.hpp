@@ -45,6 +45,7 @@ $end
 # include <cppad/local/hessian.hpp>
 # include <cppad/local/for_two.hpp>
 # include <cppad/local/rev_two.hpp>
+# include <cppad/local/sparse_team.hpp>
 # include <cppad/local/sparse_jacobian.hpp>
 # include <cppad/local/sparse_hessian.hpp>
  
@@ -155,6 +155,130 @@ inline void forward_erf_op(
 	}
 }
 
+/*!
+Multiple direction Forward mode Taylor coefficients for op = ErfOp.
+
+The C++ source code corresponding to this operation is
+\verbatim
+	z = erf(x)
+\endverbatim
+
+\par CPPAD_HAS_ERROF_FUNCTION
+This macro is either zero or one and forward_erf_op_dir is only defined
+when it is one.
+
+\tparam Base
+base type for the operator; i.e., this operation was recorded
+using AD< \a Base > and computations by this routine are done using type
+\a Base.
+
+\param q
+order of the Taylor coefficients that we are computing.
+
+\param r
+number of directions for the Taylor coefficients that we are computing.
+
+\param i_z
+variable index corresponding to the last (primary) result for this operation;
+i.e. the row index in \a taylor corresponding to z.
+The auxillary results have index \a i_z - j for j = 1 , ... , 4.
+
+\param arg
+arg[0]: is the variable index corresponding to x.
+\n
+arg[1]: is the parameter index corresponding to the value zero.
+\n
+\arg[2]: is  the parameter index correspodning to the value 2 / sqrt(pi).
+
+\param parameter
+parameter[ arg[1] ] is the value zero,
+and parameter[ arg[2] ] is the value 2 / sqrt(pi).
+
+\param cap_order
+maximum number of orders that will fit in the \c taylor array.
+
+\param taylor
+The Taylor coefficients for the variable with index i
+start at <code>taylor + i * ( (cap_order - 1) * r + 1 )</code>.
+The zero order coefficient is at index zero and
+the k-th order coefficient in the ell-th direction is at index
+<code>(k-1)*r + 1 + ell</code>.
+\n
+\b Input:
+The coefficients of order less than q for x and the results of this
+operation, and the q-th order coefficients for x.
+\n
+\b Output:
+The q-th order coefficients for the results of this operation.
+
+\par Checked Assertions
+\li NumArg(op) == 3
+\li NumRes(op) == 5
+\li q < cap_order
+\li 0 < q
+*/
+template <class Base>
+inline void forward_erf_op_dir(
+	size_t        q           ,
+	size_t        r           ,
+	size_t        i_z         ,
+	const addr_t* arg         ,
+	const Base*   parameter   ,
+	size_t        cap_order   ,
+	Base*         taylor      )
+{
+	// check assumptions
+	CPPAD_ASSERT_UNKNOWN( NumArg(ErfOp) == 3 );
+	CPPAD_ASSERT_UNKNOWN( NumRes(ErfOp) == 5 );
+	CPPAD_ASSERT_UNKNOWN( q < cap_order );
+	CPPAD_ASSERT_UNKNOWN( 0 < q );
+
+	// array used to pass parameter values for sub-operations
+	addr_t addr[2];
+
+	// convert from final result to first result
+	i_z -= 4; // 4 = NumRes(ErfOp) - 1;
+
+	// z_0 = x * x
+	addr[0] = arg[0]; // x
+	addr[1] = arg[0]; // x
+	forward_mulvv_op_dir(q, r, i_z+0, addr, parameter, cap_order, taylor);
+
+	// z_1 = - x * x
+	addr[0] = arg[1]; // zero
+	addr[1] = i_z;    // z_0
+	forward_subpv_op_dir(q, r, i_z+1, addr, parameter, cap_order, taylor);
+
+	// z_2 = exp( - x * x )
+	forward_exp_op_dir(q, r, i_z+2, i_z+1, cap_order, taylor);
+
+	// z_3 = (2 / sqrt(pi)) * exp( - x * x )
+	addr[0] = arg[2];  // 2 / sqrt(pi)
+	addr[1] = i_z + 2; // z_2
+	forward_mulpv_op_dir(q, r, i_z+3, addr, parameter, cap_order, taylor);
+
+	// pointers to taylor coefficients for x , z_3, and z_4
+	size_t num_taylor_per_var = (cap_order-1) * r + 1;
+	Base* x    = taylor + arg[0]  * num_taylor_per_var;
+	Base* z_3  = taylor + (i_z+3) * num_taylor_per_var;
+	Base* z_4  = taylor + (i_z+4) * num_taylor_per_var;
+
+	// calculte z_4 coefficients
+	// (loop over directions is innermost so it accesses contiguous memory)
+	size_t k, ell, m = (q-1)*r + 1;
+	const Base* x_q = x + m;
+	for(ell = 0; ell < r; ell++)
+		z_4[m+ell] = Base(q) * x_q[ell] * z_3[0];
+	for(k = 1; k < q; k++)
+	{	const Base* x_k = x   + (k-1)*r + 1;
+		const Base* z_k = z_3 + (q-k-1)*r + 1;
+		for(ell = 0; ell < r; ell++)
+			z_4[m+ell] += Base(k) * x_k[ell] * z_k[ell];
+	}
+	for(ell = 0; ell < r; ell++)
+		z_4[m+ell] /= Base(q);
+}
+
 /*!
 Zero order Forward mode Taylor coefficient for result of op = ErfOp.
 
@@ -95,13 +95,18 @@ inline void forward_exp_op_dir(
 	Base* x = taylor + i_x * num_taylor_per_var;
 	Base* z = taylor + i_z * num_taylor_per_var; 
 
-	size_t m = (q-1)*r + 1;
-	for(size_t ell = 0; ell < r; ell++)
-	{	z[m+ell] = Base(q) * x[m+ell] * z[0];
-		for(size_t k = 1; k < q; k++)
-			z[m+ell] += Base(k) * x[(k-1)*r+ell+1] * z[(q-k-1)*r+ell+1];
-		z[m+ell] /= Base(q);
+	// loop over directions is innermost so it accesses contiguous memory
+	size_t k, ell, m = (q-1)*r + 1;
+	for(ell = 0; ell < r; ell++)
+		z[m+ell] = Base(q) * x[m+ell] * z[0];
+	for(k = 1; k < q; k++)
+	{	const Base* xk = x + (k-1)*r + 1;
+		const Base* zk = z + (q-k-1)*r + 1;
+		for(ell = 0; ell < r; ell++)
+			z[m+ell] += Base(k) * xk[ell] * zk[ell];
 	}
+	for(ell = 0; ell < r; ell++)
+		z[m+ell] /= Base(q);
 }
 
 /*!
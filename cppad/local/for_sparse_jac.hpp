@@ -58,6 +58,9 @@ $codei%
 	ADFun<%Base%> %f%
 %$$
 Note that the $cref ADFun$$ object $icode f$$ is not $code const$$.
+If $icode f$$ is in $cref/parallel mode/parallel_team/ForSparseJac/$$,
+a vector of bool sparsity pattern calculation is split among
+a team of threads.
 After a call to $code ForSparseJac$$, the sparsity pattern
 for each of the variables in the operation sequence
 is held in $icode f$$ (for possible later use by $cref RevSparseHes$$).
@@ -272,6 +275,10 @@ On output, \a for_jac_sparsity.n_set() == \a total_num_var
 and \a for_jac_sparsity.end() == \a q.
 It contains the forward sparsity pattern for all of the variables on the
 tape (given the sparsity pattern for the independent variables is \f$ R \f$).
+
+\param par_sweep
+is the parallel mode for the function object.
+If it is on, the columns of \f$ R \f$ are split among a team of threads.
 */
 template <class Base, class VectorSet>
 void ForSparseJacBool(
@@ -283,7 +290,8 @@ void ForSparseJacBool(
 	CppAD::vector<size_t>& dep_taddr        ,
 	CppAD::vector<size_t>& ind_taddr        ,
 	CppAD::player<Base>&   play             ,
-	sparse_pack&           for_jac_sparsity )
+	sparse_pack&           for_jac_sparsity ,
+	parallel_sweep<Base>&  par_sweep        )
 {
 	// temporary indices
 	size_t i, j;
@@ -310,20 +318,24 @@ void ForSparseJacBool(
 	{	CPPAD_ASSERT_UNKNOWN( ind_taddr[i] < total_num_var );
 		// ind_taddr[i] is operator taddr for i-th independent variable
 		CPPAD_ASSERT_UNKNOWN( play.GetOp( ind_taddr[i] ) == InvOp );
-
-		// set bits that are true
-		if( transpose )
-		{	for(j = 0; j < q; j++) if( r[ j * n + i ] )
+	}
+	// set bits that are true (access r in the order it is stored)
+	if( transpose )
+	{	for(j = 0; j < q; j++)
+		{	for(i = 0; i < n; i++) if( r[ j * n + i ] )
 				for_jac_sparsity.add_element( ind_taddr[i], j);
 		}
-		else
+	}
+	else
+	{	for(i = 0; i < n; i++)
 		{	for(j = 0; j < q; j++) if( r[ i * q + j ] )
 				for_jac_sparsity.add_element( ind_taddr[i], j);
 		}
 	}
 
 	// evaluate the sparsity patterns
-	ForJacSweep(
+	// (split the columns among a team of threads in parallel mode)
+	if( ! par_sweep.for_jac(&play, n, for_jac_sparsity) ) ForJacSweep(
 		n,
 		total_num_var,
 		&play,
@@ -331,19 +343,14 @@ void ForSparseJacBool(
 	);
 
 	// return values corresponding to dependent variables
+	// (set all of s to false in the order it is stored)
 	CPPAD_ASSERT_UNKNOWN( size_t(s.size()) == m * q );
+	for(i = 0; i < m * q; i++)
+		s[i] = false;
 	for(i = 0; i < m; i++)
 	{	CPPAD_ASSERT_UNKNOWN( dep_taddr[i] < total_num_var );
 
 		// extract the result from for_jac_sparsity
-		if( transpose )
-		{	for(j = 0; j < q; j++)
-				s[ j * m + i ] = false;
-		}
-		else
-		{	for(j = 0; j < q; j++)
-				s[ i * q + j ] = false;
-		}
 		CPPAD_ASSERT_UNKNOWN( for_jac_sparsity.end() == q );
 		for_jac_sparsity.begin( dep_taddr[i] );
 		j = for_jac_sparsity.next_element();
@@ -549,7 +556,8 @@ void ADFun<Base>::ForSparseJacCase(
 		dep_taddr_       ,
 		ind_taddr_       ,
 		play_            ,
-		for_jac_sparse_pack_
+		for_jac_sparse_pack_ ,
+		par_sweep_
 	);
 }
 
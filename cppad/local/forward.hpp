@@ -16,6 +16,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 // documened after Forward but included here so easy to see
 # include <cppad/local/capacity_order.hpp>
 # include <cppad/local/num_skip.hpp>
+# include <cppad/local/forward0_batch.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -147,7 +148,15 @@ VectorBase ADFun<Base>::Forward(
 	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
 	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_.num_load_op_rec() );
 	if( q == 0 )
-	{	forward0sweep(s, true,
+	{	// use level schedule when parallel mode is on and it is supported
+		bool done = false;
+		if( par_sweep_.active() ) done = par_sweep_.forward0(
+			&play_, C, taylor_.data(), cskip_op_.data(),
+			compare_change_count_,
+			compare_change_number_,
+			compare_change_op_index_
+		);
+		if( ! done ) forward0sweep(s, true,
 			n, num_var_tape_, &play_, C, 
 			taylor_.data(), cskip_op_.data(), load_op_,
 			compare_change_count_,
@@ -0,0 +1,226 @@
+/* $Id$ */
+# ifndef CPPAD_FORWARD0_BATCH_INCLUDED
+# define CPPAD_FORWARD0_BATCH_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin forward0_batch$$
+$spell
+	const
+	VecAD
+	xp
+$$
+
+$index forward0_batch$$
+$index forward, batch of points$$
+$index batch, zero order forward$$
+$index points, zero order forward$$
+
+$section Zero Order Forward Mode at a Batch of Points$$
+
+$head Syntax$$
+$icode%y% = %f%.forward0_batch(%n_point%, %x%)%$$
+
+$head Purpose$$
+Evaluates the function $latex F : B^n \rightarrow B^m$$
+corresponding to $icode f$$ at $icode n_point$$ argument values.
+The operation sequence is played back once
+and each operator is computed for all of the points,
+instead of calling $cref/f.Forward(0, xp)/forward_zero/$$
+once for each point.
+
+$head f$$
+The object $icode f$$ has prototype
+$codei%
+	ADFun<%Base%> %f%
+%$$
+Note that the $cref ADFun$$ object $icode f$$ is not $code const$$
+(the playback location in its operation sequence is changed),
+but the Taylor coefficients stored in $icode f$$ are not affected by
+this operation.
+
+$head n_point$$
+This argument has prototype
+$codei%
+	size_t %n_point%
+%$$
+and is the number of argument values in the batch.
+The amount of memory used by this operation is proportional to
+$icode n_point$$ times $cref/f.size_var()/seq_property/size_var/$$.
+
+$head x$$
+This argument has prototype
+$codei%
+	const %Vector%& %x%
+%$$
+and its size is $icode%n% * %n_point%$$.
+For $latex j = 0 , \ldots , n-1$$ and
+$latex p = 0 , \ldots , n\_point - 1$$,
+$codei%
+	%x%[ %j% * %n_point% + %p% ]
+%$$
+is the value of the $th j$$ component of the $th p$$ argument;
+i.e., the values for one component of all the points are contiguous.
+
+$head y$$
+The return value has prototype
+$codei%
+	%Vector% %y%
+%$$
+and its size is $icode%m% * %n_point%$$.
+For $latex i = 0 , \ldots , m-1$$ and
+$latex p = 0 , \ldots , n\_point - 1$$,
+$codei%
+	%y%[ %i% * %n_point% + %p% ]
+%$$
+is the value of the $th i$$ component of $latex F$$
+at the $th p$$ argument.
+
+$head Vector$$
+The type $icode Vector$$ must be a $cref SimpleVector$$ class with
+$cref/elements of type/SimpleVector/Elements of Specified Type/$$
+$icode Base$$.
+The routine $cref CheckSimpleVector$$ will generate an error message
+if this is not the case.
+
+$head Parallel Mode$$
+If $icode f$$ is in $cref parallel_team$$ mode,
+$cref/num_threads/ta_num_threads/$$ is greater than one,
+and execution is currently sequential,
+the points are split among the team of threads.
+
+$head Comparison Operators$$
+The $cref/comparison operators/Compare/$$ are not checked;
+i.e., the results of $cref compare_change$$ are not affected by this
+operation.
+
+$head Restrictions$$
+If the operation sequence contains
+$cref VecAD$$, $cref atomic$$, $cref Discrete$$, or $cref PrintFor$$
+operations, each point is evaluated separately
+(without using the team of threads).
+
+$children%
+	example/forward0_batch.cpp
+%$$
+$head Example$$
+The file $cref forward0_batch.cpp$$
+contains an example and test of this operation.
+It returns true if it succeeds and false otherwise.
+
+$end
+-----------------------------------------------------------------------------
+*/
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file forward0_batch.hpp
+Zero order forward mode at a batch of points.
+*/
+
+/*!
+Zero order forward mode at a batch of points.
+
+\tparam Base
+The type used during the forward mode computations; i.e., the corresponding
+recording of operations used the type AD<Base>.
+
+\tparam VectorBase
+is a Simple Vector class with eleements of type Base.
+
+\param n_point
+is the number of points.
+
+\param x
+has size <code>n * n_point</code> and
+<code>x[ j * n_point + p ]</code> is the value of the j-th
+independent variable at the p-th point.
+
+\return
+has size <code>m * n_point</code> and
+<code>y[ i * n_point + p ]</code> is the value of the i-th
+dependent variable at the p-th point.
+
+\par taylor_
+The Taylor coefficients stored in this ADFun object are not changed.
+*/
+template <typename Base>
+template <typename VectorBase>
+VectorBase ADFun<Base>::forward0_batch(size_t n_point, const VectorBase& x)
+{	// temporary indices
+	size_t i, j, p;
+
+	// number of independent variables
+	size_t n = ind_taddr_.size();
+
+	// number of dependent variables
+	size_t m = dep_taddr_.size();
+
+	// check Vector is Simple Vector class with Base type elements
+	CheckSimpleVector<Base, VectorBase>();
+
+	CPPAD_ASSERT_KNOWN(
+		size_t(x.size()) == n * n_point,
+		"forward0_batch(n_point, x): x.size() is not equal n * n_point"
+	);
+	VectorBase y(m * n_point);
+	if( n_point == 0 )
+		return y;
+
+	// value of variable i_var at point p is taylor[ i_var * n_point + p ]
+	pod_vector<Base> taylor;
+	taylor.set_tag(thread_alloc::taylor_tag);
+	taylor.extend(num_var_tape_ * n_point);
+	for(j = 0; j < n; j++)
+	{	CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == InvOp );
+		for(p = 0; p < n_point; p++)
+			taylor[ ind_taddr_[j] * n_point + p ] = x[ j * n_point + p ];
+	}
+
+	// each operator is computed for all the points
+	bool done = par_sweep_.forward0_batch(&play_, n_point, taylor.data());
+	if( ! done )
+	{	// operators not supported by the level schedule; see parallel_sweep
+		size_t num_op = play_.num_op_rec();
+		pod_vector<Base>   taylor_p;
+		pod_vector<bool>   cskip_op;
+		pod_vector<addr_t> load_op;
+		taylor_p.set_tag(thread_alloc::taylor_tag);
+		taylor_p.extend(num_var_tape_);
+		cskip_op.extend(num_op);
+		load_op.extend( play_.num_load_op_rec() );
+		size_t compare_change_number, compare_change_op_index;
+		for(p = 0; p < n_point; p++)
+		{	for(j = 0; j < n; j++)
+				taylor_p[ ind_taddr_[j] ] = x[ j * n_point + p ];
+			forward0sweep(std::cout, false,
+				n, num_var_tape_, &play_, 1,
+				taylor_p.data(), cskip_op.data(), load_op,
+				0, compare_change_number, compare_change_op_index
+			);
+			for(i = 0; i < m; i++)
+				taylor[ dep_taddr_[i] * n_point + p ] =
+					taylor_p[ dep_taddr_[i] ];
+		}
+	}
+
+	for(i = 0; i < m; i++)
+	{	CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+		for(p = 0; p < n_point; p++)
+			y[ i * n_point + p ] = taylor[ dep_taddr_[i] * n_point + p ];
+	}
+	return y;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
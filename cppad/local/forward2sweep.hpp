@@ -351,6 +351,14 @@ void forward2sweep(
 			break;
 			// -------------------------------------------------
 
+# if CPPAD_COMPILER_HAS_ERF
+			case ErfOp:
+			CPPAD_ASSERT_UNKNOWN( CPPAD_COMPILER_HAS_ERF );
+			forward_erf_op_dir(q, r, i_var, arg, parameter, J, taylor);
+			break;
+# endif
+			// -------------------------------------------------
+
 			case ExpOp:
 			forward_exp_op_dir(q, r, i_var, arg[0], J, taylor);
 			break;
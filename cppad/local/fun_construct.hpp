@@ -267,7 +267,7 @@ compare_change_count_(1),
 compare_change_number_(0),
 compare_change_op_index_(0),
 num_var_tape_(0) 
-{ }
+{	taylor_.set_tag(thread_alloc::taylor_tag); }
 
 /*!
 ADFun assignment operator
@@ -323,6 +323,9 @@ void ADFun<Base>::operator=(const ADFun<Base>& f)
 	// player
 	play_                      = f.play_;
 	//
+	// parallel_sweep (settings only, schedule is recomputed when needed)
+	par_sweep_                 = f.par_sweep_;
+	//
 	// sparse_pack
 	for_jac_sparse_pack_.resize(0, 0);
 	size_t n_set = f.for_jac_sparse_pack_.n_set();
@@ -410,6 +413,7 @@ ADFun<Base>::ADFun(const VectorAD &x, const VectorAD &y)
 		"ADFun<Base>: independent variable vector has been changed."
 	);
 	size_t j, n = x.size();
+	taylor_.set_tag(thread_alloc::taylor_tag);
 # ifndef NDEBUG
 	size_t i, m = y.size();
 	for(j = 0; j < n; j++)
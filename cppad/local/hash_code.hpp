@@ -6,13 +6,16 @@
 CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
-the terms of the 
+the terms of the
                     Eclipse Public License Version 1.0.
 
 A copy of this license is included in the COPYING file of this distribution.
 Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 
+# include <cstring>
+# include <limits>
+
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
 \file hash_code.hpp
@@ -21,11 +24,82 @@ CppAD hashing utility.
 
 /*!
 \def CPPAD_HASH_TABLE_SIZE
-the codes retruned by hash_code are between zero and CPPAD_HASH_TABLE_SIZE 
-minus one. 
+minimum number of entries that optimize reserves in its hash table
+(the hash tables grow as necessary; see hash_table).
 */
 # define CPPAD_HASH_TABLE_SIZE 10000
 
+/*!
+Mix one 32 bit block into a hash value.
+
+This is the block step of the MurmurHash3 algorithm
+(which is in the public domain).
+Every bit of \a k affects many bits of \a h, so values that differ
+only in their high (or low) order bits get different hash codes.
+
+\param h
+is the hash value before and after this block is mixed in.
+
+\param k
+is the block that is mixed in.
+*/
+inline void hash_mix(unsigned int& h, unsigned int k)
+{	CPPAD_ASSERT_UNKNOWN( std::numeric_limits<unsigned int>::digits == 32 );
+	k *= 0xcc9e2d51;
+	k  = (k << 15) | (k >> 17);
+	k *= 0x1b873593;
+	h ^= k;
+	h  = (h << 13) | (h >> 19);
+	h  = h * 5 + 0xe6546b64;
+}
+
+/*!
+Mix a sequence of bytes into a hash value.
+
+\param h
+is the hash value before and after the bytes are mixed in.
+
+\param ptr
+is the address of the first byte.
+
+\param n_byte
+is the number of bytes.
+*/
+inline void hash_mix(unsigned int& h, const void* ptr, size_t n_byte)
+{	const unsigned char* c = reinterpret_cast<const unsigned char*>(ptr);
+	unsigned int k;
+	while( n_byte >= 4 )
+	{	std::memcpy(&k, c, 4);
+		hash_mix(h, k);
+		c      += 4;
+		n_byte -= 4;
+	}
+	if( n_byte > 0 )
+	{	k = 0;
+		std::memcpy(&k, c, n_byte);
+		hash_mix(h, k);
+	}
+}
+
+/*!
+Final avalanche of a hash value.
+
+\param h
+is the hash value after all the blocks have been mixed in.
+
+\return
+is the hash code corresponding to \a h (the low order bits of the
+return value can be used to index a hash table).
+*/
+inline size_t hash_final(unsigned int h)
+{	h ^= h >> 16;
+	h *= 0x85ebca6b;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35;
+	h ^= h >> 16;
+	return static_cast<size_t>(h);
+}
+
 /*!
 General purpose hash code for an arbitrary value.
 
@@ -39,35 +113,15 @@ not pointed to by the object.
 the value that we are generating a hash code for.
 
 \return
-is a hash code that is between zero and CPPAD_HASH_TABLE_SIZE - 1.
-
-\par Checked Assertions
-\li \c std::numeric_limits<unsigned short>::max() >= CPPAD_HASH_TABLE_SIZE
-\li \c sizeof(value) is even 
-\li \c sizeof(unsigned short)  == 2
+is a hash code for this value; all of its bits depend on all of
+the bytes in \a value.
 */
 
 template <class Value>
-unsigned short hash_code(const Value& value)
-{	CPPAD_ASSERT_UNKNOWN( 
-		std::numeric_limits<unsigned short>::max()
-		>=
-		CPPAD_HASH_TABLE_SIZE
-	);
-	CPPAD_ASSERT_UNKNOWN( sizeof(unsigned short) == 2 );
-	CPPAD_ASSERT_UNKNOWN( sizeof(value) % 2  == 0 );
-	#
-	const unsigned short* v
-	         = reinterpret_cast<const unsigned short*>(& value);
-	#
-	size_t i = sizeof(value) / 2 - 1;
-	#
-	unsigned short code = v[i];
-	#
-	while(i--)
-		code += v[i];
-
-	return code % CPPAD_HASH_TABLE_SIZE;
+size_t hash_code(const Value& value)
+{	unsigned int h = 0;
+	hash_mix(h, &value, sizeof(value));
+	return hash_final(h);
 }
 
 /*!
@@ -75,15 +129,14 @@ Specialized hash code for a CppAD operator and its arguments.
 
 \param op
 is the operator that we are computing a hash code for.
-If it is not one of the following operartors, the operator is not
-hash coded and zero is returned:
+It must be one of the following operartors:
 
 \li unary operators:
-AbsOp, AcosOp, AsinOp, AtanOp, CosOp, CoshOp
-ExpOp, LogOp, SinOp, SinhOp, SqrtOp, TanOp, TanhOp
+AbsOp, AcosOp, AsinOp, AtanOp, CosOp, CoshOp, ErfOp,
+ExpOp, LogOp, SignOp, SinOp, SinhOp, SqrtOp, TanOp, TanhOp
 
 \li binary operators where first argument is a parameter:
-AddpvOp, DivpvOp, MulpvOp, PowpvOp, SubpvOp, 
+AddpvOp, DivpvOp, MulpvOp, PowpvOp, SubpvOp,
 
 \li binary operators where second argument is a parameter:
 DivvpOp, PowvpOp, SubvpOp
@@ -107,75 +160,42 @@ for this operation sequence; i.e.,
 given a parameter index of \c i, the corresponding parameter value is
 \a par[i].
 
-
 \return
-is a hash code that is between zero and CPPAD_HASH_TABLE_SIZE - 1.
+is a hash code for this operator and its arguments;
+all of its bits depend on the operator and all the bytes in its arguments.
+Parameters are coded by value instead of by index for two reasons.
+One, it gives better separation.
+Two, different indices can be same parameter value.
 
 \par Checked Assertions
 \c op must be one of the operators specified above. In addition,
-\li \c std::numeric_limits<unsigned short>::max() >= CPPAD_HASH_TABLE_SIZE 
-\li \c sizeof(size_t) is even 
-\li \c sizeof(Base) is even 
-\li \c sizeof(unsigned short)  == 2
-\li \c size_t(op) < size_t(NumberOp) <= CPPAD_HASH_TABLE_SIZE
 \li if the j-th argument for this operation is a parameter, arg[j] < npar.
 */
 
 template <class Base>
-unsigned short hash_code(
-	OpCode        op      , 
-	const addr_t* arg     , 
-	size_t npar           , 
+size_t hash_code(
+	OpCode        op      ,
+	const addr_t* arg     ,
+	size_t npar           ,
 	const Base* par       )
-{	CPPAD_ASSERT_UNKNOWN( 
-		std::numeric_limits<unsigned short>::max()
-		>=
-		CPPAD_HASH_TABLE_SIZE
-	);
-	CPPAD_ASSERT_UNKNOWN( size_t (op) < size_t(NumberOp) );
-	CPPAD_ASSERT_UNKNOWN( sizeof(unsigned short) == 2 );
-	CPPAD_ASSERT_UNKNOWN( sizeof(addr_t) % 2  == 0 );
-	CPPAD_ASSERT_UNKNOWN( sizeof(Base) % 2  == 0 );
-	unsigned short op_fac = static_cast<unsigned short> (
-		CPPAD_HASH_TABLE_SIZE / static_cast<unsigned short>(NumberOp)
-	);
-	CPPAD_ASSERT_UNKNOWN( op_fac > 0 );
-
-	// number of shorts per addr_t value
-	size_t short_addr_t   = sizeof(addr_t) / 2;
-
-	// number of shorts per Base value
-	size_t short_base     = sizeof(Base) /  2;
-
-	// initialize with value that separates operators as much as possible
-	unsigned short code = static_cast<unsigned short>(
-		static_cast<unsigned short>(op) * op_fac
-	);
+{	CPPAD_ASSERT_UNKNOWN( size_t (op) < size_t(NumberOp) );
 
-	// now code in the operands
-	size_t i;
-	const unsigned short* v;
+	// start with the operator
+	unsigned int h = 0;
+	hash_mix(h, static_cast<unsigned int>(op) );
 
-	// first argument
+	// now code in the operands
 	switch(op)
 	{	// Binary operators where first arugment is a parameter.
-		// Code parameters by value instead of
-		// by index for two reasons. One, it gives better separation.
-		// Two, different indices can be same parameter value.
 		case AddpvOp:
 		case DivpvOp:
 		case MulpvOp:
 		case PowpvOp:
 		case SubpvOp:
 		CPPAD_ASSERT_UNKNOWN( NumArg(op) == 2 );
-		v = reinterpret_cast<const unsigned short*>(par + arg[0]);
-		i = short_base;
-		while(i--)
-			code += v[i];
-		v = reinterpret_cast<const unsigned short*>(arg + 1);
-		i = short_addr_t;
-		while(i--)
-			code += v[i];
+		CPPAD_ASSERT_UNKNOWN( size_t(arg[0]) < npar );
+		hash_mix(h, par + arg[0], sizeof(Base) );
+		hash_mix(h, arg + 1,      sizeof(addr_t) );
 		break;
 
 		// Binary operator where first argument is an index and
@@ -189,10 +209,7 @@ unsigned short hash_code(
 		case PowvvOp:
 		case SubvvOp:
 		CPPAD_ASSERT_UNKNOWN( NumArg(op) == 2 );
-		v = reinterpret_cast<const unsigned short*>(arg + 0);
-		i = 2 * short_addr_t;
-		while(i--)
-			code += v[i];
+		hash_mix(h, arg + 0, 2 * sizeof(addr_t) );
 		break;
 
 		// Binary operators where second arugment is a parameter.
@@ -200,14 +217,9 @@ unsigned short hash_code(
 		case PowvpOp:
 		case SubvpOp:
 		CPPAD_ASSERT_UNKNOWN( NumArg(op) == 2 );
-		v = reinterpret_cast<const unsigned short*>(arg + 0);
-		i = short_addr_t;
-		while(i--)
-			code += v[i];
-		v = reinterpret_cast<const unsigned short*>(par + arg[1]);
-		i = short_base;
-		while(i--)
-			code += v[i];
+		CPPAD_ASSERT_UNKNOWN( size_t(arg[1]) < npar );
+		hash_mix(h, arg + 0,      sizeof(addr_t) );
+		hash_mix(h, par + arg[1], sizeof(Base) );
 		break;
 
 		// Unary operators
@@ -227,10 +239,7 @@ unsigned short hash_code(
 		case TanOp:
 		case TanhOp:
 		CPPAD_ASSERT_UNKNOWN( NumArg(op) == 1 || op == ErfOp );
-		v = reinterpret_cast<const unsigned short*>(arg + 0);
-		i = short_addr_t;
-		while(i--)
-			code += v[i];
+		hash_mix(h, arg + 0, sizeof(addr_t) );
 		break;
 
 		// should have been one of he cases above
@@ -238,7 +247,7 @@ unsigned short hash_code(
 		CPPAD_ASSERT_UNKNOWN(false);
 	}
 
-	return code % CPPAD_HASH_TABLE_SIZE;
+	return hash_final(h);
 }
 
 } // END_CPPAD_NAMESPACE
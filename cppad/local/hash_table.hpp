@@ -0,0 +1,231 @@
+/* $Id$ */
+# ifndef CPPAD_HASH_TABLE_INCLUDED
+# define CPPAD_HASH_TABLE_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <limits>
+# include <cppad/local/cppad_assert.hpp>
+# include <cppad/local/pod_vector.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file hash_table.hpp
+Open addressing hash table that maps hash codes to indices.
+*/
+
+/*!
+Open addressing hash table that maps hash codes to indices.
+
+Each entry in the table is a pair consisting of the hash code
+for a value and the index of the value in a vector owned by the user
+of the table (for example, a parameter index or a variable index).
+The table does not know how to compare values, so more than one
+entry may have the same hash code; the user checks each index returned
+by \c find and \c find_next for a match.
+Linear probing is used, and the number of slots is a power of two that is
+more than twice the number of entries, so the probe sequences stay short
+when the hash codes are well mixed (see \c hash_code).
+
+The hash codes and indices are stored using \c addr_t values
+(the indices are less than the maximum \c addr_t value because they
+refer to recording vectors) and each code is next to its index,
+so checking a slot only touches one cache line.
+
+This table is used by recorder::PutPar to find parameters that
+have already been recorded, and by optimize to find common subexpressions.
+*/
+class hash_table {
+private:
+	/// number of slots minus one (the number of slots is a power of two)
+	size_t             mask_;
+
+	/// number of entries currently in the table
+	size_t             n_entry_;
+
+	/// maximum number of slots (a power of two)
+	size_t             max_slot_;
+
+	/// For each slot, the hash code for the entry is
+	/// <tt>entry_[2*slot]</tt> and the index for the entry is
+	/// <tt>entry_[2*slot+1]</tt> (empty() if the slot is not used).
+	pod_vector<addr_t> entry_;
+
+	/// index value used to mark an empty slot
+	static addr_t empty(void)
+	{	return std::numeric_limits<addr_t>::max(); }
+
+	/// first slot, at or after the specified slot, that has the specified
+	/// code (end() if there is no such slot)
+	size_t probe(size_t slot, addr_t code) const
+	{	while( entry_[2 * slot + 1] != empty() )
+		{	if( entry_[2 * slot] == code )
+				return slot;
+			slot = (slot + 1) & mask_;
+		}
+		return end();
+	}
+
+	/// place a new entry in the first empty slot for its code
+	void place(addr_t code, addr_t index)
+	{	size_t slot = size_t(code) & mask_;
+		while( entry_[2 * slot + 1] != empty() )
+			slot = (slot + 1) & mask_;
+		entry_[2 * slot]     = code;
+		entry_[2 * slot + 1] = index;
+	}
+
+	/*!
+	Change the number of slots and move the current entries to the new slots.
+
+	\param n_slot
+	is the new number of slots. It must be a power of two and
+	greater than twice the number of entries.
+	*/
+	void rehash(size_t n_slot)
+	{	CPPAD_ASSERT_UNKNOWN( (n_slot & (n_slot - 1)) == 0 );
+		CPPAD_ASSERT_UNKNOWN( 2 * n_entry_ < n_slot );
+		pod_vector<addr_t> old_entry;
+		old_entry.swap(entry_);
+		entry_.extend(2 * n_slot);
+		mask_ = n_slot - 1;
+		for(size_t slot = 0; slot < n_slot; slot++)
+			entry_[2 * slot + 1] = empty();
+		for(size_t i = 0; i < old_entry.size(); i += 2)
+		{	if( old_entry[i + 1] != empty() )
+				place(old_entry[i], old_entry[i + 1]);
+		}
+	}
+public:
+	/*!
+	Constructor; the table is empty and no memory is allocated.
+
+	\param max_slot
+	is the maximum number of slots in the table (it must be a power of two).
+	If the table has this many slots and is half full,
+	all the entries are removed before the next one is inserted;
+	i.e., the table acts as a cache for the most recent entries.
+	*/
+	hash_table(size_t max_slot = std::numeric_limits<size_t>::max() / 2 + 1)
+	: mask_(0), n_entry_(0), max_slot_(max_slot)
+	{	CPPAD_ASSERT_UNKNOWN( (max_slot & (max_slot - 1)) == 0 ); }
+
+	/*!
+	Remove all the entries and make room for a specified number of entries.
+
+	\param n_expect
+	is the number of entries that can be inserted before the
+	table grows (and its entries are moved to new slots).
+	*/
+	void resize(size_t n_expect)
+	{	size_t n_slot = 16;
+		while( n_slot <= 2 * n_expect && n_slot < max_slot_ )
+			n_slot *= 2;
+		entry_.erase();
+		n_entry_ = 0;
+		rehash(n_slot);
+	}
+
+	/// remove all the entries and free the corresponding memory
+	void free(void)
+	{	entry_.free();
+		mask_    = 0;
+		n_entry_ = 0;
+	}
+
+	/// number of entries currently in the table
+	size_t size(void) const
+	{	return n_entry_; }
+
+	/// value returned by find and find_next when there are no more
+	/// entries with the specified hash code
+	size_t end(void) const
+	{	return std::numeric_limits<size_t>::max(); }
+
+	/*!
+	First entry with a specified hash code.
+
+	\param code
+	is the hash code we are searching for.
+
+	\return
+	is the slot for the first entry with this hash code,
+	or end() if there is no such entry.
+	*/
+	size_t find(size_t code) const
+	{	if( n_entry_ == 0 )
+			return end();
+		addr_t c = addr_t(code);
+		return probe(size_t(c) & mask_, c);
+	}
+
+	/*!
+	Next entry with a specified hash code.
+
+	\param slot
+	is a slot returned by a previous call to find or find_next
+	for this hash code (it can not be end()).
+
+	\param code
+	is the hash code we are searching for.
+
+	\return
+	is the slot for the next entry with this hash code,
+	or end() if there is no such entry.
+	*/
+	size_t find_next(size_t slot, size_t code) const
+	{	addr_t c = addr_t(code);
+		CPPAD_ASSERT_UNKNOWN( slot != end() && entry_[2 * slot] == c );
+		return probe( (slot + 1) & mask_, c );
+	}
+
+	/// index for the entry in a slot returned by find or find_next
+	size_t index(size_t slot) const
+	{	CPPAD_ASSERT_UNKNOWN( entry_[2 * slot + 1] != empty() );
+		return size_t( entry_[2 * slot + 1] );
+	}
+
+	/*!
+	Insert a new entry in the table
+	(the number of slots is doubled when the table becomes half full).
+
+	\param code
+	is the hash code for the new entry.
+
+	\param index
+	is the index for the new entry.
+	It must be less than the maximum \c addr_t value.
+	*/
+	void insert(size_t code, size_t index)
+	{	CPPAD_ASSERT_UNKNOWN( index < size_t( empty() ) );
+		size_t n_slot = entry_.size() / 2;
+		if( 2 * (n_entry_ + 1) >= n_slot )
+		{	if( n_slot >= max_slot_ )
+			{	// remove all the entries
+				for(size_t slot = 0; slot < n_slot; slot++)
+					entry_[2 * slot + 1] = empty();
+				n_entry_ = 0;
+			}
+			else
+				rehash( n_slot == 0 ? 16 : 2 * n_slot );
+		}
+		place( addr_t(code), addr_t(index) );
+		n_entry_++;
+	}
+
+	/// number of bytes of memory used by this table
+	size_t Memory(void) const
+	{	return entry_.capacity() * sizeof(addr_t); }
+};
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -3,7 +3,7 @@
 # define CPPAD_HESSIAN_INCLUDED
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-12 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -113,6 +113,16 @@ $icode Base$$.
 The routine $cref CheckSimpleVector$$ will generate an error message
 if this is not the case.
 
+$head Method$$
+This will use order zero Forward mode,
+one order one $cref forward_dir$$ sweep and one
+second order reverse sweep for each block of up to 64
+components of $icode x$$.
+If the operation sequence for $icode f$$ contains
+$cref VecAD$$ or $cref atomic$$ operations,
+one order one Forward and one order two Reverse sweep
+is used for each component of $icode x$$.
+
 $head Hessian Uses Forward$$
 After each call to $cref Forward$$,
 the object $icode f$$ contains the corresponding 
@@ -162,10 +172,13 @@ Vector ADFun<Base>::Hessian(const Vector &x, size_t l)
 template <typename Base>
 template <typename Vector>
 Vector ADFun<Base>::Hessian(const Vector &x, const Vector &w)
-{	size_t j;
+{	size_t i;
+	size_t j;
 	size_t k;
+	size_t ell;
 
 	size_t n = Domain();
+	size_t m = Range();
 
 	// check Vector is Simple Vector class with Base type elements
 	CheckSimpleVector<Base, Vector>();
@@ -175,7 +188,7 @@ Vector ADFun<Base>::Hessian(const Vector &x, const Vector &w)
 		"Hessian: length of x not equal domain dimension for f"
 	); 
 	CPPAD_ASSERT_KNOWN(
-		size_t(w.size()) == Range(),
+		size_t(w.size()) == m,
 		"Hessian: length of w not equal range dimension for f"
 	);
 
@@ -185,6 +198,67 @@ Vector ADFun<Base>::Hessian(const Vector &x, const Vector &w)
 	// define the return value
 	Vector hes(n * n);
 
+	// number of variables on the tape
+	size_t numvar = num_var_tape_;
+
+	// number of coordinate directions for each sweep
+	size_t r_sweep = JacobianDirection(numvar, n);
+
+	// loop through the different coordinate directions
+	size_t j0 = 0;
+	while( j0 < n )
+	{	// number of directions we will do this time
+		size_t r = std::min(r_sweep, n - j0);
+
+		// set u to the coordinate directions j0 , ... , j0 + r - 1
+		Vector u(n * r);
+		for(j = 0; j < n * r; j++)
+			u[j] = Base(0);
+		for(ell = 0; ell < r; ell++)
+			u[ (j0 + ell) * r + ell ] = Base(1);
+		Forward(1, r, u);
+
+		// weight for each variable
+		pod_vector<Base> adjoint, partial;
+		adjoint.extend(numvar);
+		partial.extend(numvar * r);
+		for(i = 0; i < numvar; i++)
+			adjoint[i] = Base(0);
+		for(i = 0; i < m; i++)
+			adjoint[ dep_taddr_[i] ] += w[i];
+		for(i = 0; i < numvar * r; i++)
+			partial[i] = Base(0);
+
+		// Taylor coefficients for variable i start at taylor_[i * c]
+		size_t c = (cap_order_taylor_ - 1) * num_direction_taylor_ + 1;
+
+		// second order reverse for all the directions in one sweep
+		bool ok = RevVecHesSweep(
+			n,
+			numvar,
+			&play_,
+			c,
+			taylor_.data(),
+			cskip_op_.data(),
+			r,
+			adjoint.data(),
+			partial.data()
+		);
+		if( ! ok )
+			break;
+
+		// return desired components
+		for(k = 0; k < n; k++)
+		{	for(ell = 0; ell < r; ell++)
+				hes[k * n + j0 + ell] = partial[ ind_taddr_[k] * r + ell ];
+		}
+		j0 += r;
+	}
+	if( j0 == n )
+		return hes;
+
+	// VecAD and atomic operations are not supported by RevVecHesSweep,
+	// use one forward and reverse sweep for each direction
 	// direction vector for calls to forward
 	Vector u(n);
 	for(j = 0; j < n; j++)
@@ -3,7 +3,7 @@
 # define CPPAD_JACOBIAN_INCLUDED
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -13,6 +13,13 @@ A copy of this license is included in the COPYING file of this distribution.
 Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 
+// maximum number of directions to compute at the same time
+# define CPPAD_JACOBIAN_MAX_MULTIPLE_DIRECTION 64
+
+// maximum number of first order Taylor coefficients (or partials),
+// for all the variables and directions, during one sweep
+# define CPPAD_JACOBIAN_MAX_MULTIPLE_TAYLOR 16777216
+
 /*
 $begin Jacobian$$
 $spell
@@ -92,6 +99,10 @@ $head Forward or Reverse$$
 This will use order zero Forward mode and either
 order one Forward or order one Reverse to compute the Jacobian
 (depending on which it estimates will require less work).
+The forward mode case uses $cref forward_dir$$
+and the reverse mode case uses $cref reverse_dir$$,
+so that each sweep of the operation sequence computes
+up to 64 columns (or rows) of the Jacobian.
 After each call to $cref Forward$$,
 the object $icode f$$ contains the corresponding 
 $cref/Taylor coefficients/glossary/Taylor Coefficient/$$.
@@ -115,10 +126,35 @@ $end
 //  BEGIN CppAD namespace
 namespace CppAD {
 
+/*!
+Determine the number of directions to use for each sweep.
+
+\param num_var
+is the number of variables in the operation sequence.
+
+\param n_dir
+is the total number of directions that must be computed.
+
+\return
+is the number of directions to use for each sweep. It is chosen so that
+the directions are split evenly among the fewest sweeps possible.
+*/
+inline size_t JacobianDirection(size_t num_var, size_t n_dir)
+{	if( n_dir == 0 )
+		return 1;
+	size_t max_r      = CPPAD_JACOBIAN_MAX_MULTIPLE_DIRECTION;
+	size_t max_taylor = CPPAD_JACOBIAN_MAX_MULTIPLE_TAYLOR;
+	if( max_r * num_var > max_taylor )
+		max_r = std::max( size_t(1), max_taylor / num_var );
+	size_t n_sweep = (n_dir + max_r - 1) / max_r;
+	return (n_dir + n_sweep - 1) / n_sweep;
+}
+
 template <typename Base, typename Vector>
 void JacobianFor(ADFun<Base> &f, const Vector &x, Vector &jac)
 {	size_t i;
 	size_t j;
+	size_t ell;
 
 	size_t n = f.Domain();
 	size_t m = f.Range();
@@ -129,34 +165,38 @@ void JacobianFor(ADFun<Base> &f, const Vector &x, Vector &jac)
 	CPPAD_ASSERT_UNKNOWN( size_t(x.size())   == f.Domain() );
 	CPPAD_ASSERT_UNKNOWN( size_t(jac.size()) == f.Range() * f.Domain() );
 
-	// argument and result for forward mode calculations
-	Vector u(n);
-	Vector v(m);
+	// number of coordinate directions for each sweep
+	size_t r_sweep = JacobianDirection(f.size_var(), n);
 
-	// initialize all the components
-	for(j = 0; j < n; j++)
-		u[j] = Base(0);
-	
 	// loop through the different coordinate directions
-	for(j = 0; j < n; j++)
-	{	// set u to the j-th coordinate direction
-		u[j] = Base(1);
+	size_t j0 = 0;
+	while( j0 < n )
+	{	// number of directions we will do this time
+		size_t r = std::min(r_sweep, n - j0);
 
-		// compute the partial of f w.r.t. this coordinate direction
-		v = f.Forward(1, u);
+		// set u to the coordinate directions j0 , ... , j0 + r - 1
+		Vector u(n * r);
+		for(j = 0; j < n * r; j++)
+			u[j] = Base(0);
+		for(ell = 0; ell < r; ell++)
+			u[ (j0 + ell) * r + ell ] = Base(1);
 
-		// reset u to vector of all zeros
-		u[j] = Base(0);
+		// compute the partial of f w.r.t. these coordinate directions
+		Vector v = f.Forward(1, r, u);
 
 		// return the result
 		for(i = 0; i < m; i++)
-			jac[ i * n + j ] = v[i];
+		{	for(ell = 0; ell < r; ell++)
+				jac[ i * n + j0 + ell ] = v[ i * r + ell ];
+		}
+		j0 += r;
 	}
 }
 template <typename Base, typename Vector>
 void JacobianRev(ADFun<Base> &f, const Vector &x, Vector &jac)
 {	size_t i;
 	size_t j;
+	size_t ell;
 
 	size_t n = f.Domain();
 	size_t m = f.Range();
@@ -164,36 +204,44 @@ void JacobianRev(ADFun<Base> &f, const Vector &x, Vector &jac)
 	CPPAD_ASSERT_UNKNOWN( size_t(x.size())   == f.Domain() );
 	CPPAD_ASSERT_UNKNOWN( size_t(jac.size()) == f.Range() * f.Domain() );
 
-	// argument and result for reverse mode calculations
-	Vector u(n);
-	Vector v(m);
-
-	// initialize all the components
-	for(i = 0; i < m; i++)
-		v[i] = Base(0);
-	
-	// loop through the different coordinate directions
+	// components of f that are not parameters
+	CppAD::vector<size_t> row;
 	for(i = 0; i < m; i++)
 	{	if( f.Parameter(i) )
 		{	// return zero for this component of f
 			for(j = 0; j < n; j++)
 				jac[ i * n + j ] = Base(0);
 		}
-		else
-		{ 
-			// set v to the i-th coordinate direction
-			v[i] = Base(1);
+		else	row.push_back(i);
+	}
+	size_t n_row = row.size();
 
-			// compute the derivative of this component of f
-			u = f.Reverse(1, v);
+	// number of coordinate directions for each sweep
+	size_t r_sweep = JacobianDirection(f.size_var(), n_row);
 
-			// reset v to vector of all zeros
+	// loop through the different coordinate directions
+	size_t k0 = 0;
+	while( k0 < n_row )
+	{	// number of directions we will do this time
+		size_t r = std::min(r_sweep, n_row - k0);
+
+		// set v to the coordinate directions row[k0] , ... , row[k0+r-1]
+		Vector v(m * r);
+		for(i = 0; i < m * r; i++)
 			v[i] = Base(0);
+		for(ell = 0; ell < r; ell++)
+			v[ row[k0 + ell] * r + ell ] = Base(1);
 
-			// return the result
+		// compute the derivative of these components of f
+		Vector u = f.Reverse(1, r, v);
+
+		// return the result
+		for(ell = 0; ell < r; ell++)
+		{	i = row[k0 + ell];
 			for(j = 0; j < n; j++)
-				jac[ i * n + j ] = u[j];
+				jac[ i * n + j ] = u[ j * r + ell ];
 		}
+		k0 += r;
 	}
 }
 
@@ -233,4 +281,6 @@ Vector ADFun<Base>::Jacobian(const Vector &x)
 
 } // END CppAD namespace
 
+# undef CPPAD_JACOBIAN_MAX_MULTIPLE_DIRECTION
+# undef CPPAD_JACOBIAN_MAX_MULTIPLE_TAYLOR
 # endif
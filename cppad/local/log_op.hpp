@@ -102,13 +102,18 @@ inline void forward_log_op_dir(
 	Base* x = taylor + i_x * num_taylor_per_var;
 	Base* z = taylor + i_z * num_taylor_per_var;
 
-	size_t m = (q-1) * r + 1;
-	for(size_t ell = 0; ell < r; ell++)
-	{	z[m+ell] = Base(q) * x[m+ell];
-		for(size_t k = 1; k < q; k++)
-			z[m+ell] -= Base(k) * z[(k-1)*r+1+ell] * x[(q-k-1)*r+1+ell];
+	// loop over directions is innermost so it accesses contiguous memory
+	size_t k, ell, m = (q-1) * r + 1;
+	for(ell = 0; ell < r; ell++)
+		z[m+ell] = Base(q) * x[m+ell];
+	for(k = 1; k < q; k++)
+	{	const Base* zk = z + (k-1)*r + 1;
+		const Base* xk = x + (q-k-1)*r + 1;
+		for(ell = 0; ell < r; ell++)
+			z[m+ell] -= Base(k) * zk[ell] * xk[ell];
+	}
+	for(ell = 0; ell < r; ell++)
 		z[m+ell] /= (Base(q) * x[0]);
-	}	
 }
 
 /*!
@@ -98,12 +98,15 @@ inline void forward_mulvv_op_dir(
 	Base* y = taylor + arg[1] * num_taylor_per_var;
 	Base* z = taylor +    i_z * num_taylor_per_var;
 
-	size_t k, ell, m;
+	// loop over directions is innermost so it accesses contiguous memory
+	size_t k, ell, m = (q-1)*r + 1;
 	for(ell = 0; ell < r; ell++)
-	{	m = (q-1)*r + ell + 1;
-		z[m] = x[0] * y[m] + x[m] * y[0];
-		for(k = 1; k < q; k++)
-			z[m] += x[(q-k-1)*r + ell + 1] * y[(k-1)*r + ell + 1];
+		z[m+ell] = x[0] * y[m+ell] + x[m+ell] * y[0];
+	for(k = 1; k < q; k++)
+	{	const Base* xk = x + (q-k-1)*r + 1;
+		const Base* yk = y + (k-1)*r + 1;
+		for(ell = 0; ell < r; ell++)
+			z[m+ell] += xk[ell] * yk[ell];
 	}
 }
 
@@ -23,6 +23,7 @@ $spell
 	CppAD
 	cppad
 	std
+	hpp
 	CondExpEq
 $$
 
@@ -88,6 +89,15 @@ $codei%
 See the discussion about
 $cref/sequence constructors/FunConstruct/Sequence Constructor/$$.
 
+$subhead Timing$$
+$index CPPAD_OPTIMIZE_TIMING$$
+If the preprocessor symbol $code CPPAD_OPTIMIZE_TIMING$$ is defined as one
+before $code cppad/cppad.hpp$$ is included,
+the elapsed time for each phase of the optimization
+is printed on standard output.
+This can be used to see where the time goes when optimizing
+very large operation sequences.
+
 $head Atomic Functions$$
 There are some subtitle issue with optimized $cref atomic$$ functions
 $latex v = g(u)$$:
@@ -131,6 +141,21 @@ $end
 */
 # include <stack>
 
+/*!
+\def CPPAD_OPTIMIZE_TIMING
+This value is either zero or one.
+Zero is the normal operational value.
+If it is one, the elapsed time for each phase of the optimization
+is printed on standard output.
+*/
+# ifndef CPPAD_OPTIMIZE_TIMING
+# define CPPAD_OPTIMIZE_TIMING 0
+# endif
+
+# if CPPAD_OPTIMIZE_TIMING
+# include <cppad/elapsed_seconds.hpp>
+# endif
+
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 namespace optimize { // BEGIN_CPPAD_OPTIMIZE_NAMESPACE
 /*!
@@ -138,6 +163,25 @@ namespace optimize { // BEGIN_CPPAD_OPTIMIZE_NAMESPACE
 Routines for optimizing a tape
 */
 
+# if CPPAD_OPTIMIZE_TIMING
+/*!
+Print the elapsed time for one phase of the optimization.
+
+\param phase
+is the name of the phase that just completed.
+
+\param start
+On input, it is the elapsed_seconds value at the beginning of the phase.
+Upon return, it is the elapsed_seconds value at the end of the phase.
+*/
+inline void optimize_timing(const char* phase, double& start)
+{	double now = elapsed_seconds();
+	std::cout << "optimize: " << phase << " = " << now - start
+	          << " seconds" << std::endl;
+	start = now;
+}
+# endif
+
 
 /*!
 State for this variable set during reverse sweep.
@@ -454,10 +498,9 @@ given a parameter index \c i, the corresponding parameter value is
 <!-- end prototype -->
 
 \param hash_table_var
-is a vector with size CPPAD_HASH_TABLE_SIZE
-that maps a hash code to the corresponding 
-variable index in the old operation sequence.
-All the values in this table must be less than \a current.
+maps a hash code to the
+variable indices, in the old operation sequence, with that hash code.
+All the indices in this table must be less than \a current.
 
 \param code
 The input value of code does not matter.
@@ -480,8 +523,8 @@ addr_t unary_match(
 	size_t                                             current        ,
 	size_t                                             npar           ,
 	const Base*                                        par            ,
-	const CppAD::vector<size_t>&                       hash_table_var ,
-	unsigned short&                                    code           )
+	const hash_table&                                  hash_table_var ,
+	size_t&                                            code           )
 {	const addr_t* arg = tape[current].arg;
 	OpCode        op  = tape[current].op;
 	addr_t new_arg[1];
@@ -499,13 +542,17 @@ addr_t unary_match(
 		npar                ,
 		par
 	);
-	size_t  i_var  = hash_table_var[code];
-	CPPAD_ASSERT_UNKNOWN( i_var < current );
-	if( op == tape[i_var].op )
-	{	size_t k = tape[i_var].arg[0];
-		CPPAD_ASSERT_UNKNOWN( k < i_var );
-		if (new_arg[0] == tape[k].new_var )
-			return i_var;
+	size_t  slot   = hash_table_var.find(code);
+	while( slot != hash_table_var.end() )
+	{	size_t i_var = hash_table_var.index(slot);
+		CPPAD_ASSERT_UNKNOWN( i_var < current );
+		if( op == tape[i_var].op )
+		{	size_t k = tape[i_var].arg[0];
+			CPPAD_ASSERT_UNKNOWN( k < i_var );
+			if (new_arg[0] == tape[k].new_var )
+				return i_var;
+		}
+		slot = hash_table_var.find_next(slot, code);
 	}
 	return 0;
 } 
@@ -561,10 +608,9 @@ given a parameter index \c i, the corresponding parameter value is
 <!-- end prototype -->
 
 \param hash_table_var
-is a vector with size CPPAD_HASH_TABLE_SIZE
-that maps a hash code to the corresponding 
-variable index in the old operation sequence.
-All the values in this table must be less than \a current.
+maps a hash code to the
+variable indices, in the old operation sequence, with that hash code.
+All the indices in this table must be less than \a current.
 
 \param code
 The input value of code does not matter.
@@ -589,8 +635,8 @@ inline addr_t binary_match(
 	size_t                                             current        ,
 	size_t                                             npar           ,
 	const Base*                                        par            ,
-	const CppAD::vector<size_t>&                       hash_table_var ,
-	unsigned short&                                    code           )
+	const hash_table&                                  hash_table_var ,
+	size_t&                                            code           )
 {	OpCode        op         = tape[current].op;
 	const addr_t* arg        = tape[current].arg;
 	addr_t        new_arg[2];
@@ -666,32 +712,37 @@ inline addr_t binary_match(
 		npar                ,
 		par
 	);
-	size_t  i_var  = hash_table_var[code];
-	CPPAD_ASSERT_UNKNOWN( i_var < current );
-	if( op == tape[i_var].op )
-	{	bool match = true;
-		if( op == DisOp )
-		{	match   &= new_arg[0] == tape[i_var].arg[0];
-			size_t k = tape[i_var].arg[1];
-			match   &= new_arg[1] == tape[k].new_var;
-		}
-		else
-		{	for(size_t j = 0; j < 2; j++)
-			{	size_t k = tape[i_var].arg[j];
-				if( parameter[j] )
-				{	CPPAD_ASSERT_UNKNOWN( k < npar );
-					match &= IdenticalEqualPar(
-						par[ arg[j] ], par[k]
-					);
-				}
-				else
-				{	CPPAD_ASSERT_UNKNOWN( k < i_var );
-					match &= (new_arg[j] == tape[k].new_var);
+	size_t  i_var;
+	size_t  slot   = hash_table_var.find(code);
+	while( (slot != hash_table_var.end()) & (match_var == 0) )
+	{	i_var = hash_table_var.index(slot);
+		CPPAD_ASSERT_UNKNOWN( i_var < current );
+		if( op == tape[i_var].op )
+		{	bool match = true;
+			if( op == DisOp )
+			{	match   &= new_arg[0] == tape[i_var].arg[0];
+				size_t k = tape[i_var].arg[1];
+				match   &= new_arg[1] == tape[k].new_var;
+			}
+			else
+			{	for(size_t j = 0; j < 2; j++)
+				{	size_t k = tape[i_var].arg[j];
+					if( parameter[j] )
+					{	CPPAD_ASSERT_UNKNOWN( k < npar );
+						match &= IdenticalEqualPar(
+							par[ arg[j] ], par[k]
+						);
+					}
+					else
+					{	CPPAD_ASSERT_UNKNOWN( k < i_var );
+						match &= (new_arg[j] == tape[k].new_var);
+					}
 				}
 			}
+			if( match )
+				match_var = i_var;
 		}
-		if( match )
-			match_var = i_var;
+		slot = hash_table_var.find_next(slot, code);
 	}
 	if( (match_var > 0) | ( (op != AddvvOp) & (op != MulvvOp ) ) )
 		return match_var;
@@ -699,24 +750,28 @@ inline addr_t binary_match(
 	// check for match with argument order switched ----------------------
 	CPPAD_ASSERT_UNKNOWN( op == AddvvOp || op == MulvvOp );
 	std::swap(new_arg[0], new_arg[1]);
-	unsigned short code_switch = hash_code(
+	size_t code_switch = hash_code(
 		op                  , 
 		new_arg             ,
 		npar                ,
 		par
 	);
-	i_var  = hash_table_var[code_switch];
-	CPPAD_ASSERT_UNKNOWN( i_var < current );
-	if( op == tape[i_var].op )
-	{	bool match = true;
-		size_t j;
-		for(j = 0; j < 2; j++)
-		{	size_t k = tape[i_var].arg[j];
-			CPPAD_ASSERT_UNKNOWN( k < i_var );
-			match &= (new_arg[j] == tape[k].new_var);
+	slot   = hash_table_var.find(code_switch);
+	while( (slot != hash_table_var.end()) & (match_var == 0) )
+	{	i_var = hash_table_var.index(slot);
+		CPPAD_ASSERT_UNKNOWN( i_var < current );
+		if( op == tape[i_var].op )
+		{	bool match = true;
+			size_t j;
+			for(j = 0; j < 2; j++)
+			{	size_t k = tape[i_var].arg[j];
+				CPPAD_ASSERT_UNKNOWN( k < i_var );
+				match &= (new_arg[j] == tape[k].new_var);
+			}
+			if( match )
+				match_var = i_var;
 		}
-		if( match )
-			match_var = i_var;
+		slot = hash_table_var.find_next(slot, code_switch);
 	}
 	return match_var;
 } 
@@ -1315,6 +1370,11 @@ void optimize_run(
 	// number of VecAD vectors
 	size_t num_vecad_vec   = play->num_vecad_vec_rec();
 
+# if CPPAD_OPTIMIZE_TIMING
+	// elapsed seconds at the beginning of the current phase
+	double timing_start = elapsed_seconds();
+# endif
+
 	// -------------------------------------------------------------
 	// data structure that maps variable index in original operation
 	// sequence to corresponding operator information
@@ -1955,6 +2015,9 @@ void optimize_run(
 	CPPAD_ASSERT_UNKNOWN( i_op == 0 && i_var == 0 && op == BeginOp );
 	tape[i_var].op           = op;
 	tape[i_var].connect_type = yes_connected;
+# if CPPAD_OPTIMIZE_TIMING
+	optimize_timing("reverse connection sweep", timing_start);
+# endif
 	// -------------------------------------------------------------
 
 	// Determine which variables can be conditionally skipped
@@ -2003,11 +2066,14 @@ void optimize_run(
 	size_t cskip_info_index = cskip_info.size();
 
 
-	// Initilaize table mapping hash code to variable index in tape
-	// as pointing to the BeginOp at the beginning of the tape
-	CppAD::vector<size_t>  hash_table_var(CPPAD_HASH_TABLE_SIZE);
-	for(i = 0; i < CPPAD_HASH_TABLE_SIZE; i++)
-		hash_table_var[i] = 0;
+# if CPPAD_OPTIMIZE_TIMING
+	optimize_timing("conditional skip information", timing_start);
+# endif
+
+	// Initilaize table mapping hash code to variable indices as empty
+	// (it grows as variables are added to the new operation sequence)
+	hash_table hash_table_var;
+	hash_table_var.resize( CPPAD_HASH_TABLE_SIZE );
 	CPPAD_ASSERT_UNKNOWN( tape[0].op == BeginOp );
 
 	// initialize mapping from old variable index to new 
@@ -2162,7 +2228,7 @@ void optimize_run(
 			break;
 		}
 
-		unsigned short code         = 0;
+		size_t         code         = 0;
 		bool           replace_hash = false;
 		addr_t         match_var;
 		tape[i_var].match = false;
@@ -2669,11 +2735,14 @@ void optimize_run(
 		if( replace_hash )
 		{	// The old variable index i_var corresponds to the 
 			// new variable index tape[i_var].new_var. In addition
-			// this is the most recent variable that has this code.
-			hash_table_var[code] = i_var;
+			// this variable is added to the entries with this code.
+			hash_table_var.insert(code, i_var);
 		}
 
 	}
+# if CPPAD_OPTIMIZE_TIMING
+	optimize_timing("forward recording sweep", timing_start);
+# endif
 	// modify the dependent variable vector to new indices
 	for(i = 0; i < dep_taddr.size(); i++ )
 	{	CPPAD_ASSERT_UNKNOWN( size_t(tape[dep_taddr[i]].new_var) < num_var );
@@ -2761,6 +2830,9 @@ void optimize_run(
 # endif
 		}
 	}
+# if CPPAD_OPTIMIZE_TIMING
+	optimize_timing("conditional skip arguments", timing_start);
+# endif
 }
 
 } // END_CPPAD_OPTIMIZE_NAMESPACE
@@ -2782,6 +2854,9 @@ void ADFun<Base>::optimize(void)
 {	// place to store the optimized version of the recording
 	recorder<Base> rec;
 
+	// optimize_run keeps pointers to the arguments for each variable
+	play_.compact_arg(false);
+
 	// number of independent variables
 	size_t n = ind_taddr_.size();
 
@@ -2820,6 +2895,9 @@ void ADFun<Base>::optimize(void)
 	// now replace the recording
 	play_.get(rec);
 
+	// level schedule corresponds to the previous operation sequence
+	par_sweep_.clear();
+
 	// set flag so this function knows it has been optimized
 	has_been_optimized_ = true;
 
@@ -0,0 +1,1392 @@
+/* $Id$ */
+# ifndef CPPAD_PARALLEL_SWEEP_INCLUDED
+# define CPPAD_PARALLEL_SWEEP_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file parallel_sweep.hpp
+Level (wavefront) scheduling of an operation sequence so that
+sweeps can be split among a team of threads.
+*/
+
+/*!
+Level schedule for an operation sequence and the corresponding
+parallel zero order forward and first order reverse sweeps.
+
+The level of an operator that has no variable arguments is zero.
+Otherwise it is one plus the maximum level of the operators that
+created its variable arguments.
+Operators with the same level do not depend on each other and hence
+can be computed in any order (or at the same time).
+The schedule is the operators sorted by level, and by operator index
+within each level.
+It is partitioned into blocks; a block is either one level that has
+at least min_block operators (executed in parallel) or a sequence of
+consecutive levels that are each smaller (executed by the master thread).
+Each operator computes exactly the same floating point operations
+as during a sequential sweep, so the results are identical.
+
+\tparam Base
+The type used during the forward mode computations; i.e., the corresponding
+recording of operations used the type AD<Base>.
+*/
+template <class Base>
+class parallel_sweep {
+public:
+	/// type of the function that has a team of threads each call worker
+	/// (see team_work in the team_thread.hpp specifications)
+	typedef bool (*team_work_t)(void worker(void));
+
+	/// type of the function that each thread calls for a job
+	/// defined by the function object (see team_call)
+	typedef void (*fun_job_t)(size_t thread, void* info);
+private:
+	/// function used to run the team of threads (null for sequential)
+	team_work_t team_work_;
+
+	/// minimum number of operators in a level that is run in parallel
+	size_t min_block_;
+
+	/// has the schedule been computed for the current operation sequence
+	bool setup_done_;
+
+	/// are all the operators in the current operation sequence supported
+	bool supported_;
+
+	/// does the current operation sequence have conditional skip operators
+	bool has_cskip_;
+
+	/// operator index for each operator in the schedule
+	pod_vector<size_t> sched_op_;
+
+	/// index in the operator argument vector for each operator in schedule
+	pod_vector<size_t> sched_arg_;
+
+	/// primary result variable index for each operator in the schedule
+	pod_vector<size_t> sched_var_;
+
+	/// index in the schedule where each block starts
+	/// (last element is the size of the schedule)
+	pod_vector<size_t> block_start_;
+
+	/// is the corresponding block executed in parallel
+	pod_vector<bool> block_parallel_;
+
+	/// operator index for each comparison operator (in tape order)
+	pod_vector<size_t> compare_op_;
+
+	/// index in the operator argument vector for each comparison operator
+	pod_vector<size_t> compare_arg_;
+
+	/// partial derivatives for threads 1, ..., n_thread-1 during
+	/// first order reverse mode (thread zero uses the caller's partial)
+	pod_vector<Base> partial_;
+
+	/// copy of the function object for each thread
+	/// (null if it has not yet been created by the thread)
+	CppAD::vector< ADFun<Base>* > team_fun_;
+
+	/// the different kinds of parallel jobs
+	enum job_kind_t {
+		forward0_job,
+		forward0_batch_job,
+		reverse1_job,
+		zero_partial_job,
+		for_jac_job,
+		fun_job
+	};
+
+	/// information for the current parallel job
+	/// (set by the master thread before calling team_work_)
+	struct {
+		/// kind of job
+		job_kind_t          kind;
+		/// player for the operation sequence
+		const player<Base>* play;
+		/// first index in the schedule for this job
+		size_t              start;
+		/// one past last index in the schedule for this job
+		size_t              end;
+		/// number of columns in the taylor coefficient matrix
+		size_t              J;
+		/// the taylor coefficient matrix
+		Base*               taylor;
+		/// number of threads that have separate partial derivatives
+		size_t              n_thread;
+		/// partial derivatives for thread zero
+		Base*               partial;
+		/// number of points for a batch job
+		size_t              n_point;
+		/// number of independent variables
+		size_t              n;
+		/// sparsity pattern for all the variables
+		sparse_pack*        var_sparsity;
+		/// function called by each thread for a function object job
+		fun_job_t           fun;
+		/// information passed to fun
+		void*               fun_info;
+	} job_;
+
+	/// pointer to the object for the current parallel job
+	static parallel_sweep*& job_object(void)
+	{	static parallel_sweep* object = CPPAD_NULL;
+		return object;
+	}
+	/// function called by each thread in the team
+	static void worker(void)
+	{	parallel_sweep* object = job_object();
+		size_t thread   = thread_alloc::thread_num();
+		size_t n_thread = thread_alloc::num_threads();
+		size_t start    = object->job_.start;
+		size_t length   = object->job_.end - start;
+		size_t begin    = start + (length * thread) / n_thread;
+		size_t end      = start + (length * (thread + 1) ) / n_thread;
+		switch( object->job_.kind )
+		{	case forward0_job:
+			object->forward0_range(begin, end, 0, 1);
+			break;
+
+			case forward0_batch_job:
+			// split the points (instead of the schedule) among the threads
+			begin = (object->job_.n_point * thread) / n_thread;
+			end   = (object->job_.n_point * (thread + 1) ) / n_thread;
+			object->forward0_range(start, start + length, begin, end);
+			break;
+
+			case reverse1_job:
+			object->reverse1_range(begin, end, thread);
+			break;
+
+			case zero_partial_job:
+			object->zero_partial(thread);
+			break;
+
+			case for_jac_job:
+			object->for_jac_columns(thread, n_thread);
+			break;
+
+			case fun_job:
+			object->job_.fun(thread, object->job_.fun_info);
+			break;
+		}
+	}
+	/// run the current job; i.e., job_, using the team of threads
+	void team_run(void)
+	{	job_object() = this;
+		bool ok = team_work_(worker);
+		job_object() = CPPAD_NULL;
+		CPPAD_ASSERT_KNOWN(
+			ok,
+			"ADFun parallel mode: team_work returned false"
+		);
+	}
+	/// partial derivatives corresponding to a thread
+	Base* thread_partial(size_t thread)
+	{	if( thread == 0 )
+			return job_.partial;
+		size_t num_var = job_.play->num_var_rec();
+		return partial_.data() + (thread - 1) * num_var;
+	}
+	/// set the partial derivatives for a thread to zero
+	/// (done by that thread so its memory is touched by that thread first)
+	void zero_partial(size_t thread)
+	{	if( thread == 0 )
+			return;
+		size_t num_var = job_.play->num_var_rec();
+		Base*  partial = thread_partial(thread);
+		for(size_t i = 0; i < num_var; i++)
+			partial[i] = Base(0);
+	}
+	/*!
+	Forward Jacobian sparsity for the block of columns assigned to a thread.
+
+	The columns are split into blocks that start at a multiple of
+	sparse_pack::n_bit(), so different threads store to different
+	\c Pack values in job_.var_sparsity.
+	The thread plays back its own copy of the operation sequence
+	(the playback changes the player state)
+	and uses its own sparsity pattern for its block of columns.
+
+	\param thread
+	is the thread that is computing this block of columns.
+
+	\param n_thread
+	is the number of threads in the team.
+	*/
+	void for_jac_columns(size_t thread, size_t n_thread)
+	{	sparse_pack& var_sparsity = *job_.var_sparsity;
+		size_t num_var = var_sparsity.n_set();
+		size_t q       = var_sparsity.end();
+		size_t n_bit   = sparse_pack::n_bit();
+		size_t n_word  = (q + n_bit - 1) / n_bit;
+		size_t begin   = ( (n_word * thread) / n_thread ) * n_bit;
+		size_t end     = ( (n_word * (thread + 1)) / n_thread ) * n_bit;
+		if( end > q )
+			end = q;
+		if( begin >= end )
+			return;
+		size_t count = end - begin;
+
+		player<Base> play;
+		play = *job_.play;
+
+		// independent variables (their index is equal to their operator index)
+		sparse_pack block;
+		block.resize(num_var, count);
+		size_t i;
+		for(i = 1; i <= job_.n; i++)
+			block.block_assignment(i, 0, i, begin, count, var_sparsity);
+
+		ForJacSweep(job_.n, num_var, &play, block);
+
+		for(i = 0; i < num_var; i++)
+			var_sparsity.block_assignment(i, begin, i, 0, count, block);
+	}
+	/*!
+	Zero order forward mode for a contiguous subset of the schedule.
+
+	\param start
+	is the first index in the schedule that is computed.
+
+	\param end
+	is one past the last index in the schedule that is computed.
+
+	\param point_begin
+	is the first point that is computed.
+
+	\param point_end
+	is one past the last point that is computed.
+	The Taylor coefficient for variable i_var and point p is
+	<code>taylor[ i_var * J + p ]</code>.
+	For a single point, point_begin is zero, point_end is one,
+	and J is the capacity for orders in the Taylor coefficient matrix.
+	*/
+	void forward0_range(
+		size_t start, size_t end, size_t point_begin, size_t point_end)
+	{	const player<Base>* play = job_.play;
+		size_t J                 = job_.J;
+		Base*  taylor            = job_.taylor;
+		const addr_t* arg_0      = play->GetArg();
+		size_t num_par           = play->num_par_rec();
+		const Base* parameter    = CPPAD_NULL;
+		if( num_par > 0 )
+			parameter = play->GetPar();
+		size_t p;
+		for(size_t i = start; i < end; i++)
+		{	size_t i_var      = sched_var_[i];
+			const addr_t* arg = arg_0 + sched_arg_[i];
+			switch( play->GetOp( sched_op_[i] ) )
+			{
+				case AbsOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_abs_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case AcosOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_acos_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case AddpvOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_addpv_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case AddvvOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_addvv_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case AsinOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_asin_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case AtanOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_atan_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case CExpOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_cond_op_0(
+						i_var, arg, num_par, parameter, J, taylor + p
+					);
+				break;
+
+				case CosOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_cos_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case CoshOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_cosh_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case CSumOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_csum_op(
+						0, 0, i_var, arg, num_par, parameter, J, taylor + p
+					);
+				break;
+
+				case DivpvOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_divpv_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case DivvpOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_divvp_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case DivvvOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_divvv_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+# if CPPAD_COMPILER_HAS_ERF
+				case ErfOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_erf_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+# endif
+
+				case ExpOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_exp_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case LogOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_log_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case MulpvOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_mulpv_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case MulvvOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_mulvv_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case ParOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_par_op_0(
+						i_var, arg, num_par, parameter, J, taylor + p
+					);
+				break;
+
+				case PowpvOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_powpv_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case PowvpOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_powvp_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case PowvvOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_powvv_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case SignOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_sign_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case SinOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_sin_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case SinhOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_sinh_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case SqrtOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_sqrt_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case SubpvOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_subpv_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case SubvpOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_subvp_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case SubvvOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_subvv_op_0(i_var, arg, parameter, J, taylor + p);
+				break;
+
+				case TanOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_tan_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				case TanhOp:
+				for(p = point_begin; p < point_end; p++)
+					forward_tanh_op_0(i_var, arg[0], J, taylor + p);
+				break;
+
+				default:
+				CPPAD_ASSERT_UNKNOWN(false);
+			}
+		}
+	}
+	/*!
+	First order reverse mode for a contiguous subset of the schedule.
+
+	\param start
+	is the first index in the schedule that is computed.
+
+	\param end
+	is one past the last index in the schedule that is computed.
+	The operators are processed in the order end-1, ... , start.
+
+	\param thread
+	is the thread that is doing this computation.
+	The partials of the results for each operator are first summed over the
+	threads (in thread order) and stored in this thread's partials.
+	The operator then adds its contribution to this thread's partials
+	for its arguments.
+	*/
+	void reverse1_range(size_t start, size_t end, size_t thread)
+	{	const player<Base>* play = job_.play;
+		size_t J                 = job_.J;
+		const Base* taylor       = job_.taylor;
+		size_t n_thread          = job_.n_thread;
+		Base* partial            = thread_partial(thread);
+		const addr_t* arg_0      = play->GetArg();
+		size_t num_par           = play->num_par_rec();
+		const Base* parameter    = CPPAD_NULL;
+		if( num_par > 0 )
+			parameter = play->GetPar();
+		size_t i = end;
+		while( i > start )
+		{	--i;
+			size_t i_var      = sched_var_[i];
+			const addr_t* arg = arg_0 + sched_arg_[i];
+			OpCode op         = play->GetOp( sched_op_[i] );
+
+			// sum partials for the results of this operator
+			for(size_t k = 0; k < NumRes(op); k++)
+			{	size_t i_res = i_var - k;
+				Base sum     = thread_partial(0)[i_res];
+				for(size_t t = 1; t < n_thread; t++)
+					sum += thread_partial(t)[i_res];
+				partial[i_res] = sum;
+			}
+			switch( op )
+			{
+				case AbsOp:
+				reverse_abs_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case AcosOp:
+				reverse_acos_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case AddpvOp:
+				reverse_addpv_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case AddvvOp:
+				reverse_addvv_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case AsinOp:
+				reverse_asin_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case AtanOp:
+				reverse_atan_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case CExpOp:
+				reverse_cond_op(
+					0, i_var, arg, num_par, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case CosOp:
+				reverse_cos_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case CoshOp:
+				reverse_cosh_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case CSumOp:
+				reverse_csum_op(
+					0, i_var, arg, 1, partial
+				);
+				break;
+
+				case DivpvOp:
+				reverse_divpv_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case DivvpOp:
+				reverse_divvp_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case DivvvOp:
+				reverse_divvv_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+# if CPPAD_COMPILER_HAS_ERF
+				case ErfOp:
+				reverse_erf_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+# endif
+
+				case ExpOp:
+				reverse_exp_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case LogOp:
+				reverse_log_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case MulpvOp:
+				reverse_mulpv_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case MulvvOp:
+				reverse_mulvv_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case ParOp:
+				break;
+
+				case PowpvOp:
+				reverse_powpv_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case PowvpOp:
+				reverse_powvp_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case PowvvOp:
+				reverse_powvv_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case SignOp:
+				reverse_sign_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case SinOp:
+				reverse_sin_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case SinhOp:
+				reverse_sinh_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case SqrtOp:
+				reverse_sqrt_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case SubpvOp:
+				reverse_subpv_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case SubvpOp:
+				reverse_subvp_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case SubvvOp:
+				reverse_subvv_op(
+					0, i_var, arg, parameter, J, taylor, 1, partial
+				);
+				break;
+
+				case TanOp:
+				reverse_tan_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				case TanhOp:
+				reverse_tanh_op(
+					0, i_var, arg[0], J, taylor, 1, partial
+				);
+				break;
+
+				default:
+				CPPAD_ASSERT_UNKNOWN(false);
+			}
+		}
+	}
+public:
+	/// default constructor (sequential mode)
+	parallel_sweep(void)
+	: team_work_(CPPAD_NULL), min_block_(0),
+	  setup_done_(false), supported_(false), has_cskip_(false)
+	{ }
+
+	/// destructor (frees the function object copies)
+	~parallel_sweep(void)
+	{	clear(); }
+
+	/// assignment copies the settings, but not the schedule
+	void operator=(const parallel_sweep& other)
+	{	team_work_ = other.team_work_;
+		min_block_ = other.min_block_;
+		clear();
+	}
+
+	/*!
+	Change the parallel mode settings.
+
+	\param team_work
+	is the function that has each thread in the team call a worker,
+	or CPPAD_NULL for sequential mode.
+
+	\param min_block
+	is the minimum number of operators in a level that is computed
+	in parallel.
+	*/
+	void set(team_work_t team_work, size_t min_block)
+	{	team_work_ = team_work;
+		min_block_ = min_block;
+		if( min_block_ == 0 )
+			min_block_ = 1;
+	}
+
+	/// is the parallel mode on
+	bool active(void) const
+	{	return team_work_ != CPPAD_NULL; }
+
+	/// minimum number of operators in a level that is run in parallel
+	size_t min_block(void) const
+	{	return min_block_; }
+
+	/// number of blocks in the schedule (zero if not supported)
+	size_t num_block(void) const
+	{	if( block_start_.size() == 0 )
+			return 0;
+		return block_start_.size() - 1;
+	}
+
+	/// number of blocks in the schedule that are executed in parallel
+	size_t num_parallel_block(void) const
+	{	size_t count = 0;
+		for(size_t b = 0; b < block_parallel_.size(); b++)
+			count += size_t( block_parallel_[b] );
+		return count;
+	}
+
+	/// the operation sequence has changed, free the schedule
+	void clear(void)
+	{	setup_done_ = false;
+		supported_  = false;
+		has_cskip_  = false;
+		sched_op_.free();
+		sched_arg_.free();
+		sched_var_.free();
+		block_start_.free();
+		block_parallel_.free();
+		compare_op_.free();
+		compare_arg_.free();
+		partial_.free();
+		for(size_t thread = 0; thread < team_fun_.size(); thread++)
+		{	if( team_fun_[thread] != CPPAD_NULL )
+				delete team_fun_[thread];
+		}
+		team_fun_.clear();
+	}
+
+	/*!
+	Compute the level schedule for an operation sequence
+	(if it has not already been computed).
+
+	\param play
+	is the operation sequence.
+	The current playback location in play is changed.
+
+	\return
+	is true if all the operators in play are supported by
+	the parallel sweeps.
+	The operation sequence is not supported if it contains
+	VecAD, user atomic, discrete function, or print operators,
+	or if its arguments are in compact form (see player::compact_arg).
+	Conditional skip operators are recorded in has_cskip_
+	(forward0 does not use the schedule when it is true).
+	*/
+	bool setup(player<Base>* play)
+	{	if( setup_done_ )
+			return supported_;
+		clear();
+		setup_done_ = true;
+		if( play->num_vec_ind_rec() > 0 || play->compact_arg() )
+			return supported_;
+
+		size_t num_var      = play->num_var_rec();
+		const addr_t* arg_0 = play->GetArg();
+
+		// level for each variable and for each operator with a result
+		pod_vector<size_t> var_level;
+		var_level.extend(num_var);
+		size_t num_op = play->num_op_rec();
+		pod_vector<size_t> op_level, op_index, op_arg, op_var;
+		op_level.extend(num_op);
+		op_index.extend(num_op);
+		op_arg.extend(num_op);
+		op_var.extend(num_op);
+		size_t num_sched = 0;
+
+		OpCode        op;
+		const addr_t* arg;
+		size_t        i_op;
+		size_t        i_var;
+		size_t        k, level, max_level = 0;
+		play->forward_start(op, arg, i_op, i_var);
+		CPPAD_ASSERT_UNKNOWN( op == BeginOp );
+		bool more_operators = true;
+		while(more_operators)
+		{	play->forward_next(op, arg, i_op, i_var);
+			const addr_t* arg_op = arg;
+			bool          result = true;
+			level                = 0;
+			switch( op )
+			{
+				case AbsOp:
+				case AcosOp:
+				case AsinOp:
+				case AtanOp:
+				case CosOp:
+				case CoshOp:
+				case ExpOp:
+				case LogOp:
+				case SignOp:
+				case SinOp:
+				case SinhOp:
+				case SqrtOp:
+				case TanOp:
+				case TanhOp:
+				case DivvpOp:
+				case PowvpOp:
+				case SubvpOp:
+# if CPPAD_COMPILER_HAS_ERF
+				case ErfOp:
+# endif
+				level = var_level[ arg[0] ] + 1;
+				break;
+
+				case AddpvOp:
+				case DivpvOp:
+				case MulpvOp:
+				case PowpvOp:
+				case SubpvOp:
+				level = var_level[ arg[1] ] + 1;
+				break;
+
+				case AddvvOp:
+				case DivvvOp:
+				case MulvvOp:
+				case PowvvOp:
+				case SubvvOp:
+				level = std::max(var_level[arg[0]], var_level[arg[1]]) + 1;
+				break;
+
+				case CExpOp:
+				for(k = 0; k < 4; k++)
+				{	if( arg[1] & (1 << k) )
+						level = std::max(level, var_level[arg[2+k]] + 1);
+				}
+				break;
+
+				case CSumOp:
+				for(k = 0; k < size_t(arg[0] + arg[1]); k++)
+					level = std::max(level, var_level[arg[3+k]] + 1);
+				// CSumOp has a variable number of arguments
+				play->forward_csum(op, arg, i_op, i_var);
+				break;
+
+				case ParOp:
+				break;
+
+				case InvOp:
+				// independent variable values are inputs
+				result = false;
+				var_level[i_var] = 0;
+				break;
+
+				case EqpvOp:
+				case EqvvOp:
+				case LepvOp:
+				case LevpOp:
+				case LevvOp:
+				case LtpvOp:
+				case LtvpOp:
+				case LtvvOp:
+				case NepvOp:
+				case NevvOp:
+				result = false;
+				compare_op_[ compare_op_.extend(1) ] = i_op;
+				compare_arg_[ compare_arg_.extend(1) ] =
+					size_t(arg_op - arg_0);
+				break;
+
+				case CSkipOp:
+				// forward0 uses forward0sweep for this operation sequence
+				result     = false;
+				has_cskip_ = true;
+				// CSkipOp has a variable number of arguments
+				play->forward_cskip(op, arg, i_op, i_var);
+				break;
+
+				case EndOp:
+				result         = false;
+				more_operators = false;
+				break;
+
+				default:
+				// this operator is not supported
+				clear();
+				setup_done_ = true;
+				return supported_;
+			}
+			if( result )
+			{	for(k = 0; k < NumRes(op); k++)
+					var_level[i_var - k] = level;
+				op_level[num_sched] = level;
+				op_index[num_sched] = i_op;
+				op_arg[num_sched]   = size_t(arg_op - arg_0);
+				op_var[num_sched]   = i_var;
+				num_sched++;
+				max_level = std::max(max_level, level);
+			}
+		}
+
+		// count the number of operators at each level
+		pod_vector<size_t> level_start;
+		level_start.extend(max_level + 2);
+		for(level = 0; level < max_level + 2; level++)
+			level_start[level] = 0;
+		for(k = 0; k < num_sched; k++)
+			level_start[ op_level[k] + 1 ]++;
+		for(level = 1; level < max_level + 2; level++)
+			level_start[level] += level_start[level - 1];
+
+		// sort by level (stable so sorted by operator index within level)
+		sched_op_.extend(num_sched);
+		sched_arg_.extend(num_sched);
+		sched_var_.extend(num_sched);
+		pod_vector<size_t> next;
+		next.extend(max_level + 1);
+		for(level = 0; level <= max_level; level++)
+			next[level] = level_start[level];
+		for(k = 0; k < num_sched; k++)
+		{	size_t i = next[ op_level[k] ]++;
+			sched_op_[i]  = op_index[k];
+			sched_arg_[i] = op_arg[k];
+			sched_var_[i] = op_var[k];
+		}
+
+		// partition into blocks
+		bool in_sequential = false;
+		for(level = 0; level <= max_level; level++)
+		{	size_t count = level_start[level+1] - level_start[level];
+			bool parallel = count >= min_block_;
+			if( parallel || ! in_sequential )
+			{	size_t b           = block_start_.extend(1);
+				block_start_[b]    = level_start[level];
+				block_parallel_.extend(1);
+				block_parallel_[b] = parallel;
+			}
+			in_sequential = ! parallel;
+		}
+		block_start_[ block_start_.extend(1) ] = num_sched;
+
+		supported_ = true;
+		return supported_;
+	}
+
+	/*!
+	Zero order forward mode using the level schedule.
+
+	\param play
+	is the operation sequence.
+	The current playback location in play is changed.
+
+	\param J
+	is the number of columns in the coefficient matrix taylor.
+
+	\param taylor
+	has the same meaning as in forward0sweep.
+
+	\param cskip_op
+	has the same meaning as in forward0sweep
+	(all its elements are set to false).
+	It is not changed if false is returned.
+
+	\param compare_change_count
+	has the same meaning as in forward0sweep.
+
+	\param compare_change_number
+	has the same meaning as in forward0sweep.
+
+	\param compare_change_op_index
+	has the same meaning as in forward0sweep.
+
+	\return
+	is false (and nothing is computed) if play contains operators that
+	are not supported (see setup),
+	or conditional skip operators.
+	In this case forward0sweep should be used
+	(so that the skipped operators, and the comparison operators
+	that are checked, are the same as for a sequential sweep).
+	*/
+	bool forward0(
+		player<Base>*         play,
+		size_t                J,
+		Base*                 taylor,
+		bool*                 cskip_op,
+		size_t                compare_change_count,
+		size_t&               compare_change_number,
+		size_t&               compare_change_op_index
+	)
+	{	if( ! setup(play) )
+			return false;
+		if( has_cskip_ )
+			return false;
+
+		// all of the operators are computed
+		size_t i, num_op = play->num_op_rec();
+		for(i = 0; i < num_op; i++)
+			cskip_op[i] = false;
+
+		job_.kind   = forward0_job;
+		job_.play   = play;
+		job_.J      = J;
+		job_.taylor = taylor;
+		bool use_team = active()
+			&& thread_alloc::num_threads() > 1
+			&& ! thread_alloc::in_parallel();
+		for(size_t b = 0; b + 1 < block_start_.size(); b++)
+		{	job_.start = block_start_[b];
+			job_.end   = block_start_[b+1];
+			if( use_team & block_parallel_[b] )
+				team_run();
+			else	forward0_range(job_.start, job_.end, 0, 1);
+		}
+
+		// comparison operators are checked in the order they were recorded
+		compare_change_number   = 0;
+		compare_change_op_index = 0;
+		if( compare_change_count == 0 )
+			return true;
+		const addr_t* arg_0   = play->GetArg();
+		const Base* parameter = CPPAD_NULL;
+		if( play->num_par_rec() > 0 )
+			parameter = play->GetPar();
+		for(i = 0; i < compare_op_.size(); i++)
+		{	size_t i_op       = compare_op_[i];
+			const addr_t* arg = arg_0 + compare_arg_[i];
+			switch( play->GetOp(i_op) )
+			{
+				case EqpvOp:
+				forward_eqpv_op_0(
+					compare_change_number, arg, parameter, J, taylor
+				);
+				break;
+
+				case EqvvOp:
+				forward_eqvv_op_0(
+					compare_change_number, arg, parameter, J, taylor
+				);
+				break;
+
+				case LepvOp:
+				forward_lepv_op_0(
+					compare_change_number, arg, parameter, J, taylor
+				);
+				break;
+
+				case LevpOp:
+				forward_levp_op_0(
+					compare_change_number, arg, parameter, J, taylor
+				);
+				break;
+
+				case LevvOp:
+				forward_levv_op_0(
+					compare_change_number, arg, parameter, J, taylor
+				);
+				break;
+
+				case LtpvOp:
+				forward_ltpv_op_0(
+					compare_change_number, arg, parameter, J, taylor
+				);
+				break;
+
+				case LtvpOp:
+				forward_ltvp_op_0(
+					compare_change_number, arg, parameter, J, taylor
+				);
+				break;
+
+				case LtvvOp:
+				forward_ltvv_op_0(
+					compare_change_number, arg, parameter, J, taylor
+				);
+				break;
+
+				case NepvOp:
+				forward_nepv_op_0(
+					compare_change_number, arg, parameter, J, taylor
+				);
+				break;
+
+				case NevvOp:
+				forward_nevv_op_0(
+					compare_change_number, arg, parameter, J, taylor
+				);
+				break;
+
+				default:
+				CPPAD_ASSERT_UNKNOWN(false);
+			}
+			if( compare_change_count == compare_change_number )
+				compare_change_op_index = i_op;
+		}
+		return true;
+	}
+	/*!
+	Zero order forward mode for a batch of points.
+
+	\param play
+	is the operation sequence.
+	The current playback location in play is changed.
+
+	\param n_point
+	is the number of points.
+
+	\param taylor
+	is a vector of length <code>play->num_var_rec() * n_point</code>.
+	The value of the variable with index i_var at point p is
+	<code>taylor[ i_var * n_point + p ]</code>.
+	On input, the values for the independent variables are specified.
+	On output, the values for all the variables have been computed.
+
+	\return
+	is false (and nothing is computed) if play contains operators that
+	are not supported; see setup.
+
+	\par Parallel Mode
+	If the parallel mode is on,
+	the points are split among the team of threads.
+	The operators are computed in the order of the schedule,
+	and each operator is computed for all the points assigned to a thread,
+	so the operator switch is only evaluated once per operator and thread.
+	Comparison operators are not checked.
+	*/
+	bool forward0_batch(player<Base>* play, size_t n_point, Base* taylor)
+	{	if( ! setup(play) )
+			return false;
+
+		job_.kind    = forward0_batch_job;
+		job_.play    = play;
+		job_.J       = n_point;
+		job_.taylor  = taylor;
+		job_.n_point = n_point;
+		job_.start   = 0;
+		job_.end     = sched_op_.size();
+		bool use_team = active()
+			&& thread_alloc::num_threads() > 1
+			&& ! thread_alloc::in_parallel()
+			&& n_point > 1;
+		if( use_team )
+			team_run();
+		else	forward0_range(job_.start, job_.end, 0, n_point);
+		return true;
+	}
+	/*!
+	First order reverse mode using the level schedule.
+
+	\param play
+	is the operation sequence.
+	The current playback location in play is changed.
+
+	\param n
+	is the number of independent variables.
+
+	\param J
+	is the number of columns in the coefficient matrix taylor.
+
+	\param taylor
+	contains the zero order Taylor coefficients for all the variables
+	(it is not modified).
+
+	\param cskip_op
+	is the vector of conditional skip flags set by the previous
+	zero order forward sweep.
+	If one of these flags is true, some of the zero order
+	Taylor coefficients were not computed and nothing is done.
+
+	\param partial
+	\b Input:
+	is a vector with length play->num_var_rec().
+	The value for each dependent variable is the corresponding weight
+	and all the other values are zero.
+	\n
+	\b Output:
+	for i = 1, ..., n, partial[i] is the partial derivative
+	of the weighted sum of the dependent variables with respect to the
+	independent variable with index i.
+	The other values are not specified.
+
+	\return
+	is false (and nothing is computed) if play contains operators that
+	are not supported (see setup),
+	or one of the conditional skip flags is true.
+	In this case reverse_sweep should be used.
+
+	\par Thread Partials
+	Each thread has a separate vector of partial derivatives and
+	the results are summed in thread order.
+	The results are the same each time the function is evaluated
+	with the same number of threads, but may differ in the last bits
+	from reverse_sweep (because the partials are summed in a different order).
+	*/
+	bool reverse1(
+		player<Base>*         play,
+		size_t                n,
+		size_t                J,
+		Base*                 taylor,
+		const bool*           cskip_op,
+		Base*                 partial
+	)
+	{	if( ! setup(play) )
+			return false;
+		if( has_cskip_ )
+		{	size_t num_op = play->num_op_rec();
+			for(size_t i = 0; i < num_op; i++)
+			{	if( cskip_op[i] )
+					return false;
+			}
+		}
+
+		size_t num_var = play->num_var_rec();
+		bool use_team = active()
+			&& thread_alloc::num_threads() > 1
+			&& ! thread_alloc::in_parallel();
+		size_t n_thread = 1;
+		if( use_team )
+			n_thread = thread_alloc::num_threads();
+
+		job_.play     = play;
+		job_.J        = J;
+		job_.taylor   = taylor;
+		job_.n_thread = n_thread;
+		job_.partial  = partial;
+		if( n_thread > 1 )
+		{	// partials for the other threads
+			size_t length = (n_thread - 1) * num_var;
+			if( partial_.size() < length )
+				partial_.extend( length - partial_.size() );
+			job_.kind = zero_partial_job;
+			team_run();
+		}
+		job_.kind = reverse1_job;
+		size_t b  = block_start_.size() - 1;
+		while( b > 0 )
+		{	--b;
+			job_.start = block_start_[b];
+			job_.end   = block_start_[b+1];
+			if( use_team & block_parallel_[b] )
+				team_run();
+			else	reverse1_range(job_.start, job_.end, 0);
+		}
+
+		// independent variables (their index is equal to their operator index)
+		for(size_t i = 1; i <= n; i++)
+		{	for(size_t t = 1; t < n_thread; t++)
+				partial[i] += thread_partial(t)[i];
+		}
+		return true;
+	}
+	/*!
+	Copy of the function object for one thread.
+
+	\param thread
+	is the thread number.
+	This routine may only be called by this thread during a job
+	started by team_call.
+
+	\return
+	is a reference to the pointer to this thread's copy of the
+	function object (CppAD::NULL if the thread has not yet created
+	the copy).
+	The memory for the copy is freed by clear; i.e., when the
+	operation sequence changes, or this object is deleted.
+	*/
+	ADFun<Base>*& team_fun(size_t thread)
+	{	CPPAD_ASSERT_UNKNOWN( thread < team_fun_.size() );
+		return team_fun_[thread];
+	}
+	/*!
+	Have each thread in the team call a function.
+
+	\param fun
+	is the function that each thread calls using the syntax
+	<code>fun(thread, info)</code>
+	where \c thread is the thread number.
+
+	\param info
+	is passed to each call to \c fun.
+
+	\par Restrictions
+	The parallel mode must be on, there must be more than one thread,
+	and execution must be sequential.
+	*/
+	void team_call(fun_job_t fun, void* info)
+	{	CPPAD_ASSERT_UNKNOWN( active() );
+		CPPAD_ASSERT_UNKNOWN( ! thread_alloc::in_parallel() );
+		size_t n_thread = thread_alloc::num_threads();
+		if( team_fun_.size() != n_thread )
+		{	// the number of threads has changed
+			for(size_t thread = 0; thread < team_fun_.size(); thread++)
+			{	if( team_fun_[thread] != CPPAD_NULL )
+					delete team_fun_[thread];
+			}
+			team_fun_.resize(n_thread);
+			for(size_t thread = 0; thread < n_thread; thread++)
+				team_fun_[thread] = CPPAD_NULL;
+		}
+		job_.kind     = fun_job;
+		job_.fun      = fun;
+		job_.fun_info = info;
+		team_run();
+	}
+	/*!
+	Forward mode Jacobian sparsity with the columns split among the team.
+
+	\param play
+	is the operation sequence (its playback state is not changed).
+
+	\param n
+	is the number of independent variables.
+
+	\param var_sparsity
+	\b Input:
+	The sets corresponding to the independent variables are the
+	sparsity pattern for the seed matrix R
+	and the other sets are empty.
+	\n
+	\b Output:
+	the sparsity pattern for all of the variables; i.e.,
+	the same result as ForJacSweep.
+
+	\return
+	is false (and nothing is computed) if the parallel mode is off,
+	there is only one thread, execution is currently parallel,
+	there are not enough columns for more than one block,
+	or play contains user atomic operations.
+	In this case ForJacSweep should be used.
+	*/
+	bool for_jac(
+		const player<Base>*   play         ,
+		size_t                n            ,
+		sparse_pack&          var_sparsity )
+	{	bool use_team = active()
+			&& thread_alloc::num_threads() > 1
+			&& ! thread_alloc::in_parallel()
+			&& var_sparsity.end() > sparse_pack::n_bit();
+		if( ! use_team )
+			return false;
+
+		// user atomic functions may not support calls by different threads
+		size_t num_op = play->num_op_rec();
+		for(size_t i = 0; i < num_op; i++)
+		{	if( play->GetOp(i) == UserOp )
+				return false;
+		}
+
+		job_.kind         = for_jac_job;
+		job_.play         = play;
+		job_.n            = n;
+		job_.var_sparsity = &var_sparsity;
+		team_run();
+		return true;
+	}
+};
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -3,7 +3,7 @@
 # define CPPAD_PLAYER_INCLUDED
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -57,6 +57,18 @@ private:
 	/// Character strings ('\\0' terminated) in the recording.
 	pod_vector<char> text_rec_;
 
+	/// Is op_arg_rec_ stored in compact form (see compact_arg).
+	bool      compact_arg_;
+
+	/// Number of elements in op_arg_rec_ (when compact_arg_ is true).
+	size_t    num_op_arg_compact_;
+
+	/// Maximum number of arguments for one operator (when compact_arg_).
+	size_t    max_op_arg_compact_;
+
+	/// The operation argument indices in compact form (when compact_arg_).
+	pod_vector<unsigned char> op_arg_compact_;
+
 
 // --------------- Functions used to create and maniplate a recording -------
 public:
@@ -68,8 +80,18 @@ public:
 	vecad_ind_rec_( std::numeric_limits<addr_t>::max() ) ,
 	op_arg_rec_( std::numeric_limits<addr_t>::max() )    ,
 	par_rec_( std::numeric_limits<addr_t>::max() )       ,
-	text_rec_( std::numeric_limits<addr_t>::max() )
-	{ }
+	text_rec_( std::numeric_limits<addr_t>::max() )      ,
+	compact_arg_(false)                                  ,
+	num_op_arg_compact_(0)                               ,
+	max_op_arg_compact_(0)                               ,
+	arg_pos_(0)
+	{	op_rec_.set_tag(thread_alloc::recorder_tag);
+		vecad_ind_rec_.set_tag(thread_alloc::recorder_tag);
+		op_arg_rec_.set_tag(thread_alloc::recorder_tag);
+		par_rec_.set_tag(thread_alloc::recorder_tag);
+		text_rec_.set_tag(thread_alloc::recorder_tag);
+		op_arg_compact_.set_tag(thread_alloc::recorder_tag);
+	}
 
 	/// Destructor
 	~player(void)
@@ -81,9 +103,10 @@ public:
  
 	\param rec
 	the object that was used to record the operation sequence.  After this 
-	operation, the state of the recording is no longer defined. For example,
-	the \c pod_vector member variables in \c this have been swapped with
-	\c rec .
+	operation, the recording is empty. The \c pod_arena member variables
+	in \c rec are flattened into the corresponding \c pod_vector
+	member variables in \c this (without copying when a \c pod_arena
+	has only one segment).
  	*/
 	void get(recorder<Base>& rec)
 	{	size_t i;
@@ -93,19 +116,25 @@ public:
 		num_load_op_rec_    = rec.num_load_op_rec_; 
 
 		// op_rec_
-		op_rec_.swap(rec.op_rec_);
+		rec.op_rec_.flatten(op_rec_);
 
 		// vec_ind_rec_
-		vecad_ind_rec_.swap(rec.vecad_ind_rec_);
+		rec.vecad_ind_rec_.flatten(vecad_ind_rec_);
 
 		// op_arg_rec_
-		op_arg_rec_.swap(rec.op_arg_rec_);
+		rec.op_arg_rec_.flatten(op_arg_rec_);
 
 		// par_rec_
-		par_rec_.swap(rec.par_rec_);
+		rec.par_rec_.flatten(par_rec_);
 
 		// text_rec_
-		text_rec_.swap(rec.text_rec_);
+		rec.text_rec_.flatten(text_rec_);
+
+		// the arguments are not in compact form
+		compact_arg_        = false;
+		num_op_arg_compact_ = 0;
+		max_op_arg_compact_ = 0;
+		op_arg_compact_.erase();
 
 		// set the number of VecAD vectors
 		num_vecad_vec_rec_ = 0;
@@ -133,6 +162,12 @@ public:
 		op_arg_rec_         = play.op_arg_rec_;
 		par_rec_            = play.par_rec_;
 		text_rec_           = play.text_rec_;
+		compact_arg_        = play.compact_arg_;
+		num_op_arg_compact_ = play.num_op_arg_compact_;
+		max_op_arg_compact_ = play.max_op_arg_compact_;
+		op_arg_compact_     = play.op_arg_compact_;
+		arg_buf_.erase();
+		arg_buf_.extend(max_op_arg_compact_);
 	}
 	// ===============================================================
 
@@ -148,8 +183,408 @@ public:
 		op_arg_rec_.erase();
 		par_rec_.erase();
 		text_rec_.erase();
+
+		compact_arg_        = false;
+		num_op_arg_compact_ = 0;
+		max_op_arg_compact_ = 0;
+		op_arg_compact_.erase();
+	}
+	// ===============================================================
+private:
+	/// write a size_t value in binary form
+	static void write_size(std::ostream& os, size_t value)
+	{	os.write(reinterpret_cast<const char*>(&value), sizeof(size_t)); }
+
+	/// read a size_t value in binary form
+	static bool read_size(std::istream& is, size_t& value)
+	{	is.read(reinterpret_cast<char*>(&value), sizeof(size_t));
+		return bool(is);
+	}
+
+	/// write the length and then the elements of a vector in binary form
+	template <class Type>
+	static void write_vec(std::ostream& os, const pod_vector<Type>& vec)
+	{	size_t length = vec.size();
+		write_size(os, length);
+		if( length > 0 ) os.write(
+			reinterpret_cast<const char*>( vec.data() ),
+			std::streamsize( length * sizeof(Type) )
+		);
+	}
+
+	/// read a vector written by write_vec.
+	/// The elements are read in blocks of at most one mega byte,
+	/// so that a length that is corrupted, or larger than the data in
+	/// the stream, fails when the stream ends (instead of first allocating
+	/// memory for all the elements).
+	template <class Type>
+	static bool read_vec(std::istream& is, pod_vector<Type>& vec)
+	{	size_t length;
+		if( ! read_size(is, length) )
+			return false;
+		vec.erase();
+		size_t block = 1 + 1048576 / sizeof(Type);
+		while( vec.size() < length )
+		{	size_t n = std::min(block, length - vec.size());
+			size_t start = vec.extend(n);
+			is.read(
+				reinterpret_cast<char*>( vec.data() + start ),
+				std::streamsize( n * sizeof(Type) )
+			);
+			if( ! is )
+				return false;
+		}
+		return true;
+	}
+public:
+	/*!
+	Write this recording in binary form.
+
+	\param os
+	is the stream that the recording is written to
+	(it should be opened in binary mode).
+	The number of variables, number of load operations, and the vectors
+	op_rec_, vecad_ind_rec_, op_arg_rec_, par_rec_, text_rec_
+	are written in that order. Each vector is its length followed
+	by the bytes corresponding to its elements.
+	*/
+	void write_binary(std::ostream& os) const
+	{	CPPAD_ASSERT_UNKNOWN( is_pod<Base>() );
+		write_size(os, num_var_rec_);
+		write_size(os, num_load_op_rec_);
+		write_vec(os, op_rec_);
+		write_vec(os, vecad_ind_rec_);
+		if( compact_arg_ )
+		{	pod_vector<addr_t> op_arg;
+			op_arg.extend(num_op_arg_compact_);
+			decode_all( op_arg.data() );
+			write_vec(os, op_arg);
+		}
+		else	write_vec(os, op_arg_rec_);
+		write_vec(os, par_rec_);
+		write_vec(os, text_rec_);
+	}
+
+	/*!
+	Read a recording written by write_binary.
+
+	\param is
+	is the stream that the recording is read from.
+
+	\return
+	is true if the recording was read and it passes some simple checks
+	(the operators are valid, the first is BeginOp, the last is EndOp, and
+	the number of variables agrees with the operators).
+	If it is false, this player is erased.
+	*/
+	bool read_binary(std::istream& is)
+	{	compact_arg_        = false;
+		num_op_arg_compact_ = 0;
+		max_op_arg_compact_ = 0;
+		op_arg_compact_.erase();
+		bool ok = read_size(is, num_var_rec_);
+		ok &= ok && read_size(is, num_load_op_rec_);
+		ok &= ok && read_vec(is, op_rec_);
+		ok &= ok && read_vec(is, vecad_ind_rec_);
+		ok &= ok && read_vec(is, op_arg_rec_);
+		ok &= ok && read_vec(is, par_rec_);
+		ok &= ok && read_vec(is, text_rec_);
+
+		// check the operators
+		size_t i, num_op = op_rec_.size();
+		ok &= ok && num_op >= 2;
+		ok &= ok && op_rec_[0] == BeginOp;
+		ok &= ok && op_rec_[num_op - 1] == EndOp;
+		size_t num_var = 0;
+		for(i = 0; ok && i < num_op; i++)
+		{	ok &= size_t( op_rec_[i] ) < size_t( NumberOp );
+			if( ok )
+				num_var += NumRes( OpCode( op_rec_[i] ) );
+		}
+		ok &= ok && num_var == num_var_rec_;
+
+		// set the number of VecAD vectors
+		num_vecad_vec_rec_ = 0;
+		for(i = 0; ok && i < vecad_ind_rec_.size();
+			i += size_t( vecad_ind_rec_[i] ) + 1 )
+			num_vecad_vec_rec_++;
+		ok &= ok && i == vecad_ind_rec_.size();
+
+		if( ! ok )
+			Erase();
+		return ok;
+	}
+	/*!
+	Mix the structure of this recording into a hash value.
+
+	\param h
+	is the hash value before and after the structure is mixed in.
+	The operators, the operator arguments (in the form that is not compact),
+	and the VecAD indices are included.
+	The parameter values and the text are not included
+	(the sparsity patterns do not depend on them).
+	*/
+	void fingerprint(unsigned int& h) const
+	{	size_t n_byte = op_rec_.size() * sizeof(CPPAD_OP_CODE_TYPE);
+		hash_mix(h, op_rec_.data(), n_byte);
+		n_byte = vecad_ind_rec_.size() * sizeof(addr_t);
+		hash_mix(h, vecad_ind_rec_.data(), n_byte);
+		if( compact_arg_ )
+		{	pod_vector<addr_t> op_arg;
+			op_arg.extend(num_op_arg_compact_);
+			decode_all( op_arg.data() );
+			hash_mix(h, op_arg.data(), op_arg.size() * sizeof(addr_t) );
+		}
+		else
+		{	n_byte = op_arg_rec_.size() * sizeof(addr_t);
+			hash_mix(h, op_arg_rec_.data(), n_byte);
+		}
+	}
+	// ===============================================================
+private:
+	/*!
+	Number of arguments for an operator.
+
+	\param op
+	is the operator.
+
+	\param arg
+	is the beginning of the arguments for this operator
+	(only used when op is CSumOp or CSkipOp).
+	*/
+	static size_t num_arg(OpCode op, const addr_t* arg)
+	{	if( op == CSumOp )
+			return size_t(arg[0]) + size_t(arg[1]) + 4;
+		if( op == CSkipOp )
+			return size_t(arg[4]) + size_t(arg[5]) + 7;
+		return NumArg(op);
+	}
+
+	/*!
+	Compact code for an argument; i.e., the difference between the
+	primary result index for the operator and the argument
+	with the sign in the low order bit.
+	*/
+	static size_t encode_arg(size_t i_var, size_t arg)
+	{	if( arg <= i_var )
+			return 2 * (i_var - arg);
+		return 2 * (arg - i_var) - 1;
+	}
+
+	/*!
+	Decode the argument that begins at op_arg_compact_[pos].
+
+	\param pos [in,out]
+	is the index of the first byte for the argument.
+	Its output value is the index of the first byte for the next argument.
+
+	\param i_var
+	is the index of the primary result for the operator.
+	*/
+	addr_t decode_arg(size_t& pos, size_t i_var) const
+	{	const unsigned char* byte = op_arg_compact_.data();
+		size_t code  = 0;
+		size_t shift = 0;
+		while( byte[pos] & 0x80 )
+		{	code  |= size_t( byte[pos++] & 0x7F ) << shift;
+			shift += 7;
+		}
+		code |= size_t( byte[pos++] ) << shift;
+		if( code & 1 )
+			return addr_t( i_var + (code + 1) / 2 );
+		return addr_t( i_var - code / 2 );
+	}
+
+	/*!
+	Index of the first byte for the argument that ends at
+	op_arg_compact_[end - 1].
+	*/
+	size_t previous_arg(size_t end) const
+	{	const unsigned char* byte = op_arg_compact_.data();
+		CPPAD_ASSERT_UNKNOWN( 0 < end && (byte[end - 1] & 0x80) == 0 );
+		size_t pos = end - 1;
+		while( pos > 0 && (byte[pos - 1] & 0x80) )
+			pos--;
+		return pos;
+	}
+
+	/*!
+	Decode the arguments for the current operator during a forward sweep.
+
+	\param op
+	is the current operator, var_index_ is its primary result,
+	and arg_pos_ is the first byte of its arguments.
+	Upon return, the arguments are in arg_buf_ and arg_pos_ is the
+	first byte of the arguments for the next operator.
+	*/
+	void forward_decode(OpCode op)
+	{	addr_t* buf  = arg_buf_.data();
+		size_t k     = 0;
+		size_t n_arg = NumArg(op);
+		if( op == CSumOp )
+		{	for(k = 0; k < 2; k++)
+				buf[k] = decode_arg(arg_pos_, var_index_);
+			n_arg = num_arg(op, buf);
+		}
+		if( op == CSkipOp )
+		{	for(k = 0; k < 6; k++)
+				buf[k] = decode_arg(arg_pos_, var_index_);
+			n_arg = num_arg(op, buf);
+		}
+		CPPAD_ASSERT_UNKNOWN( n_arg <= max_op_arg_compact_ );
+		for(; k < n_arg; k++)
+			buf[k] = decode_arg(arg_pos_, var_index_);
 	}
 
+	/*!
+	Decode the arguments for the current operator during a reverse sweep.
+
+	\param op
+	is the current operator, var_index_ is its primary result,
+	and arg_pos_ is the first byte of the arguments for the
+	operator after it.
+	Upon return, the arguments are in arg_buf_ and arg_pos_ is the
+	first byte of the arguments for this operator.
+	*/
+	void reverse_decode(OpCode op)
+	{	size_t k, n_arg = NumArg(op);
+		if( op == CSumOp || op == CSkipOp )
+		{	// last argument is number of variable arguments
+			size_t pos  = previous_arg(arg_pos_);
+			size_t last = size_t( decode_arg(pos, var_index_) );
+			if( op == CSumOp )
+				n_arg = last + 4;
+			else	n_arg = last + 7;
+		}
+		CPPAD_ASSERT_UNKNOWN( n_arg <= max_op_arg_compact_ );
+		for(k = 0; k < n_arg; k++)
+			arg_pos_ = previous_arg(arg_pos_);
+		size_t pos   = arg_pos_;
+		addr_t* buf  = arg_buf_.data();
+		for(k = 0; k < n_arg; k++)
+			buf[k] = decode_arg(pos, var_index_);
+	}
+
+	/*!
+	Decode all of the arguments (when compact_arg_ is true).
+
+	\param arg [out]
+	has size num_op_arg_compact_ and is set to the arguments
+	in the same order as op_arg_rec_.
+	*/
+	void decode_all(addr_t* arg) const
+	{	CPPAD_ASSERT_UNKNOWN( compact_arg_ );
+		size_t pos = 0, i_arg = 0, n_res = 0;
+		for(size_t i_op = 0; i_op < op_rec_.size(); i_op++)
+		{	OpCode op     = OpCode( op_rec_[i_op] );
+			n_res        += NumRes(op);
+			size_t i_var  = n_res - 1;
+			size_t k      = 0;
+			size_t n_arg  = NumArg(op);
+			if( op == CSumOp || op == CSkipOp )
+			{	size_t n_fixed = 2;
+				if( op == CSkipOp )
+					n_fixed = 6;
+				for(k = 0; k < n_fixed; k++)
+					arg[i_arg + k] = decode_arg(pos, i_var);
+				n_arg = num_arg(op, arg + i_arg);
+			}
+			for(; k < n_arg; k++)
+				arg[i_arg + k] = decode_arg(pos, i_var);
+			i_arg += n_arg;
+		}
+		CPPAD_ASSERT_UNKNOWN( i_arg == num_op_arg_compact_ );
+		CPPAD_ASSERT_UNKNOWN( pos == op_arg_compact_.size() );
+	}
+public:
+	/*!
+	Convert the operator arguments to or from compact form.
+
+	\param compact
+	If true, op_arg_rec_ is converted to op_arg_compact_ and its
+	memory is returned to thread_alloc.
+	Each argument is stored as the difference between the primary result
+	for its operator and the argument (with the sign in the low order bit)
+	using seven bits per byte and the high bit set for all but the
+	last byte. Thus most arguments that are variables require one byte and
+	the bytes for an argument can be found from either end.
+	If false, op_arg_compact_ is converted back to op_arg_rec_.
+
+	\par
+	When the arguments are in compact form, the forward and reverse
+	playback routines decode the arguments for each operator into arg_buf_
+	and return a pointer to arg_buf_ (which is only valid until the next
+	call to a playback routine). The routines
+	forward_csum, forward_cskip, reverse_csum, and reverse_cskip
+	do nothing in this case (the playback routines decode the variable
+	number of arguments for these operators).
+	In addition, GetArg cannot be used.
+	*/
+	void compact_arg(bool compact)
+	{	if( compact == compact_arg_ )
+			return;
+		size_t i_op, k, n_arg, num_op = op_rec_.size();
+		if( ! compact )
+		{	op_arg_rec_.erase();
+			op_arg_rec_.extend(num_op_arg_compact_);
+			decode_all( op_arg_rec_.data() );
+			compact_arg_        = false;
+			num_op_arg_compact_ = 0;
+			max_op_arg_compact_ = 0;
+			op_arg_compact_.free();
+			arg_buf_.free();
+			return;
+		}
+		// first pass computes the number of bytes, second stores them
+		size_t n_byte = 0;
+		for(size_t pass = 0; pass < 2; pass++)
+		{	unsigned char* byte = op_arg_compact_.data();
+			const addr_t*  arg  = op_arg_rec_.data();
+			size_t n_res = 0, pos = 0;
+			max_op_arg_compact_ = 0;
+			for(i_op = 0; i_op < num_op; i_op++)
+			{	OpCode op     = OpCode( op_rec_[i_op] );
+				n_res        += NumRes(op);
+				n_arg         = num_arg(op, arg);
+				max_op_arg_compact_ = std::max(max_op_arg_compact_, n_arg);
+				for(k = 0; k < n_arg; k++)
+				{	size_t code = encode_arg(n_res - 1, size_t(arg[k]));
+					while( code >= 0x80 )
+					{	if( pass == 1 )
+							byte[pos] = (unsigned char)( (code & 0x7F) | 0x80 );
+						pos++;
+						code >>= 7;
+					}
+					if( pass == 1 )
+						byte[pos] = (unsigned char)( code );
+					pos++;
+				}
+				arg += n_arg;
+			}
+			CPPAD_ASSERT_UNKNOWN( arg == op_arg_rec_.data() + op_arg_rec_.size() );
+			if( pass == 0 )
+			{	n_byte = pos;
+				op_arg_compact_.erase();
+				op_arg_compact_.extend(n_byte);
+			}
+			CPPAD_ASSERT_UNKNOWN( pos == n_byte );
+		}
+		compact_arg_        = true;
+		num_op_arg_compact_ = op_arg_rec_.size();
+		op_arg_rec_.free();
+		arg_buf_.erase();
+		arg_buf_.extend(max_op_arg_compact_);
+	}
+
+	/// Are the operator arguments in compact form.
+	bool compact_arg(void) const
+	{	return compact_arg_; }
+
+	/// Number of bytes used for the arguments in compact form
+	/// (zero if they are not in compact form).
+	size_t num_op_arg_compact(void) const
+	{	return op_arg_compact_.size(); }
+
 public:
 	/*! 
 	\brief 
@@ -201,6 +636,19 @@ public:
 	const Base* GetPar(void) const
 	{	return par_rec_.data(); }
 
+	/*!
+	\brief
+	Fetch entire operator argument vector from the recording.
+
+	\return
+	the beginning of the operator argument vector
+	(does not change the current playback location).
+	*/
+	const addr_t* GetArg(void) const
+	{	CPPAD_ASSERT_UNKNOWN( ! compact_arg_ );
+		return op_arg_rec_.data();
+	}
+
 	/*! 
 	\brief 
 	Fetch a '\\0' terminated string from the recording.
@@ -238,7 +686,10 @@ public:
 
 	/// Fetch number of argument indices in the recording.
 	size_t num_op_arg_rec(void) const
-	{	return op_arg_rec_.size(); }
+	{	if( compact_arg_ )
+			return num_op_arg_compact_;
+		return op_arg_rec_.size();
+	}
 
 	/// Fetch number of parameters in the recording.
 	size_t num_par_rec(void) const
@@ -253,6 +704,7 @@ public:
 	size_t Memory(void) const
 	{	return op_rec_.size()        * sizeof(OpCode) 
 		     + op_arg_rec_.size()    * sizeof(addr_t)
+		     + op_arg_compact_.size()
 		     + par_rec_.size()       * sizeof(Base)
 		     + text_rec_.size()      * sizeof(char)
 		     + vecad_ind_rec_.size() * sizeof(addr_t)
@@ -273,6 +725,13 @@ private:
 	/// Index for primary (last) variable corresponding to current operator
 	size_t    var_index_;
 
+	/// Arguments for the current operator (when compact_arg_ is true)
+	pod_vector<addr_t> arg_buf_;
+
+	/// Index in op_arg_compact_ after the arguments for the current operator
+	/// (forward sweep) or at the first argument (reverse sweep)
+	size_t    arg_pos_;
+
 // ----------- Functions used in new method for palying back a recording ---
 public:
 	/*!
@@ -309,6 +768,12 @@ public:
 		CPPAD_ASSERT_UNKNOWN( op_  == BeginOp );
 		CPPAD_ASSERT_NARG_NRES(op_, 1, 1);
 
+		if( compact_arg_ )
+		{	arg_pos_ = 0;
+			forward_decode(op_);
+			op_arg   = op_arg_ = arg_buf_.data();
+		}
+
 		return;
 	}
 
@@ -358,6 +823,16 @@ public:
 		CPPAD_ASSERT_UNKNOWN( op_index  == op_index_ );
 		CPPAD_ASSERT_UNKNOWN( var_index == var_index_ );
 
+		if( compact_arg_ )
+		{	op_index  = ++op_index_;
+			op        = op_         = OpCode( op_rec_[ op_index_ ] );
+			var_index = var_index_ += NumRes(op);
+			forward_decode(op);
+			CPPAD_ASSERT_UNKNOWN( op_arg_ == arg_buf_.data() );
+			CPPAD_ASSERT_UNKNOWN( var_index_  < num_var_rec_ );
+			return;
+		}
+
 		// index for the next operator 
 		op_index    = ++op_index_;
 
@@ -411,6 +886,9 @@ public:
 		CPPAD_ASSERT_UNKNOWN(
 		op_arg[0] + op_arg[1] == op_arg[ 3 + op_arg[0] + op_arg[1] ]
 		);
+		// forward_next has already decoded all the arguments
+		if( compact_arg_ )
+			return;
 		/*
 		The only thing that really needs fixing is op_arg_.
 		Actual number of arugments for this operator is
@@ -460,6 +938,9 @@ public:
 		CPPAD_ASSERT_UNKNOWN(
 		op_arg[4] + op_arg[5] == op_arg[ 6 + op_arg[4] + op_arg[5] ]
 		);
+		// forward_next has already decoded all the arguments
+		if( compact_arg_ )
+			return;
 		/*
 		The only thing that really needs fixing is op_arg_.
 		Actual number of arugments for this operator is
@@ -509,6 +990,10 @@ public:
 		op          = op_         = OpCode( op_rec_[ op_index_ ] );
 		CPPAD_ASSERT_UNKNOWN( op_ == EndOp );
 		CPPAD_ASSERT_NARG_NRES(op, 0, 0);
+		if( compact_arg_ )
+		{	arg_pos_ = op_arg_compact_.size();
+			op_arg   = op_arg_ = arg_buf_.data();
+		}
 		return;
 	}
 
@@ -572,6 +1057,15 @@ public:
 		CPPAD_ASSERT_UNKNOWN( var_index_ >= NumRes(op_) );
 		var_index   = var_index_ -= NumRes(op_);
 
+		if( compact_arg_ )
+		{	CPPAD_ASSERT_UNKNOWN( op_index_  > 0 );
+			op_index  = --op_index_;
+			op        = op_         = OpCode( op_rec_[ op_index_ ] );
+			reverse_decode(op);
+			CPPAD_ASSERT_UNKNOWN( op_arg_ == arg_buf_.data() );
+			return;
+		}
+
 		// next operator
 		CPPAD_ASSERT_UNKNOWN( op_index_  > 0 );
 		op_index    = --op_index_;                                  // index
@@ -616,6 +1110,9 @@ public:
 
 		CPPAD_ASSERT_UNKNOWN( op == CSumOp );
 		CPPAD_ASSERT_UNKNOWN( NumArg(CSumOp) == 0 );
+		// reverse_next has already decoded all the arguments
+		if( compact_arg_ )
+			return;
 		/*
 		The variables that need fixing are op_arg_ and op_arg. Currently, 
 		op_arg points to the last argument for the previous operator.
@@ -667,6 +1164,9 @@ public:
 
 		CPPAD_ASSERT_UNKNOWN( op == CSkipOp );
 		CPPAD_ASSERT_UNKNOWN( NumArg(CSkipOp) == 0 );
+		// reverse_next has already decoded all the arguments
+		if( compact_arg_ )
+			return;
 		/*
 		The variables that need fixing are op_arg_ and op_arg. Currently, 
 		op_arg points to the last arugment for the previous operator.
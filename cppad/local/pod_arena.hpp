@@ -0,0 +1,250 @@
+/* $Id$ */
+# ifndef CPPAD_POD_ARENA_INCLUDED
+# define CPPAD_POD_ARENA_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <limits>
+# include <cppad/local/cppad_assert.hpp>
+# include <cppad/local/pod_vector.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file pod_arena.hpp
+File used to define pod_arena class
+*/
+
+/*!
+\def CPPAD_POD_ARENA_FIRST_BYTES
+minimum number of bytes in the first segment of a pod_arena.
+*/
+# define CPPAD_POD_ARENA_FIRST_BYTES 4096
+
+/*!
+A vector, used during recording, that grows without copying its elements.
+
+The elements are stored in a sequence of segments.
+When the current segment is full, a new segment is allocated
+that is at least as large as all the previous segments together,
+so the number of segments is logarithmic in the number of elements
+and the elements that are already in the vector are not moved.
+The function \c flatten moves the elements to a \c pod_vector
+(without any copying when there is only one segment).
+The length of the vector when \c flatten is called is used as the
+size of the first segment the next time the vector is used,
+so recording the same operation sequence again only uses one segment.
+
+The interface is the part of the \c pod_vector interface used by recorder;
+i.e., \c extend, \c size, \c capacity, element access, and \c free.
+Element access is fastest for elements in the last segment
+(which is where the recorder usually stores new elements).
+*/
+template <class Type>
+class pod_arena {
+private:
+	/// maximum number of segments (each segment at least doubles the capacity)
+	static const size_t max_segment_ = 64;
+	/// maximum number of elements that should ever be in this vector
+	size_t           max_length_;
+	/// number of elements currently in this vector
+	size_t           length_;
+	/// number of segments currently allocated
+	size_t           n_segment_;
+	/// index of the first element in the last segment
+	size_t           last_begin_;
+	/// index of the first element after the last segment
+	/// (this is also the total capacity of the segments)
+	size_t           last_end_;
+	/// data for the last segment (not defined when n_segment_ is zero)
+	Type*            last_data_;
+	/// length of this vector the last time flatten was called
+	size_t           hint_;
+	/// index of the first element in each segment
+	size_t           begin_[max_segment_];
+	/// memory for each segment (the length of each segment is its capacity)
+	pod_vector<Type> segment_[max_segment_];
+
+	/// allocate a new segment so that the current length fits
+	void grow(void)
+	{	CPPAD_ASSERT_UNKNOWN( last_end_ < length_ );
+		CPPAD_ASSERT_KNOWN(
+			n_segment_ < max_segment_,
+			"pod_arena.hpp: attempt to create to large a vector."
+		);
+		// size of new segment
+		size_t n_new = CPPAD_POD_ARENA_FIRST_BYTES / sizeof(Type);
+		if( n_new < last_end_ )
+			n_new = last_end_;
+		if( last_end_ < hint_ && n_new < hint_ - last_end_ )
+			n_new = hint_ - last_end_;
+		if( n_new < length_ - last_end_ )
+			n_new = length_ - last_end_;
+
+		// allocate the new segment and use all of its capacity
+		pod_vector<Type>& seg = segment_[n_segment_];
+		seg.extend(n_new);
+		seg.extend( seg.capacity() - seg.size() );
+
+		begin_[n_segment_] = last_end_;
+		last_begin_        = last_end_;
+		last_end_         += seg.size();
+		last_data_         = seg.data();
+		n_segment_++;
+		CPPAD_ASSERT_UNKNOWN( length_ <= last_end_ );
+	}
+
+	/// element in a segment before the last one
+	Type& element(size_t i)
+	{	CPPAD_ASSERT_UNKNOWN( i < last_begin_ );
+		size_t k = n_segment_ - 1;
+		while( i < begin_[k] )
+			k--;
+		return segment_[k][i - begin_[k]];
+	}
+
+	/// do not use the copy constructor
+	explicit pod_arena(const pod_arena& )
+	{	CPPAD_ASSERT_UNKNOWN(false); }
+public:
+	/// Constructor sets the length and capacity to zero.
+	///
+	/// \param max_length
+	/// value for maximum number of elements in this vector.
+	pod_arena(size_t max_length = std::numeric_limits<size_t>::max())
+	: max_length_(max_length), length_(0), n_segment_(0),
+	  last_begin_(0), last_end_(0), last_data_(CPPAD_NULL), hint_(0)
+	{ }
+	// ----------------------------------------------------------------------
+	/// current number of elements in this vector.
+	size_t size(void) const
+	{	return length_; }
+
+	/// current capacity (amount of allocated storage) for this vector.
+	size_t capacity(void) const
+	{	return last_end_; }
+
+	/// set the tag used for future memory allocations by this vector
+	/// (see thread_alloc::statistics).
+	void set_tag(thread_alloc::tag_type tag)
+	{	for(size_t k = 0; k < max_segment_; k++)
+			segment_[k].set_tag(tag);
+	}
+	// ----------------------------------------------------------------------
+	/*!
+	Increase the number of elements the end of this vector.
+
+	\param n
+	is the number of elements to add to end of this vector.
+
+	\return
+	is the number  of elements in the vector before \c extend was extended.
+
+	- The elements already in the vector are not moved.
+	The new elements may be split between two segments
+	(use element access to set their values).
+
+	- If the resulting length of the vector would be more than \c max_length_,
+	and \c NDEBUG is not defined, a CPPAD_ASSERT is generated.
+	*/
+	size_t extend(size_t n)
+	{	size_t old_length = length_;
+		length_          += n;
+		CPPAD_ASSERT_KNOWN(
+			length_ <= max_length_ ,
+			"pod_arena.hpp: attempt to create to large a vector.\n"
+			"If Type is CPPAD_TYPE_ADDR_TYPE, tape is too long for Type."
+		);
+		if( last_end_ < length_ )
+			grow();
+		return old_length;
+	}
+	// ----------------------------------------------------------------------
+	/// non-constant element access; i.e., we can change this element value
+	Type& operator[](
+		/// element index, must be less than length
+		size_t i
+	)
+	{	CPPAD_ASSERT_UNKNOWN( i < length_ );
+		if( last_begin_ <= i )
+			return last_data_[i - last_begin_];
+		return element(i);
+	}
+	/// constant element access; i.e., we cannot change this element value
+	const Type& operator[](
+		/// element index, must be less than length
+		size_t i
+	) const
+	{	CPPAD_ASSERT_UNKNOWN( i < length_ );
+		if( last_begin_ <= i )
+			return last_data_[i - last_begin_];
+		return const_cast<pod_arena*>(this)->element(i);
+	}
+	// ----------------------------------------------------------------------
+	/*!
+	Remove all the elements from this vector and delete its memory
+	(the length when flatten was last called is not changed).
+	*/
+	void free(void)
+	{	for(size_t k = 0; k < n_segment_; k++)
+			segment_[k].free();
+		length_     = 0;
+		n_segment_  = 0;
+		last_begin_ = 0;
+		last_end_   = 0;
+		last_data_  = CPPAD_NULL;
+	}
+	// ----------------------------------------------------------------------
+	/*!
+	Move the elements of this vector to a pod_vector.
+
+	\param vec
+	The input value of this vector does not matter
+	(its memory is reused when possible).
+	Upon return, it contains the elements of this vector.
+	If there is only one segment, its memory is swapped into \a vec
+	(no elements are copied).
+	Otherwise, the elements are copied to \a vec in one pass
+	and the segments are freed.
+
+	\par
+	Upon return, this vector is empty and the current length is used
+	as the minimum size for its first segment when it is extended.
+	*/
+	void flatten(pod_vector<Type>& vec)
+	{	hint_ = length_;
+		if( n_segment_ == 1 )
+		{	// change the length of the segment to length_ and swap
+			segment_[0].erase();
+			segment_[0].extend(length_);
+			vec.swap( segment_[0] );
+		}
+		else
+		{	vec.erase();
+			if( length_ > 0 )
+				vec.extend(length_);
+			size_t i = 0;
+			for(size_t k = 0; k < n_segment_; k++)
+			{	const pod_vector<Type>& seg = segment_[k];
+				size_t n = seg.size();
+				if( length_ - i < n )
+					n = length_ - i;
+				for(size_t j = 0; j < n; j++)
+					vec[i++] = seg[j];
+			}
+			CPPAD_ASSERT_UNKNOWN( i == length_ );
+		}
+		free();
+	}
+};
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -3,7 +3,7 @@
 # define CPPAD_POD_VECTOR_INCLUDED
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -76,9 +76,11 @@ private:
 	size_t length_;
 	/// maximum number of Type elements current allocation can hold
 	size_t capacity_;
-	/// pointer to the first type elements 
+	/// pointer to the first type elements
 	/// (not defined and should not be used when capacity_ = 0)
 	Type   *data_;
+	/// tag used when this vector allocates memory
+	thread_alloc::tag_type tag_;
 	/// do not use the copy constructor
 	explicit pod_vector(const pod_vector& )
 	{	CPPAD_ASSERT_UNKNOWN(false); }
@@ -91,6 +93,7 @@ public:
 		size_t max_length = std::numeric_limits<size_t>::max()
 	) 
 	: max_length_(max_length), length_(0), capacity_(0), data_(CPPAD_NULL)
+	, tag_(thread_alloc::other_tag)
 	{ }
 	// ----------------------------------------------------------------------
 	/// Destructor: returns allocated memory to \c thread_alloc; 
@@ -115,6 +118,10 @@ public:
 	/// current capacity (amount of allocated storage) for this vector.
 	inline size_t capacity(void) const
 	{	return capacity_; }
+	/// set the tag used for future memory allocations by this vector
+	/// (see thread_alloc::statistics).
+	inline void set_tag(thread_alloc::tag_type tag)
+	{	tag_ = tag; }
 	/// current data pointer, no longer valid after any of the following:
 	/// extend, erase, operator=, and ~pod_vector. 
 	/// Take extreem care when using this function.
@@ -163,7 +170,9 @@ public:
 		// get new memory and set capacity
 		size_t length_bytes = length_ * sizeof(Type);
 		size_t capacity_bytes;
-		void* v_ptr = thread_alloc::get_memory(length_bytes, capacity_bytes);
+		void* v_ptr = thread_alloc::get_memory(
+			length_bytes, capacity_bytes, tag_
+		);
 		capacity_   = capacity_bytes / sizeof(Type);
 		data_       = reinterpret_cast<Type*>(v_ptr);
 		CPPAD_ASSERT_UNKNOWN( length_ <= capacity_ );
@@ -286,6 +295,7 @@ public:
 	{	std::swap(capacity_, other.capacity_);
 		std::swap(length_,   other.length_);
 		std::swap(data_,     other.data_);
+		std::swap(tag_,      other.tag_);
 	}
 };
 
@@ -12,7 +12,8 @@ A copy of this license is included in the COPYING file of this distribution.
 Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 # include <cppad/local/hash_code.hpp>
-# include <cppad/local/pod_vector.hpp>
+# include <cppad/local/hash_table.hpp>
+# include <cppad/local/pod_arena.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
@@ -20,9 +21,26 @@ namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 File used to define the recorder class.
 */
 
+/*!
+\def CPPAD_PAR_HASH_TABLE_SIZE
+maximum number of slots in the hash table used by recorder::PutPar
+(must be a power of two).
+The table holds at most half this many parameters, so that it stays in the
+memory cache while recording tapes with millions of parameters.
+When it is full, all its entries are removed; i.e., PutPar only finds
+values among the most recent (at most) CPPAD_PAR_HASH_TABLE_SIZE / 2
+parameters that it placed in the recording.
+*/
+# define CPPAD_PAR_HASH_TABLE_SIZE 65536
+
 /*!
 Class used to store an operation sequence while it is being recorded
-(the operation sequence is copied to the player class for playback).
+(the operation sequence is moved to the player class for playback).
+
+The vectors in the recording are pod_arena objects, so they do not copy
+their elements when they grow. When the same recorder is used again
+(for example, the tape for a thread), the first segment of each vector
+is large enough to hold the previous recording.
 
 \tparam Base
 This is an AD< \a Base > operation sequence recording; i.e.,
@@ -37,9 +55,6 @@ private:
 	/// (do not abort when zero)
 	size_t abort_op_index_;
 
-	/// offset for this thread in the static hash table
-	const size_t thread_offset_;
-
 	/// Number of variables in the recording.
 	size_t    num_var_rec_;
 
@@ -47,34 +62,43 @@ private:
 	size_t	num_load_op_rec_;
 
 	/// The operators in the recording.
-	pod_vector<CPPAD_OP_CODE_TYPE> op_rec_;
+	pod_arena<CPPAD_OP_CODE_TYPE> op_rec_;
 
 	/// The VecAD indices in the recording.
-	pod_vector<addr_t> vecad_ind_rec_;
+	pod_arena<addr_t> vecad_ind_rec_;
 
 	/// The argument indices in the recording
-	pod_vector<addr_t> op_arg_rec_;
+	pod_arena<addr_t> op_arg_rec_;
 
 	/// The parameters in the recording.
 	/// Note that Base may not be plain old data, so use false in consructor.
-	pod_vector<Base> par_rec_;
+	pod_arena<Base> par_rec_;
 
 	/// Character strings ('\\0' terminated) in the recording.
-	pod_vector<char> text_rec_;
+	pod_arena<char> text_rec_;
+
+	/// Maps the hash code for a parameter value to its index in par_rec_
+	/// (for the most recent CPPAD_PAR_HASH_TABLE_SIZE / 2 parameters).
+	hash_table par_hash_table_;
 // ---------------------- Public Functions -----------------------------------
 public:
 	/// Default constructor
 	recorder(void) : 
-	thread_offset_( thread_alloc::thread_num() * CPPAD_HASH_TABLE_SIZE ) ,
 	num_var_rec_(0)                                      ,
 	num_load_op_rec_(0)                                  ,
 	op_rec_( std::numeric_limits<addr_t>::max() )        ,
 	vecad_ind_rec_( std::numeric_limits<addr_t>::max() ) ,
 	op_arg_rec_( std::numeric_limits<addr_t>::max() )    ,
 	par_rec_( std::numeric_limits<addr_t>::max() )       ,
-	text_rec_( std::numeric_limits<addr_t>::max() )
+	text_rec_( std::numeric_limits<addr_t>::max() )      ,
+	par_hash_table_( CPPAD_PAR_HASH_TABLE_SIZE )
 	{
 		abort_op_index_ = 0;
+		op_rec_.set_tag(thread_alloc::recorder_tag);
+		vecad_ind_rec_.set_tag(thread_alloc::recorder_tag);
+		op_arg_rec_.set_tag(thread_alloc::recorder_tag);
+		par_rec_.set_tag(thread_alloc::recorder_tag);
+		text_rec_.set_tag(thread_alloc::recorder_tag);
 	}
 
 	/// Set the abort index
@@ -105,6 +129,7 @@ public:
 		op_arg_rec_.free();
 		par_rec_.free();
 		text_rec_.free();
+		par_hash_table_.free();
 	}
 	/// Put next operator in the operation sequence.
 	inline size_t PutOp(OpCode op);
@@ -156,7 +181,8 @@ public:
 		     + vecad_ind_rec_.capacity() * sizeof(size_t)
 		     + op_arg_rec_.capacity()    * sizeof(addr_t)
 		     + par_rec_.capacity()       * sizeof(Base)
-		     + text_rec_.capacity()      * sizeof(char);
+		     + text_rec_.capacity()      * sizeof(char)
+		     + par_hash_table_.Memory();
 	}
 };
 
@@ -297,35 +323,40 @@ is the parameter to be found or placed in the vector of parameters.
 is the index in the parameter vector corresponding to this parameter value.
 This value is not necessarily placed at the end of the vector
 (because values that are identically equal may be reused).
+
+\par Limit
+Only the parameters in par_hash_table_ are checked for a match.
+This table holds at most the last CPPAD_PAR_HASH_TABLE_SIZE / 2 parameters
+placed in the recording, so a value that was placed before that is
+placed again (the recording is correct but larger than necessary).
+A table that grows with the recording would find every match,
+but it does not stay in the memory cache and made recording
+operation sequences with millions of distinct parameters about twice as slow.
 */
 template <class Base>
 size_t recorder<Base>::PutPar(const Base &par)
-{	static size_t   hash_table[CPPAD_HASH_TABLE_SIZE * CPPAD_MAX_NUM_THREADS];
-	size_t          i;
+{	size_t          i;
 	size_t          code;
 
-	CPPAD_ASSERT_UNKNOWN( 
-		thread_offset_ / CPPAD_HASH_TABLE_SIZE
-		== 
-		thread_alloc::thread_num() 
-	);
-
 	// get hash code for this value
-	code = static_cast<size_t>( hash_code(par) );
-	CPPAD_ASSERT_UNKNOWN( code < CPPAD_HASH_TABLE_SIZE );
+	code = hash_code(par);
 
 	// If we have a match, return the parameter index
-	i = hash_table[code + thread_offset_];
-	if( i < par_rec_.size() && IdenticalEqualPar(par_rec_[i], par) )
+	size_t slot = par_hash_table_.find(code);
+	while( slot != par_hash_table_.end() )
+	{	i = par_hash_table_.index(slot);
+		if( i < par_rec_.size() && IdenticalEqualPar(par_rec_[i], par) )
 			return i;
+		slot = par_hash_table_.find_next(slot, code);
+	}
 	
 	// place a new value in the table
 	i           = par_rec_.extend(1);
 	par_rec_[i] = par;
 	CPPAD_ASSERT_UNKNOWN( par_rec_.size() == i + 1 );
 
-	// make the hash code point to this new value
-	hash_table[code + thread_offset_] = i;
+	// add an entry for this new value to the hash table
+	par_hash_table_.insert(code, i);
 
 	// return the parameter index
 	return i;
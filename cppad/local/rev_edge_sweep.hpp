@@ -0,0 +1,226 @@
+/* $Id$ */
+# ifndef CPPAD_REV_EDGE_SWEEP_INCLUDED
+# define CPPAD_REV_EDGE_SWEEP_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <map>
+# include <cppad/local/rev_local_sweep.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file rev_edge_sweep.hpp
+Compute a Hessian using one edge pushing reverse sweep.
+*/
+
+/*!
+Eliminates result variables from the edge pushing representation
+of the Hessian (used as the Push class for RevLocalSweep).
+
+\tparam Base
+is the type used for the derivative values.
+*/
+template <class Base>
+class rev_edge_push {
+private:
+	/// first order partial with respect to each variable
+	Base*                                   adjoint_;
+	/// symmetric second order partials with respect to pairs of variables
+	CppAD::vector< std::map<size_t,Base> >& W_;
+public:
+	/// constructor
+	rev_edge_push(
+		Base*                                   adjoint ,
+		CppAD::vector< std::map<size_t,Base> >& W       )
+	: adjoint_(adjoint), W_(W)
+	{ }
+	/*!
+	Eliminate one result variable.
+
+	The operator is \f$ z = \varphi ( x_0 , \ldots , x_{nx-1} ) \f$
+	where \f$ z \f$ is the variable with index \a i_z and
+	\f$ x_j \f$ is the variable with index <code>x[j]</code>
+	(the same variable may appear more than once).
+
+	\param i_z
+	is the variable index for the result of this operation.
+
+	\param nx
+	is the number of variable arguments for this operation.
+
+	\param x
+	<code>x[j]</code> is the variable index for the j-th argument.
+	Each of these indices is less than \a i_z.
+
+	\param d
+	<code>d[j]</code> is the partial of \f$ \varphi \f$ with respect to
+	\f$ x_j \f$.
+
+	\param h
+	If \a h is \c CPPAD_NULL, \f$ \varphi \f$ is linear.
+	Otherwise <code>h[ j * nx + k ]</code> is the second partial of
+	\f$ \varphi \f$ with respect to \f$ x_j \f$ and \f$ x_k \f$.
+
+	On input <code>adjoint_[i_z]</code> is the first order partial of the
+	function being differentiated with respect to \f$ z \f$.
+	On output the contributions through \f$ z \f$ have been added to
+	<code>adjoint_[ x[j] ]</code>.
+	On input <code>W_[i][k]</code> is the symmetric second order partial
+	with respect to the variables with index \c i and \c k
+	(entries that are not present are zero).
+	On output, the row and column corresponding to \a i_z have been removed
+	and their contributions pushed to the argument variables.
+	*/
+	void operator()(
+		size_t                                 i_z     ,
+		size_t                                 nx      ,
+		const size_t*                          x       ,
+		const Base*                            d       ,
+		const Base*                            h       )
+	{	typedef typename std::map<size_t, Base>::iterator iterator;
+		CppAD::vector< std::map<size_t,Base> >& W(W_);
+		size_t j, k;
+
+		// remove the row and column corresponding to z
+		std::map<size_t, Base> row;
+		row.swap( W[i_z] );
+		Base w_zz = Base(0);
+		iterator itr;
+		for(itr = row.begin(); itr != row.end(); itr++)
+		{	if( itr->first == i_z )
+				w_zz = itr->second;
+			else
+				W[itr->first].erase(i_z);
+		}
+
+		// pushing: second partials that involve z and one other variable
+		for(itr = row.begin(); itr != row.end(); itr++)
+		if( itr->first != i_z )
+		{	size_t p = itr->first;
+			for(j = 0; j < nx; j++) if( ! IdenticalZero(d[j]) )
+			{	Base v = d[j] * itr->second;
+				W[ x[j] ][p] += v;
+				W[p][ x[j] ] += v;
+			}
+		}
+
+		// pushing second partial w.r.t. z and creating second partials
+		Base a_z = adjoint_[i_z];
+		for(j = 0; j < nx; j++)
+		{	for(k = 0; k < nx; k++)
+			{	Base v = d[j] * d[k] * w_zz;
+				if( h != CPPAD_NULL )
+					v += a_z * h[ j * nx + k ];
+				if( ! IdenticalZero(v) )
+					W[ x[j] ][ x[k] ] += v;
+			}
+		}
+
+		// adjoint: first partials
+		for(j = 0; j < nx; j++)
+			adjoint_[ x[j] ] += a_z * d[j];
+	}
+};
+
+/*!
+Compute the Hessian of a weighted sum of the dependent variables
+using one edge pushing reverse sweep.
+
+The second order partials are accumulated in a symmetric sparse matrix
+indexed by the variables on the tape.
+Going through the operations in reverse order,
+the row and column for each result are pushed to the arguments of
+the operation, together with the second partials of the operation times
+the corresponding first order partial (adjoint).
+No sparsity pattern or coloring is used.
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD< \a Base > and computations by this routine are done using type
+\a Base.
+
+\param n
+is the number of independent variables on the tape.
+
+\param numvar
+is the total number of variables on the tape; i.e.,
+\a play->num_var_rec().
+
+\param play
+is the recording of the operations (see RevLocalSweep).
+
+\param cap_order
+is the maximum number of orders that will fit in \a taylor.
+
+\param taylor
+For i = 1 , ... , \a numvar - 1,
+<code>taylor[ i * cap_order + 0 ]</code> is the zero order
+Taylor coefficient for the variable with index i.
+
+\param cskip_op
+Is a vector with size \a play->num_op_rec().
+If <code>cskip_op[i]</code> is true, the operator with index i
+does not affect any of the dependent variable
+(given the value of the independent variables).
+
+\param adjoint
+This vector has size \a numvar.
+\n
+\n
+\b Input:
+For i = 0 , ... , \a numvar - 1, <code>adjoint[i]</code> is the weight
+for the variable with index i in the function being differentiated
+(it is zero unless the variable is a dependent variable).
+\n
+\n
+\b Output:
+The values in \a adjoint are not specified; i.e.,
+it is used for temporary work space.
+
+\param W
+This vector has size \a numvar.
+\n
+\n
+\b Input:
+All the maps in \a W are empty.
+\n
+\n
+\b Output:
+For j = 1 , ... , \a n, <code>W[j][k]</code> is the second partial
+with respect to the independent variables with index (j-1) and (k-1)
+(entries that are not present are zero).
+The values in the rest of \a W are not specified.
+
+\return
+The return value is false if the tape contains an operation
+that is not supported by this sweep
+(VecAD and atomic function operations).
+In this case the values in \a W are not specified.
+*/
+template <class Base>
+bool RevEdgeSweep(
+	size_t                                  n,
+	size_t                                  numvar,
+	player<Base>*                           play,
+	size_t                                  cap_order,
+	const Base*                             taylor,
+	const bool*                             cskip_op,
+	Base*                                   adjoint,
+	CppAD::vector< std::map<size_t,Base> >& W
+)
+{	CPPAD_ASSERT_UNKNOWN( W.size() == numvar );
+	rev_edge_push<Base> push(adjoint, W);
+	return RevLocalSweep(n, numvar, play, cap_order, taylor, cskip_op, push);
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -40,7 +40,7 @@ using AD< \a Base > and computations by this routine are done using type
 
 \tparam Vector_set
 is the type used for vectors of sets. It can be either
-\c sparse_pack, \c sparse_set, or \c sparse_list.
+\c sparse_pack, \c sparse_set, \c sparse_list, or \c sparse_hybrid.
 
 \param n
 is the number of independent variables on the tape.
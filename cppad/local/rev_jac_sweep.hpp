@@ -58,7 +58,7 @@ using AD< \a Base > and computations by this routine are done using type
 
 \tparam Vector_set
 is the type used for vectors of sets. It can be either
-\c sparse_pack, \c sparse_set, or \c sparse_list.
+\c sparse_pack, \c sparse_set, \c sparse_list, or \c sparse_hybrid.
 
 \param nz_compare
 Are the derivatives with respect to left and right of the expression below
@@ -0,0 +1,466 @@
+/* $Id$ */
+# ifndef CPPAD_REV_LOCAL_SWEEP_INCLUDED
+# define CPPAD_REV_LOCAL_SWEEP_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file rev_local_sweep.hpp
+Reverse sweep that uses the partials of each operation with respect to
+its arguments.
+*/
+
+/*!
+Reverse sweep that eliminates the result of each operation using the
+first and second order partials of the operation.
+
+Going through the operations in reverse order,
+the partials of each operation with respect to its variable arguments
+are evaluated at the zero order Taylor coefficients and passed to
+\a push, which eliminates the result of the operation.
+This is used for the edge pushing Hessian (see RevEdgeSweep)
+and for first order reverse mode with multiple weight vectors
+(see RevVecSweep).
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD< \a Base > and computations by this routine are done using type
+\a Base.
+
+\tparam Push
+is a class with a member function
+\verbatim
+	void operator()(i_z, nx, x, d, h)
+\endverbatim
+with the same arguments as rev_edge_push::operator().
+It eliminates the variable with index \c i_z
+(after all the operations that use this variable have been eliminated).
+
+\param n
+is the number of independent variables on the tape.
+
+\param numvar
+is the total number of variables on the tape; i.e.,
+\a play->num_var_rec().
+
+\param play
+The information stored in \a play
+is a recording of the operations corresponding to a function
+\f[
+	F : {\bf R}^n \rightarrow {\bf R}^m
+\f]
+where \f$ n \f$ is the number of independent variables
+and \f$ m \f$ is the number of dependent variables.
+The object \a play is effectly constant.
+It is not declared const because while playing back the tape
+the object \a play holds information about the currentl location
+with in the tape and this changes during playback.
+
+\param cap_order
+For i = 1 , ... , \a numvar - 1,
+the zero order Taylor coefficient for the variable with index i
+is <code>taylor[ i * cap_order + 0 ]</code>.
+
+\param taylor
+contains the zero order Taylor coefficients for all the variables.
+
+\param cskip_op
+Is a vector with size \a play->num_op_rec().
+If <code>cskip_op[i]</code> is true, the operator with index i
+does not affect any of the dependent variable
+(given the value of the independent variables).
+
+\param push
+is the object used to eliminate each of the results.
+
+\return
+The return value is false if the tape contains an operation
+that is not supported by this sweep
+(VecAD and atomic function operations).
+*/
+template <class Base, class Push>
+bool RevLocalSweep(
+	size_t                                  n,
+	size_t                                  numvar,
+	player<Base>*                           play,
+	size_t                                  cap_order,
+	const Base*                             taylor,
+	const bool*                             cskip_op,
+	Push&                                   push
+)
+{
+	OpCode           op;
+	size_t         i_op;
+	size_t        i_var;
+
+	const addr_t*   arg = CPPAD_NULL;
+
+	// check numvar argument
+	CPPAD_ASSERT_UNKNOWN( play->num_var_rec() == numvar );
+	CPPAD_ASSERT_UNKNOWN( numvar > 0 );
+
+	// length of the parameter vector (used by CppAD assert macros)
+	const size_t num_par = play->num_par_rec();
+
+	// pointer to the beginning of the parameter vector
+	const Base* parameter = CPPAD_NULL;
+	if( num_par > 0 )
+		parameter = play->GetPar();
+
+	// argument indices, first and second partials for current operation
+	size_t        nx;
+	size_t        xv[2];
+	Base          d[2];
+	Base          h[4];
+	bool          linear;
+	const size_t* xp;
+	const Base*   dp;
+	pod_vector<size_t> csum_x;
+	pod_vector<Base>   csum_d;
+
+	// some constants
+	const Base zero(0);
+	const Base one(1);
+	const Base two(2);
+
+	// Initialize
+	play->reverse_start(op, arg, i_op, i_var);
+	CPPAD_ASSERT_UNKNOWN( op == EndOp );
+	bool more_operators = true;
+	while(more_operators)
+	{	// next op
+		play->reverse_next(op, arg, i_op, i_var);
+		CPPAD_ASSERT_UNKNOWN((i_op >  n) | (op == InvOp) | (op == BeginOp));
+		CPPAD_ASSERT_UNKNOWN((i_op <= n) | (op != InvOp) | (op != BeginOp));
+
+		// check if we are skipping this operation
+		while( cskip_op[i_op] )
+		{	if( op == CSumOp )
+			{	// CSumOp has a variable number of arguments
+				play->reverse_csum(op, arg, i_op, i_var);
+			}
+			CPPAD_ASSERT_UNKNOWN( op != CSkipOp );
+			play->reverse_next(op, arg, i_op, i_var);
+		}
+
+		// value of the result and the first two arguments
+		// (only used when they are variables)
+		Base z  = taylor[ i_var * cap_order ];
+		Base x0 = zero, x1 = zero;
+
+		nx     = 0;
+		xp     = xv;
+		dp     = d;
+		linear = true;
+		switch( op )
+		{
+			// ---------------------------------------------------------
+			// operations with no variable arguments
+			case BeginOp:
+			CPPAD_ASSERT_NARG_NRES(op, 1, 1);
+			more_operators = false;
+			break;
+
+			case CSkipOp:
+			// CSkipOp has a variable number of arguments and
+			// reverse_next thinks it one has one argument.
+			play->reverse_cskip(op, arg, i_op, i_var);
+			break;
+
+			case DisOp:
+			// derivative of a discrete function is zero
+			case SignOp:
+			// derivative of sign is zero
+			case ParOp:
+			case InvOp:
+			case PriOp:
+			case EqpvOp:
+			case EqvvOp:
+			case LtpvOp:
+			case LtvpOp:
+			case LtvvOp:
+			case LepvOp:
+			case LevpOp:
+			case LevvOp:
+			case NepvOp:
+			case NevvOp:
+			break;
+
+			// ---------------------------------------------------------
+			// operations that are not supported by this sweep
+			case LdpOp:
+			case LdvOp:
+			case StppOp:
+			case StpvOp:
+			case StvpOp:
+			case StvvOp:
+			case UserOp:
+			case UsrapOp:
+			case UsravOp:
+			case UsrrpOp:
+			case UsrrvOp:
+			return false;
+
+			// ---------------------------------------------------------
+			// linear operations
+			case AddvvOp:
+			nx    = 2;
+			xv[0] = arg[0]; d[0] = one;
+			xv[1] = arg[1]; d[1] = one;
+			break;
+
+			case SubvvOp:
+			nx    = 2;
+			xv[0] = arg[0]; d[0] = one;
+			xv[1] = arg[1]; d[1] = - one;
+			break;
+
+			case AddpvOp:
+			nx    = 1;
+			xv[0] = arg[1]; d[0] = one;
+			break;
+
+			case SubpvOp:
+			nx    = 1;
+			xv[0] = arg[1]; d[0] = - one;
+			break;
+
+			case SubvpOp:
+			nx    = 1;
+			xv[0] = arg[0]; d[0] = one;
+			break;
+
+			case MulpvOp:
+			CPPAD_ASSERT_UNKNOWN( size_t(arg[0]) < num_par );
+			nx    = 1;
+			xv[0] = arg[1]; d[0] = parameter[ arg[0] ];
+			break;
+
+			case DivvpOp:
+			CPPAD_ASSERT_UNKNOWN( size_t(arg[1]) < num_par );
+			nx    = 1;
+			xv[0] = arg[0]; d[0] = one / parameter[ arg[1] ];
+			break;
+
+			case CSumOp:
+			// CSumOp has a variable number of arguments and
+			// reverse_next thinks it one has one argument.
+			play->reverse_csum(op, arg, i_op, i_var);
+			{	size_t n_add = arg[0];
+				size_t n_sub = arg[1];
+				csum_x.erase();
+				csum_d.erase();
+				csum_x.extend(n_add + n_sub);
+				csum_d.extend(n_add + n_sub);
+				for(size_t j = 0; j < n_add + n_sub; j++)
+				{	csum_x[j] = arg[3 + j];
+					csum_d[j] = j < n_add ? one : - one;
+				}
+				nx = n_add + n_sub;
+				xp = csum_x.data();
+				dp = csum_d.data();
+			}
+			break;
+
+			case CExpOp:
+			{	// result is equal to one of the two cases
+				Base left, right;
+				if( arg[1] & 1 )
+					left = taylor[ arg[2] * cap_order ];
+				else
+					left = parameter[ arg[2] ];
+				if( arg[1] & 2 )
+					right = taylor[ arg[3] * cap_order ];
+				else
+					right = parameter[ arg[3] ];
+				if( arg[1] & 4 )
+				{	xv[nx] = arg[4];
+					d[nx++] = CondExpOp(
+						CompareOp( arg[0] ), left, right, one, zero
+					);
+				}
+				if( arg[1] & 8 )
+				{	xv[nx] = arg[5];
+					d[nx++] = CondExpOp(
+						CompareOp( arg[0] ), left, right, zero, one
+					);
+				}
+			}
+			break;
+
+			// ---------------------------------------------------------
+			// binary operations with non-zero second partials
+			case MulvvOp:
+			nx     = 2;
+			linear = false;
+			xv[0]  = arg[0]; x0 = taylor[ arg[0] * cap_order ];
+			xv[1]  = arg[1]; x1 = taylor[ arg[1] * cap_order ];
+			d[0]   = x1;
+			d[1]   = x0;
+			h[0]   = zero;  h[1] = one;
+			h[2]   = one;   h[3] = zero;
+			break;
+
+			case DivvvOp:
+			nx     = 2;
+			linear = false;
+			xv[0]  = arg[0];
+			xv[1]  = arg[1]; x1 = taylor[ arg[1] * cap_order ];
+			d[0]   = one / x1;
+			d[1]   = - z / x1;
+			h[0]   = zero;
+			h[1]   = - one / (x1 * x1);
+			h[2]   = h[1];
+			h[3]   = two * z / (x1 * x1);
+			break;
+
+			case PowvvOp:
+			nx     = 2;
+			linear = false;
+			xv[0]  = arg[0]; x0 = taylor[ arg[0] * cap_order ];
+			xv[1]  = arg[1]; x1 = taylor[ arg[1] * cap_order ];
+			{	Base log_x0 = log(x0);
+				Base pow_1  = pow(x0, x1 - one);
+				d[0] = x1 * pow_1;
+				d[1] = z * log_x0;
+				h[0] = x1 * (x1 - one) * pow(x0, x1 - two);
+				h[1] = pow_1 * (one + x1 * log_x0);
+				h[2] = h[1];
+				h[3] = z * log_x0 * log_x0;
+			}
+			break;
+
+			// ---------------------------------------------------------
+			// unary operations with non-zero second partials
+			default:
+			nx     = 1;
+			linear = false;
+			xv[0]  = arg[0];
+			x0     = taylor[ arg[0] * cap_order ];
+			switch( op )
+			{
+				case AbsOp:
+				d[0] = sign(x0);
+				h[0] = zero;
+				break;
+
+				case AcosOp:
+				d[0] = - one / sqrt(one - x0 * x0);
+				h[0] = d[0] * x0 / (one - x0 * x0);
+				break;
+
+				case AsinOp:
+				d[0] = one / sqrt(one - x0 * x0);
+				h[0] = d[0] * x0 / (one - x0 * x0);
+				break;
+
+				case AtanOp:
+				d[0] = one / (one + x0 * x0);
+				h[0] = - two * x0 * d[0] * d[0];
+				break;
+
+				case CosOp:
+				d[0] = - sin(x0);
+				h[0] = - cos(x0);
+				break;
+
+				case CoshOp:
+				d[0] = sinh(x0);
+				h[0] = cosh(x0);
+				break;
+
+				case DivpvOp:
+				CPPAD_ASSERT_UNKNOWN( size_t(arg[0]) < num_par );
+				xv[0] = arg[1];
+				x0    = taylor[ arg[1] * cap_order ];
+				d[0]  = - z / x0;
+				h[0]  = two * z / (x0 * x0);
+				break;
+
+# if CPPAD_COMPILER_HAS_ERF
+				case ErfOp:
+				d[0] = parameter[ arg[2] ] * exp( - x0 * x0 );
+				h[0] = - two * x0 * d[0];
+				break;
+# endif
+
+				case ExpOp:
+				d[0] = z;
+				h[0] = z;
+				break;
+
+				case LogOp:
+				d[0] = one / x0;
+				h[0] = - d[0] * d[0];
+				break;
+
+				case PowpvOp:
+				CPPAD_ASSERT_UNKNOWN( size_t(arg[0]) < num_par );
+				xv[0] = arg[1];
+				{	Base log_p = log( parameter[ arg[0] ] );
+					d[0] = z * log_p;
+					h[0] = d[0] * log_p;
+				}
+				break;
+
+				case PowvpOp:
+				CPPAD_ASSERT_UNKNOWN( size_t(arg[1]) < num_par );
+				{	Base p = parameter[ arg[1] ];
+					d[0] = p * pow(x0, p - one);
+					h[0] = p * (p - one) * pow(x0, p - two);
+				}
+				break;
+
+				case SinOp:
+				d[0] = cos(x0);
+				h[0] = - sin(x0);
+				break;
+
+				case SinhOp:
+				d[0] = cosh(x0);
+				h[0] = sinh(x0);
+				break;
+
+				case SqrtOp:
+				d[0] = one / (two * z);
+				h[0] = - d[0] / (two * z * z);
+				break;
+
+				case TanOp:
+				d[0] = one + z * z;
+				h[0] = two * z * d[0];
+				break;
+
+				case TanhOp:
+				d[0] = one - z * z;
+				h[0] = - two * z * d[0];
+				break;
+
+				default:
+				CPPAD_ASSERT_UNKNOWN(false);
+			}
+		}
+		// eliminate the result of this operation
+		// (independent variables are not eliminated)
+		if( NumRes(op) > 0 && op != InvOp && op != BeginOp )
+		{	const Base* hp = CPPAD_NULL;
+			if( ! linear )
+				hp = h;
+			push(i_var, nx, xp, dp, hp);
+		}
+	}
+	return true;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
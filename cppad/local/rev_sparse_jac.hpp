@@ -286,13 +286,17 @@ void RevSparseJacBool(
 	var_sparsity.resize(total_num_var, q);
 
 	// The sparsity pattern corresponding to the dependent variables
+	// (access r in the order it is stored)
 	for(i = 0; i < m; i++)
-	{	CPPAD_ASSERT_UNKNOWN( dep_taddr[i] < total_num_var );
-		if( transpose )
-		{	for(j = 0; j < q; j++) if( r[ j * m + i ] )
+		CPPAD_ASSERT_UNKNOWN( dep_taddr[i] < total_num_var );
+	if( transpose )
+	{	for(j = 0; j < q; j++)
+		{	for(i = 0; i < m; i++) if( r[ j * m + i ] )
 				var_sparsity.add_element( dep_taddr[i], j );
 		}
-		else
+	}
+	else
+	{	for(i = 0; i < m; i++)
 		{	for(j = 0; j < q; j++) if( r[ i * q + j ] )
 				var_sparsity.add_element( dep_taddr[i], j );
 		}
@@ -308,7 +312,10 @@ void RevSparseJacBool(
 	);
 
 	// return values corresponding to dependent variables
+	// (set all of s to false in the order it is stored)
 	CPPAD_ASSERT_UNKNOWN( size_t(s.size()) == q * n );
+	for(i = 0; i < q * n; i++)
+		s[i] = false;
 	for(j = 0; j < n; j++)
 	{	CPPAD_ASSERT_UNKNOWN( ind_taddr[j] == (j+1) );
 
@@ -316,14 +323,6 @@ void RevSparseJacBool(
 		CPPAD_ASSERT_UNKNOWN( play.GetOp( ind_taddr[j] ) == InvOp );
 
 		// extract the result from var_sparsity
-		if( transpose )
-		{	for(i = 0; i < q; i++)
-				s[ j * q + i ] = false;
-		}
-		else
-		{	for(i = 0; i < q; i++) 
-				s[ i * n + j ] = false;
-		}
 		CPPAD_ASSERT_UNKNOWN( var_sparsity.end() == q );
 		var_sparsity.begin(j+1);
 		i = var_sparsity.next_element();
@@ -0,0 +1,310 @@
+/* $Id$ */
+# ifndef CPPAD_REV_VEC_SWEEP_INCLUDED
+# define CPPAD_REV_VEC_SWEEP_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/local/rev_local_sweep.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file rev_vec_sweep.hpp
+Compute first order reverse mode for multiple weight vectors,
+and second order reverse mode for multiple forward directions,
+using one reverse sweep.
+*/
+
+/*!
+Eliminates result variables for first order reverse mode with
+multiple weight vectors (used as the Push class for RevLocalSweep).
+
+\tparam Base
+is the type used for the derivative values.
+*/
+template <class Base>
+class rev_vec_push {
+private:
+	/// number of weight vectors
+	const size_t r_;
+	/// partial with respect to each variable for each weight vector
+	Base*        partial_;
+public:
+	/// constructor
+	rev_vec_push(size_t r, Base* partial)
+	: r_(r), partial_(partial)
+	{ }
+	/*!
+	Eliminate one result variable.
+
+	The arguments \a i_z, \a nx, \a x and \a d
+	are the same as for rev_edge_push::operator().
+	The last argument (the second order partials) is not used.
+
+	For ell = 0 , ... , r_ - 1, the partial
+	<code>partial_[ i_z * r_ + ell ]</code> times <code>d[j]</code>
+	is added to <code>partial_[ x[j] * r_ + ell ]</code>.
+	*/
+	void operator()(
+		size_t                                 i_z     ,
+		size_t                                 nx      ,
+		const size_t*                          x       ,
+		const Base*                            d       ,
+		const Base*                                    )
+	{	const Base* pz = partial_ + i_z * r_;
+		size_t j, ell;
+		for(j = 0; j < nx; j++) if( ! IdenticalZero(d[j]) )
+		{	Base* px = partial_ + x[j] * r_;
+			for(ell = 0; ell < r_; ell++)
+				px[ell] += d[j] * pz[ell];
+		}
+	}
+};
+
+/*!
+Compute first order reverse mode for multiple weight vectors
+using one reverse sweep.
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD< \a Base > and computations by this routine are done using type
+\a Base.
+
+\param n
+is the number of independent variables on the tape.
+
+\param numvar
+is the total number of variables on the tape; i.e.,
+\a play->num_var_rec().
+
+\param play
+is the recording of the operations (see RevLocalSweep).
+
+\param cap_order
+For i = 1 , ... , \a numvar - 1,
+the zero order Taylor coefficient for the variable with index i
+is <code>taylor[ i * cap_order + 0 ]</code>.
+
+\param taylor
+contains the zero order Taylor coefficients for all the variables.
+
+\param cskip_op
+Is a vector with size \a play->num_op_rec().
+If <code>cskip_op[i]</code> is true, the operator with index i
+does not affect any of the dependent variable
+(given the value of the independent variables).
+
+\param r
+is the number of weight vectors.
+
+\param partial
+This vector has size <code>numvar * r</code>.
+\n
+\n
+\b Input:
+For i = 0 , ... , \a numvar - 1, ell = 0 , ... , r - 1,
+<code>partial[ i * r + ell ]</code> is the weight for the variable
+with index i in the ell-th weight vector
+(it is zero unless the variable is a dependent variable).
+\n
+\n
+\b Output:
+For j = 1 , ... , \a n, ell = 0 , ... , r - 1,
+<code>partial[ j * r + ell ]</code>
+is the partial of the ell-th weighted sum of the dependent variables
+with respect to the independent variable with index (j-1).
+The values in the rest of \a partial are not specified.
+
+\return
+The return value is false if the tape contains an operation
+that is not supported by this sweep
+(VecAD and atomic function operations).
+In this case the values in \a partial are not specified.
+*/
+template <class Base>
+bool RevVecSweep(
+	size_t                                  n,
+	size_t                                  numvar,
+	player<Base>*                           play,
+	size_t                                  cap_order,
+	const Base*                             taylor,
+	const bool*                             cskip_op,
+	size_t                                  r,
+	Base*                                   partial
+)
+{	rev_vec_push<Base> push(r, partial);
+	return RevLocalSweep(n, numvar, play, cap_order, taylor, cskip_op, push);
+}
+
+/*!
+Eliminates result variables for second order reverse mode with
+multiple first order forward directions
+(used as the Push class for RevLocalSweep).
+
+\tparam Base
+is the type used for the derivative values.
+*/
+template <class Base>
+class rev_vec_hes_push {
+private:
+	/// number of forward directions
+	const size_t r_;
+	/// Taylor coefficient stride for each variable
+	const size_t cap_order_;
+	/// first order Taylor coefficients for each variable and direction
+	const Base*  taylor_;
+	/// first order partial with respect to each variable
+	Base*        adjoint_;
+	/// partial of adjoint_ with respect to each direction
+	Base*        partial_;
+public:
+	/// constructor
+	rev_vec_hes_push(
+		size_t      r         ,
+		size_t      cap_order ,
+		const Base* taylor    ,
+		Base*       adjoint   ,
+		Base*       partial   )
+	: r_(r)
+	, cap_order_(cap_order)
+	, taylor_(taylor)
+	, adjoint_(adjoint)
+	, partial_(partial)
+	{ }
+	/*!
+	Eliminate one result variable.
+
+	The arguments \a i_z, \a nx, \a x, \a d and \a h
+	are the same as for rev_edge_push::operator().
+
+	The first order partial <code>adjoint_[i_z]</code> times
+	<code>d[j]</code> is added to <code>adjoint_[ x[j] ]</code>.
+	For ell = 0 , ... , r_ - 1, the derivative of this product
+	in the ell-th forward direction is added to
+	<code>partial_[ x[j] * r_ + ell ]</code>.
+	*/
+	void operator()(
+		size_t                                 i_z     ,
+		size_t                                 nx      ,
+		const size_t*                          x       ,
+		const Base*                            d       ,
+		const Base*                            h       )
+	{	const Base* pz = partial_ + i_z * r_;
+		Base        a_z = adjoint_[i_z];
+		size_t j, k, ell;
+		for(j = 0; j < nx; j++) if( ! IdenticalZero(d[j]) )
+		{	Base* px = partial_ + x[j] * r_;
+			for(ell = 0; ell < r_; ell++)
+				px[ell] += d[j] * pz[ell];
+			adjoint_[ x[j] ] += a_z * d[j];
+		}
+		if( h == CPPAD_NULL || IdenticalZero(a_z) )
+			return;
+		for(j = 0; j < nx; j++)
+		{	Base* px = partial_ + x[j] * r_;
+			for(k = 0; k < nx; k++)
+			{	Base v = a_z * h[ j * nx + k ];
+				if( ! IdenticalZero(v) )
+				{	// first order coefficients for x[k]
+					const Base* tk = taylor_ + x[k] * cap_order_ + 1;
+					for(ell = 0; ell < r_; ell++)
+						px[ell] += v * tk[ell];
+				}
+			}
+		}
+	}
+};
+
+/*!
+Compute second order reverse mode for multiple first order forward
+directions using one reverse sweep.
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD< \a Base > and computations by this routine are done using type
+\a Base.
+
+\param n
+is the number of independent variables on the tape.
+
+\param numvar
+is the total number of variables on the tape; i.e.,
+\a play->num_var_rec().
+
+\param play
+is the recording of the operations (see RevLocalSweep).
+
+\param cap_order
+For i = 1 , ... , \a numvar - 1,
+the zero order Taylor coefficient for the variable with index i
+is <code>taylor[ i * cap_order + 0 ]</code>
+and its first order coefficient in the ell-th direction is
+<code>taylor[ i * cap_order + 1 + ell ]</code>.
+
+\param taylor
+contains the zero and first order Taylor coefficients for all the
+variables (computed by <code>Forward(1, r, xq)</code>).
+
+\param cskip_op
+Is a vector with size \a play->num_op_rec().
+If <code>cskip_op[i]</code> is true, the operator with index i
+does not affect any of the dependent variable
+(given the value of the independent variables).
+
+\param r
+is the number of forward directions.
+
+\param adjoint
+This vector has size \a numvar.
+On input, <code>adjoint[i]</code> is the weight for the variable
+with index i (it is zero unless the variable is a dependent variable).
+On output, the values in \a adjoint are not specified.
+
+\param partial
+This vector has size <code>numvar * r</code>.
+\n
+\n
+\b Input:
+All of its elements are zero.
+\n
+\n
+\b Output:
+For j = 1 , ... , \a n, ell = 0 , ... , r - 1,
+<code>partial[ j * r + ell ]</code> is the derivative, in the ell-th
+forward direction, of the partial of the weighted sum of the dependent
+variables with respect to the independent variable with index (j-1);
+i.e., the Hessian of the weighted sum times the ell-th direction.
+The values in the rest of \a partial are not specified.
+
+\return
+The return value is false if the tape contains an operation
+that is not supported by this sweep
+(VecAD and atomic function operations).
+In this case the values in \a partial are not specified.
+*/
+template <class Base>
+bool RevVecHesSweep(
+	size_t                                  n,
+	size_t                                  numvar,
+	player<Base>*                           play,
+	size_t                                  cap_order,
+	const Base*                             taylor,
+	const bool*                             cskip_op,
+	size_t                                  r,
+	Base*                                   adjoint,
+	Base*                                   partial
+)
+{	rev_vec_hes_push<Base> push(r, cap_order, taylor, adjoint, partial);
+	return RevLocalSweep(n, numvar, play, cap_order, taylor, cskip_op, push);
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -3,7 +3,7 @@
 # define CPPAD_REVERSE_INCLUDED
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -161,7 +161,13 @@ VectorBase ADFun<Base>::Reverse(size_t q, const VectorBase &w)
 	// evaluate the derivatives
 	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
 	CPPAD_ASSERT_UNKNOWN( load_op_.size()  == play_.num_load_op_rec() );
-	ReverseSweep(
+	// use level schedule when parallel mode is on and it is supported
+	bool done = false;
+	if( (q == 1) & par_sweep_.active() ) done = par_sweep_.reverse1(
+		&play_, n, cap_order_taylor_, taylor_.data(), cskip_op_.data(),
+		Partial.data()
+	);
+	if( ! done ) ReverseSweep(
 		q - 1,
 		n,
 		num_var_tape_,
@@ -203,7 +209,146 @@ VectorBase ADFun<Base>::Reverse(size_t q, const VectorBase &w)
 
 	return value;
 }
-	
+
+/*!
+First order reverse mode for multiple weight vectors.
+
+The function \f$ W_\ell : {\rm R}^n \rightarrow {\rm R} \f$ is defined by
+\f[
+W_\ell (x) = \sum_{i=0}^{m-1} w [ i * r + \ell ] F_i (x)
+\f]
+for \f$ \ell = 0 , \ldots , r-1 \f$.
+
+\tparam Base
+base type for the operator; i.e., this operation sequence was recorded
+using AD< \a Base > and computations by this routine are done using type
+\a Base.
+
+\tparam VectorBase
+is a Simple Vector class with elements of type \a Base.
+
+\param q
+is the order of the Taylor coefficients that are being differentiated
+(plus one). It must be equal to one.
+
+\param r
+is the number of weight vectors. It must be greater than zero.
+
+\param w
+is the weighting for the dependent variables and has size <tt>m * r</tt>.
+
+\return
+Is a vector \f$ dw \f$ such that
+for \f$ j = 0 , \ldots , n-1 \f$ and
+\f$ \ell = 0 , \ldots , r-1 \f$
+\f[
+	dw[ j * r + \ell ] = W_\ell^{(1)} ( x )_j
+\f]
+where \f$ x \f$ is the argument for the previous call to
+<code>Forward(0, x)</code>.
+If the operation sequence does not contain VecAD or atomic operations,
+all the weight vectors are carried by one reverse sweep
+(see RevVecSweep). Otherwise one first order reverse sweep is used
+for each weight vector.
+*/
+template <typename Base>
+template <typename VectorBase>
+VectorBase ADFun<Base>::Reverse(size_t q, size_t r, const VectorBase &w)
+{	// constants
+	const Base zero(0);
+
+	// temporary indices
+	size_t i, j, ell;
+
+	// number of independent variables
+	size_t n = ind_taddr_.size();
+
+	// number of dependent variables
+	size_t m = dep_taddr_.size();
+
+	// check VectorBase is Simple Vector class with Base type elements
+	CheckSimpleVector<Base, VectorBase>();
+
+	CPPAD_ASSERT_KNOWN(
+		q == 1,
+		"Reverse(q, r, w): q is not equal to one."
+	);
+	CPPAD_ASSERT_KNOWN(
+		r > 0,
+		"Reverse(q, r, w): r is not greater than zero."
+	);
+	CPPAD_ASSERT_KNOWN(
+		size_t(w.size()) == m * r,
+		"Reverse(q, r, w): size of w is not equal to r times\n"
+		"the dimension of the range for the corresponding ADFun."
+	);
+	CPPAD_ASSERT_KNOWN(
+		num_order_taylor_ >= 1,
+		"Reverse(q, r, w): no zero order taylor_ coefficients are\n"
+		"currently stored in this ADFun object."
+	);
+
+	// initialize entire Partial matrix to zero
+	pod_vector<Base> Partial;
+	Partial.extend(num_var_tape_  * r);
+	for(i = 0; i < num_var_tape_ * r; i++)
+		Partial[i] = zero;
+
+	// set the dependent variable weights
+	// (use += because two dependent variables can point to same location)
+	for(i = 0; i < m; i++)
+	{	CPPAD_ASSERT_UNKNOWN( dep_taddr_[i] < num_var_tape_  );
+		for(ell = 0; ell < r; ell++)
+			Partial[ dep_taddr_[i] * r + ell ] += w[i * r + ell];
+	}
+
+	// zero order Taylor coefficient for variable i is taylor_[i * c]
+	size_t c = (cap_order_taylor_ - 1) * num_direction_taylor_ + 1;
+
+	// evaluate the derivatives
+	CPPAD_ASSERT_UNKNOWN( cskip_op_.size() == play_.num_op_rec() );
+	bool ok = RevVecSweep(
+		n,
+		num_var_tape_,
+		&play_,
+		c,
+		taylor_.data(),
+		cskip_op_.data(),
+		r,
+		Partial.data()
+	);
+
+	VectorBase value(n * r);
+	if( ! ok )
+	{	// one reverse sweep for each weight vector
+		VectorBase w1(m), dw1(n);
+		for(ell = 0; ell < r; ell++)
+		{	for(i = 0; i < m; i++)
+				w1[i] = w[i * r + ell];
+			dw1 = Reverse(1, w1);
+			for(j = 0; j < n; j++)
+				value[j * r + ell] = dw1[j];
+		}
+		return value;
+	}
+
+	// return the derivative values
+	for(j = 0; j < n; j++)
+	{	CPPAD_ASSERT_UNKNOWN( ind_taddr_[j] < num_var_tape_  );
+
+		// independent variable taddr equals its operator taddr
+		CPPAD_ASSERT_UNKNOWN( play_.GetOp( ind_taddr_[j] ) == InvOp );
+
+		for(ell = 0; ell < r; ell++)
+			value[j * r + ell] = Partial[ind_taddr_[j] * r + ell];
+	}
+	CPPAD_ASSERT_KNOWN( ! ( hasnan(value) && check_for_nan_ ) ,
+		"dw = f.Reverse(q, r, w): has a nan,\n"
+		"but none of its Taylor coefficents are nan."
+	);
+
+	return value;
+}
 
 } // END_CPPAD_NAMESPACE
 # endif
@@ -16,6 +16,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 /*
 $begin sparse_hessian$$
 $spell
+	acyclic
 	jacobian
 	recomputed
 	CppAD
@@ -199,6 +200,41 @@ is symmetric to find a coloring that requires fewer
 $cref/sweeps/sparse_hessian/n_sweep/$$.
 $codei%
 
+"cppad.star"
+%$$
+This is a star coloring of the rows that appear in
+$icode row$$ or $icode col$$; i.e.,
+every path of four rows, where each row is connected to the next by
+a possibly non-zero entry, uses at least three colors.
+Each requested entry is directly equal to a value computed by one sweep.
+$codei%
+
+"cppad.acyclic"
+%$$
+This is an acyclic coloring of the rows that appear in
+$icode row$$ or $icode col$$; i.e.,
+every cycle of rows, where each row is connected to the next by
+a possibly non-zero entry, uses at least three colors.
+This usually requires fewer sweeps than the star coloring.
+The requested entries are recovered from the values computed by the sweeps
+by substitution (which requires a subtraction for some of the
+possibly non-zero entries).
+$codei%
+
+"cppad.edge"
+%$$
+This method does not use a coloring.
+The Hessian is computed during one reverse sweep of the operation sequence.
+This sweep pushes the second order partials for the result of each
+operation to the arguments of the operation
+(this is sometimes referred to as edge pushing).
+The sparsity pattern $icode p$$ is not used,
+unless the operation sequence contains $cref VecAD$$ or $cref atomic$$
+operations (which are not supported by this method).
+In this case $icode%work%.color_method%$$ is changed to
+$code "cppad.symmetric"$$ and that method is used instead.
+$codei%
+
 "cppad.general"
 %$$
 This is the same as the $code "cppad"$$ method for the
@@ -225,6 +261,10 @@ This is proportional to the total work that $code SparseHessian$$ does,
 not counting the zero order forward sweep,
 or the work to combine multiple columns into a single
 forward-reverse sweep pair.
+If the $code "cppad.edge"$$ method is used, $icode n_sweep$$ is one
+and there is no forward sweep
+(the work for the reverse sweep depends on the number of
+second order partials that are pushed during the sweep).
 
 $head VectorBase$$
 The type $icode VectorBase$$ must be a $cref SimpleVector$$ class with
@@ -308,12 +348,25 @@ class sparse_hessian_work {
 		std::string color_method;
 		/// row and column indicies for return values
 		/// (some may be reflected by star coloring algorithm)
+		/// or for compressed values (acyclic coloring algorithm)
 		CppAD::vector<size_t> row;
 		CppAD::vector<size_t> col;
+		/// compressed values subtracted during substitution
+		/// (acyclic coloring algorithm)
+		CppAD::vector<size_t> subs_from;
+		/// compressed values that are subtracted from during substitution
+		/// (acyclic coloring algorithm)
+		CppAD::vector<size_t> subs_to;
+		/// index in compressed values for each return value
+		/// (acyclic coloring algorithm)
+		CppAD::vector<size_t> subs_index;
 		/// indices that sort the user row and col arrays by color
 		CppAD::vector<size_t> order;
 		/// results of the coloring algorithm
 		CppAD::vector<size_t> color;
+		/// first index in order for each thread in the parallel mode
+		/// (followed by the size of order)
+		CppAD::vector<size_t> team_start;
 
 		/// constructor
 		sparse_hessian_work(void) : color_method("cppad.symmetric")
@@ -323,8 +376,12 @@ class sparse_hessian_work {
 		{	color_method = "cppad.symmetric";
 			row.clear();
 			col.clear();
+			subs_from.clear();
+			subs_to.clear();
+			subs_index.clear();
 			order.clear();
 			color.clear();
+			team_start.clear();
 		}
 };
 // ===========================================================================
@@ -418,8 +475,10 @@ size_t ADFun<Base>::SparseHessianCompute(
 
 	CPPAD_ASSERT_UNKNOWN( size_t(x.size()) == n );
 	CPPAD_ASSERT_UNKNOWN( color.size() == 0 || color.size() == n );
-	CPPAD_ASSERT_UNKNOWN( row.size() == 0   || row.size() == K );
-	CPPAD_ASSERT_UNKNOWN( col.size() == 0   || col.size() == K );
+	CPPAD_ASSERT_UNKNOWN( row.size() == col.size() );
+	CPPAD_ASSERT_UNKNOWN(
+		row.size() == 0 || row.size() == K || work.subs_index.size() == K
+	);
 
 
 	// Point at which we are evaluating the Hessian
@@ -429,6 +488,43 @@ size_t ADFun<Base>::SparseHessianCompute(
 	if( K == 0 )
 		return 0;
 
+	// edge pushing: one reverse sweep and no coloring
+	if( work.color_method == "cppad.edge" )
+	{	CPPAD_ASSERT_UNKNOWN( color.size() == 0 );
+		size_t m = Range();
+		CppAD::vector<Base> adjoint(num_var_tape_);
+		for(i = 0; i < num_var_tape_; i++)
+			adjoint[i] = zero;
+		for(i = 0; i < m; i++)
+			adjoint[ dep_taddr_[i] ] += w[i];
+		CppAD::vector< std::map<size_t, Base> > W(num_var_tape_);
+		bool edge = RevEdgeSweep(
+			n,
+			num_var_tape_,
+			&play_,
+			cap_order_taylor_,
+			taylor_.data(),
+			cskip_op_.data(),
+			adjoint.data(),
+			W
+		);
+		if( edge )
+		{	typename std::map<size_t, Base>::const_iterator itr;
+			for(k = 0; k < K; k++)
+			{	const std::map<size_t, Base>& W_row(
+					W[ ind_taddr_[ user_row[k] ] ]
+				);
+				itr    = W_row.find( ind_taddr_[ user_col[k] ] );
+				hes[k] = zero;
+				if( itr != W_row.end() )
+					hes[k] = itr->second;
+			}
+			return 1;
+		}
+		// the tape has operations that edge pushing does not support
+		work.color_method = "cppad.symmetric";
+	}
+
 	// Rows of the Hessian (i below) correspond to the forward mode index
 	// and columns (j below) correspond to the reverse mode index.
 	if( color.size() == 0 )
@@ -450,6 +546,12 @@ size_t ADFun<Base>::SparseHessianCompute(
 			color_general_cppad(sparsity, row, col, color);
 		else if( work.color_method == "cppad.symmetric" )
 			color_symmetric_cppad(sparsity, row, col, color);
+		else if( work.color_method == "cppad.star" )
+			color_symmetric_star(sparsity, row, col, color);
+		else if( work.color_method == "cppad.acyclic" )
+			color_symmetric_acyclic(sparsity, row, col, color,
+				work.subs_from, work.subs_to, work.subs_index
+			);
 		else if( work.color_method == "colpack.star" )
 		{
 # if CPPAD_HAS_COLPACK
@@ -470,12 +572,12 @@ size_t ADFun<Base>::SparseHessianCompute(
 		}
 
 		// put sorting indices in color order
-		VectorSize key(K);
-		order.resize(K);
-		for(k = 0; k < K; k++)
+		VectorSize key( row.size() );
+		order.resize( row.size() );
+		for(k = 0; k < row.size(); k++)
 			key[k] = color[ row[k] ];
 		index_sort(key, order);
-
+		work.team_start.clear();
 	}
 	size_t n_color = 1;
 	for(ell = 0; ell < n; ell++) if( color[ell] < n )
@@ -487,13 +589,26 @@ size_t ADFun<Base>::SparseHessianCompute(
 	// location for return values from reverse (columns of the Hessian)
 	VectorBase ddw(2 * n);
 
+	// values computed by the sweeps are the return values unless
+	// substitution is used to recover them (acyclic coloring)
+	bool substitute = work.subs_index.size() == K;
+	size_t n_value  = row.size();
+	VectorBase value( substitute ? n_value : 0 );
+	VectorBase& result( substitute ? value : hes );
+
 	// initialize the return value
-	for(k = 0; k < K; k++)
-		hes[k] = zero;
+	for(k = 0; k < n_value; k++)
+		result[k] = zero;
+
+	// split the colors among a team of threads in parallel mode
+	bool team = SparseTeam(
+		sparse_team_hes, 1,
+		w, color, row, col, order, work.team_start, result
+	);
 
 	// loop over colors
 	k = 0;
-	for(ell = 0; ell < n_color; ell++)
+	if( ! team ) for(ell = 0; ell < n_color; ell++)
 	{	CPPAD_ASSERT_UNKNOWN( color[ row[ order[k] ] ] == ell );
 
 		// combine all rows with this color
@@ -509,11 +624,19 @@ size_t ADFun<Base>::SparseHessianCompute(
 		ddw = Reverse(2, w);
 
 		// set the corresponding components of the result
-		while( k < K && color[ row[ order[k] ] ] == ell )
-		{	hes[ order[k] ] = ddw[ col[ order[k] ] * 2 + 1 ];
+		while( k < n_value && color[ row[ order[k] ] ] == ell )
+		{	result[ order[k] ] = ddw[ col[ order[k] ] * 2 + 1 ];
 			k++;
 		}
 	}
+
+	// recover the return values by substitution
+	if( substitute )
+	{	for(k = 0; k < work.subs_from.size(); k++)
+			value[ work.subs_to[k] ] -= value[ work.subs_from[k] ];
+		for(k = 0; k < K; k++)
+			hes[k] = value[ work.subs_index[k] ];
+	}
 	return n_color;
 }
 // ===========================================================================
@@ -0,0 +1,624 @@
+/* $Id$ */
+# ifndef CPPAD_SPARSE_HYBRID_INCLUDED
+# define CPPAD_SPARSE_HYBRID_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+# include <set>
+# include <limits>
+# include <cppad/local/cppad_assert.hpp>
+# include <cppad/local/pod_vector.hpp>
+# include <cppad/vector.hpp>
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file sparse_hybrid.hpp
+Vector of sets of positive integers, each set stored as a sorted list
+or as a packed array of bools (depending on its number of elements).
+*/
+
+/*!
+Vector of sets of positive integers, each set stored as a sorted list
+or as a packed array of bools.
+
+A set is stored as a packed array of bools if and only if it has more
+elements than the number of \c Pack values needed for the packed array;
+i.e., each set uses the representation that requires less memory.
+The representation is changed when elements are added to a set
+(\c add_element and \c binary_union) and when a set is replaced
+(\c assignment and \c clear).
+This is useful when most of the sets are very sparse and a few are dense.
+
+The union of two packed sets is computed one \c Pack value at a time,
+in a loop over contiguous memory that the compiler can vectorize.
+*/
+class sparse_hybrid {
+private:
+	/// Type used to pack elements (and to store the elements of a list)
+	typedef size_t Pack;
+	/// Number of bits per Pack value
+	static const size_t n_bit_ = std::numeric_limits<Pack>::digits;
+	/// Number of sets that we are representing
+	/// (set by constructor and resize).
+	size_t n_set_;
+	/// Possible elements in each set are 0, 1, ..., end_ - 1
+	/// (set by constructor and resize).
+	size_t end_;
+	/// Number of \c Pack values necessary to represent \c end_ bits.
+	/// This is also the maximum number of elements in a list
+	/// (set by constructor and resize).
+	size_t n_pack_;
+	/// For each set, either the sorted list of its elements,
+	/// or its \c n_pack_ packed values.
+	CppAD::vector< pod_vector<Pack> > data_;
+	/// For each set, is it stored as a packed array of bools.
+	pod_vector<bool> packed_;
+	/// Temporary vector used to compute unions.
+	pod_vector<Pack> temp_;
+	/// index for which we were retrieving next_element
+	/// (use n_set_ if no such index exists).
+	size_t next_index_;
+	/// If the set is a list, index in the list of the next element.
+	/// Otherwise, next element to start search at.
+	/// (use end_ for no such element exists; i.e., past end of the set).
+	size_t next_element_;
+	// -----------------------------------------------------------------
+	/*! Index in a list of the first element greater than or equal
+	a specified value.
+
+	\param list
+	is the sorted list.
+
+	\param element
+	is the value we are searching for.
+
+	\return
+	is the index of the first element in \a list that is greater than
+	or equal \a element (\c list.size() if there is no such element).
+	*/
+	static size_t lower_bound(const pod_vector<Pack>& list, size_t element)
+	{	size_t lo = 0;
+		size_t hi = list.size();
+		// check for the common case where element goes at the end
+		if( hi == 0 || list[hi - 1] < element )
+			return hi;
+		while( lo < hi )
+		{	size_t mid = (lo + hi) / 2;
+			if( list[mid] < element )
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo;
+	}
+	// -----------------------------------------------------------------
+	/*! Convert a sorted list to packed form.
+
+	\param list
+	is the sorted list of elements.
+
+	\param pack
+	The input value of this vector does not matter
+	(it must not be the same vector as \a list).
+	Upon return, it contains the \c n_pack_ packed values
+	corresponding to \a list.
+	*/
+	void list2pack(const pod_vector<Pack>& list, pod_vector<Pack>& pack)
+	{	static Pack one(1);
+		CPPAD_ASSERT_UNKNOWN( &list != &pack );
+		pack.erase();
+		pack.extend(n_pack_);
+		for(size_t j = 0; j < n_pack_; j++)
+			pack[j] = Pack(0);
+		for(size_t k = 0; k < list.size(); k++)
+		{	size_t j = list[k] / n_bit_;
+			pack[j] |= one << (list[k] - j * n_bit_);
+		}
+	}
+	// -----------------------------------------------------------------
+	/*! Copy a set to a target set.
+
+	\param target
+	is the index of the target set in this vector of sets.
+
+	\param value
+	is the value for the target set.
+
+	\param packed
+	is \a value a packed array of bools.
+	*/
+	void copy(size_t target, const pod_vector<Pack>& value, bool packed)
+	{	pod_vector<Pack>& row = data_[target];
+		// a packed array may have much more memory than a list needs
+		if( packed_[target] && ! packed )
+			row.free();
+		row              = value;
+		packed_[target]  = packed;
+	}
+public:
+	// -----------------------------------------------------------------
+	/*! Default constructor (no sets)
+	*/
+	sparse_hybrid(void) :
+	n_set_(0)                     ,
+	end_(0)                       ,
+	n_pack_(0)                    ,
+	next_index_(0)                ,
+	next_element_(0)
+	{	packed_.set_tag(thread_alloc::sparsity_tag);
+		temp_.set_tag(thread_alloc::sparsity_tag);
+	}
+	// -----------------------------------------------------------------
+	/*! Make use of copy constructor an error
+
+	\param v
+	vector that we are attempting to make a copy of.
+	*/
+	sparse_hybrid(const sparse_hybrid& v)
+	{	// Error:
+		// Probably a sparse_hybrid argument has been passed by value
+		CPPAD_ASSERT_UNKNOWN(false);
+	}
+	// -----------------------------------------------------------------
+	/*! Destructor
+	*/
+	~sparse_hybrid(void)
+	{ }
+	// -----------------------------------------------------------------
+	/*! Change number of sets, set end, and initialize all sets as empty
+
+	If \c n_set_in is zero, any memory currently allocated for this object
+	is freed. Otherwise, new memory may be allocated for the sets (if needed).
+
+	\param n_set_in
+	is the number of sets in this vector of sets.
+
+	\param end_in
+	is the maximum element plus one (the minimum element is 0).
+	*/
+	void resize(size_t n_set_in, size_t end_in)
+	{	n_set_          = n_set_in;
+		end_            = end_in;
+		if( n_set_ == 0 )
+		{	// free all memory connected with this object
+			data_.clear();
+			packed_.free();
+			temp_.free();
+			return;
+		}
+		// now start a new vector with empty sets
+		n_pack_         = (end_ + n_bit_ - 1) / n_bit_;
+		data_.resize(n_set_);
+		packed_.erase();
+		packed_.extend(n_set_);
+		for(size_t i = 0; i < n_set_; i++)
+		{	data_[i].set_tag(thread_alloc::sparsity_tag);
+			data_[i].erase();
+			packed_[i] = false;
+		}
+
+		// values that signify past end of list
+		next_index_   = n_set_;
+		next_element_ = end_;
+	}
+	// -----------------------------------------------------------------
+	/*! Add one element to a set.
+
+	\param index
+	is the index for this set in the vector of sets.
+
+	\param element
+	is the element we are adding to the set.
+
+	\par Checked Assertions
+	\li index    < n_set_
+	\li element  < end_
+	*/
+	void add_element(size_t index, size_t element)
+	{	static Pack one(1);
+		CPPAD_ASSERT_UNKNOWN( index   < n_set_ );
+		CPPAD_ASSERT_UNKNOWN( element < end_ );
+		pod_vector<Pack>& row = data_[index];
+
+		if( ! packed_[index] )
+		{	size_t n = row.size();
+			size_t k = lower_bound(row, element);
+			if( k < n && row[k] == element )
+				return;
+			if( n < n_pack_ )
+			{	// insert element in the list
+				row.extend(1);
+				while( n > k )
+				{	row[n] = row[n-1];
+					n--;
+				}
+				row[k] = element;
+				return;
+			}
+			// list would use more memory than packed array
+			temp_ = row;
+			list2pack(temp_, row);
+			packed_[index] = true;
+		}
+		size_t j  = element / n_bit_;
+		size_t k  = element - j * n_bit_;
+		row[j]   |= one << k;
+	}
+	// -----------------------------------------------------------------
+	/*! Is an element of a set.
+
+	\param index
+	is the index for this set in the vector of sets.
+
+	\param element
+	is the element we are checking to see if it is in the set.
+
+	\par Checked Assertions
+	\li index    < n_set_
+	\li element  < end_
+	*/
+	bool is_element(size_t index, size_t element)
+	{	static Pack one(1);
+		static Pack zero(0);
+		CPPAD_ASSERT_UNKNOWN( index   < n_set_ );
+		CPPAD_ASSERT_UNKNOWN( element < end_ );
+		const pod_vector<Pack>& row = data_[index];
+
+		if( ! packed_[index] )
+		{	size_t k = lower_bound(row, element);
+			return k < row.size() && row[k] == element;
+		}
+		size_t j  = element / n_bit_;
+		size_t k  = element - j * n_bit_;
+		return (row[j] & (one << k)) != zero;
+	}
+	// -----------------------------------------------------------------
+	/*! Begin retrieving elements from one of the sets.
+
+	\param index
+	is the index for the set that is going to be retrieved.
+	The elements of the set are retrieved in increasing order.
+
+	\par Checked Assertions
+	\li index  < n_set_
+	*/
+	void begin(size_t index)
+	{	// initialize element to search for in this set
+		CPPAD_ASSERT_UNKNOWN( index < n_set_ );
+		next_index_   = index;
+		next_element_ = 0;
+	}
+	// -----------------------------------------------------------------
+	/*! Get the next element from the current retrieval set.
+
+	\return
+	is the next element in the set with index
+	specified by the previous call to \c begin.
+	If no such element exists, \c this->end() is returned.
+	*/
+	size_t next_element(void)
+	{	CPPAD_ASSERT_UNKNOWN( next_index_ < n_set_ );
+		const pod_vector<Pack>& row = data_[next_index_];
+
+		if( ! packed_[next_index_] )
+		{	if( next_element_ == row.size() )
+				return end_;
+			return row[next_element_++];
+		}
+		if( next_element_ >= end_ )
+			return end_;
+
+		// packed value containing next_element_ (shifted so that
+		// its first bit corresponds to next_element_)
+		size_t j   = next_element_ / n_bit_;
+		Pack check = row[j] >> (next_element_ - j * n_bit_);
+
+		// skip packed values that have no elements
+		while( check == Pack(0) )
+		{	if( ++j == n_pack_ )
+			{	next_element_ = end_;
+				return end_;
+			}
+			check         = row[j];
+			next_element_ = j * n_bit_;
+		}
+		// find the first element in this packed value
+		while( (check & Pack(1)) == Pack(0) )
+		{	check >>= 1;
+			next_element_++;
+		}
+		CPPAD_ASSERT_UNKNOWN( next_element_ < end_ );
+		return next_element_++;
+	}
+	// -----------------------------------------------------------------
+	/*! Assign the empty set to one of the sets.
+
+	\param target
+	is the index of the set we are setting to the empty set.
+
+	\par Checked Assertions
+	\li target < n_set_
+	*/
+	void clear(size_t target)
+	{	CPPAD_ASSERT_UNKNOWN( target < n_set_ );
+		if( packed_[target] )
+			data_[target].free();
+		else
+			data_[target].erase();
+		packed_[target] = false;
+	}
+	// -----------------------------------------------------------------
+	/*! Assign one set equal to another set.
+
+	\param this_target
+	is the index (in this \c sparse_hybrid object) of the set being assinged.
+
+	\param other_value
+	is the index (in the other \c sparse_hybrid object) of the
+	that we are using as the value to assign to the target set.
+
+	\param other
+	is the other \c sparse_hybrid object (which may be the same as this
+	\c sparse_hybrid object).
+
+	\par Checked Assertions
+	\li this_target  < n_set_
+	\li other_value  < other.n_set_
+	\li n_pack_     == other.n_pack_
+	*/
+	void assignment(
+		size_t               this_target  ,
+		size_t               other_value  ,
+		const sparse_hybrid& other        )
+	{	CPPAD_ASSERT_UNKNOWN( this_target  <   n_set_        );
+		CPPAD_ASSERT_UNKNOWN( other_value  <   other.n_set_  );
+		CPPAD_ASSERT_UNKNOWN( n_pack_      ==  other.n_pack_ );
+
+		if( this == &other && this_target == other_value )
+			return;
+		copy(this_target, other.data_[other_value], other.packed_[other_value]);
+	}
+	// -----------------------------------------------------------------
+	/*! Assign a set equal to the union of two other sets.
+
+	\param this_target
+	is the index (in this \c sparse_hybrid object) of the set being assinged.
+
+	\param this_left
+	is the index (in this \c sparse_hybrid object) of the
+	left operand for the union operation.
+	It is OK for \a this_target and \a this_left to be the same value.
+
+	\param other_right
+	is the index (in the other \c sparse_hybrid object) of the
+	right operand for the union operation.
+	It is OK for \a this_target and \a other_right to be the same value.
+
+	\param other
+	is the other \c sparse_hybrid object (which may be the same as this
+	\c sparse_hybrid object).
+
+	\par Checked Assertions
+	\li this_target <  n_set_
+	\li this_left   <  n_set_
+	\li other_right <  other.n_set_
+	\li n_pack_     == other.n_pack_
+	*/
+	void binary_union(
+		size_t                  this_target  ,
+		size_t                  this_left    ,
+		size_t                  other_right  ,
+		const sparse_hybrid&    other        )
+	{	static Pack one(1);
+		CPPAD_ASSERT_UNKNOWN( this_target < n_set_         );
+		CPPAD_ASSERT_UNKNOWN( this_left   < n_set_         );
+		CPPAD_ASSERT_UNKNOWN( other_right < other.n_set_   );
+		CPPAD_ASSERT_UNKNOWN( n_pack_    ==  other.n_pack_ );
+
+		const pod_vector<Pack>& left  = data_[this_left];
+		const pod_vector<Pack>& right = other.data_[other_right];
+		bool left_packed              = packed_[this_left];
+		bool right_packed             = other.packed_[other_right];
+
+		// case where one of the operands is empty
+		if( right.size() == 0 )
+		{	assignment(this_target, this_left, *this);
+			return;
+		}
+		if( left.size() == 0 )
+		{	assignment(this_target, other_right, other);
+			return;
+		}
+
+		size_t j, k;
+		temp_.erase();
+		if( left_packed && right_packed )
+		{	// union of packed values (a loop the compiler can vectorize)
+			temp_.extend(n_pack_);
+			Pack*       t = temp_.data();
+			const Pack* l = left.data();
+			const Pack* r = right.data();
+			for(j = 0; j < n_pack_; j++)
+				t[j] = l[j] | r[j];
+		}
+		else if( left_packed || right_packed )
+		{	// add the elements of the list to the packed values
+			const pod_vector<Pack>& pack = left_packed ? left  : right;
+			const pod_vector<Pack>& list = left_packed ? right : left;
+			temp_ = pack;
+			for(k = 0; k < list.size(); k++)
+			{	j         = list[k] / n_bit_;
+				temp_[j] |= one << (list[k] - j * n_bit_);
+			}
+		}
+		else
+		{	// merge the two sorted lists
+			size_t n_left  = left.size();
+			size_t n_right = right.size();
+			size_t i_left  = 0;
+			size_t i_right = 0;
+			while( i_left < n_left || i_right < n_right )
+			{	Pack element;
+				if( i_right == n_right )
+					element = left[i_left++];
+				else if( i_left == n_left )
+					element = right[i_right++];
+				else if( left[i_left] < right[i_right] )
+					element = left[i_left++];
+				else if( right[i_right] < left[i_left] )
+					element = right[i_right++];
+				else
+				{	element = left[i_left++];
+					i_right++;
+				}
+				temp_[ temp_.extend(1) ] = element;
+			}
+			if( temp_.size() <= n_pack_ )
+			{	copy(this_target, temp_, false);
+				return;
+			}
+			// list would use more memory than packed array
+			list2pack(temp_, data_[this_target]);
+			packed_[this_target] = true;
+			return;
+		}
+		// move packed result to the target set without copying elements
+		data_[this_target].swap(temp_);
+		packed_[this_target] = true;
+	}
+	// -----------------------------------------------------------------
+	/*! Sum over all sets of the number of elements
+
+	\return
+	The the total number of elements
+	*/
+	size_t number_elements(void) const
+	{	size_t i, j, count;
+		count = 0;
+		for(i = 0; i < n_set_; i++)
+		{	const pod_vector<Pack>& row = data_[i];
+			if( ! packed_[i] )
+				count += row.size();
+			else for(j = 0; j < n_pack_; j++)
+			{	Pack check = row[j];
+				while( check != Pack(0) )
+				{	// remove the lowest bit that is set
+					check &= check - Pack(1);
+					count++;
+				}
+			}
+		}
+		return count;
+	}
+	// -----------------------------------------------------------------
+	/*! Amount of memory used by this vector of sets
+
+	\return
+	The amount of memory in units of type unsigned char memory.
+	*/
+	size_t memory(void) const
+	{	size_t count = temp_.capacity();
+		for(size_t i = 0; i < n_set_; i++)
+			count += data_[i].capacity();
+		return count * sizeof(Pack) + packed_.capacity() * sizeof(bool);
+	}
+	// -----------------------------------------------------------------
+	/*! Fetch n_set for vector of sets object.
+
+	\return
+	Number of from sets for this vector of sets object
+	*/
+	size_t n_set(void) const
+	{	return n_set_; }
+	// -----------------------------------------------------------------
+	/*! Fetch end for this vector of sets object.
+
+	\return
+	is the maximum element value plus one (the minimum element value is 0).
+	*/
+	size_t end(void) const
+	{	return end_; }
+};
+
+/*!
+Copy a user vector of sets sparsity pattern to an internal sparse_hybrid object.
+
+\tparam VectorSet
+is a simple vector with elements of type \c std::set<size_t>.
+
+\param internal
+The input value of sparisty does not matter.
+Upon return it contains the same sparsity pattern as \c user
+(or the transposed sparsity pattern).
+
+\param user
+sparsity pattern that we are placing \c internal.
+
+\param n_row
+number of rows in the sparsity pattern in \c user
+(range dimension).
+
+\param n_col
+number of columns in the sparsity pattern in \c user
+(domain dimension).
+
+\param transpose
+if true, the sparsity pattern in \c internal is the transpose
+of the one in \c user.
+Otherwise it is the same sparsity pattern.
+*/
+template<class VectorSet>
+void sparsity_user2internal(
+	sparse_hybrid&          internal  ,
+	const VectorSet&        user      ,
+	size_t                  n_row     ,
+	size_t                  n_col     ,
+	bool                    transpose )
+{	CPPAD_ASSERT_UNKNOWN( n_row == size_t(user.size()) );
+
+	CPPAD_ASSERT_KNOWN(
+		size_t( user.size() ) == n_row,
+		"Size of this vector of sets sparsity pattern is not equal "
+		"the range dimension for the corresponding function."
+	);
+
+	size_t i, j;
+	std::set<size_t>::const_iterator itr;
+
+	// transposed pattern case
+	if( transpose )
+	{	internal.resize(n_col, n_row);
+		for(i = 0; i < n_row; i++)
+		{	itr = user[i].begin();
+			while(itr != user[i].end())
+			{	j = *itr++;
+				CPPAD_ASSERT_UNKNOWN( j < n_col );
+				internal.add_element(j, i);
+			}
+		}
+		return;
+	}
+
+	// same pattern case
+	internal.resize(n_row, n_col);
+	for(i = 0; i < n_row; i++)
+	{	itr = user[i].begin();
+		while(itr != user[i].end())
+		{	j = *itr++;
+			CPPAD_ASSERT_UNKNOWN( j < n_col );
+			internal.add_element(i, j);
+		}
+	}
+	return;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -3,7 +3,7 @@
 # define CPPAD_SPARSE_JACOBIAN_INCLUDED
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -14,10 +14,13 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 
 // maximum number of sparse directions to compute at the same time
-
-// # define CPPAD_SPARSE_JACOBIAN_MAX_MULTIPLE_DIRECTION 1
+// (when work.max_direction is zero)
 # define CPPAD_SPARSE_JACOBIAN_MAX_MULTIPLE_DIRECTION 64
 
+// maximum number of first order Taylor coefficients, for all the variables
+// and directions, during one sweep (when work.max_direction is zero)
+# define CPPAD_SPARSE_JACOBIAN_MAX_MULTIPLE_TAYLOR 16777216
+
 /*
 $begin sparse_jacobian$$
 $spell
@@ -192,19 +195,40 @@ This value only matters on the first call to $code sparse_jacobian$$
 that follows the $icode work$$ constructor or a call to
 $icode%work%.clear()%$$.
 
+$subhead max_direction$$
+Forward mode computes the columns for several colors during the same
+first order sweep using
+$cref/multiple directions/forward_dir/$$.
+This field has prototype
+$codei%
+	size_t %work%.max_direction
+%$$
+and its default value (after a constructor or $code clear()$$) is zero.
+If it is not zero, it is the maximum number of colors computed
+during one sweep.
+If it is zero, this maximum is chosen automatically; it is 64,
+or less when the number of variables in $icode f$$ is so large that
+64 directions would require more than $latex 2^{24}$$
+first order Taylor coefficients.
+The colors are split evenly among the fewest sweeps that do not have
+more than this maximum number of colors.
+This value is not used by $code SparseJacobianReverse$$.
+
 $head n_sweep$$
 The return value $icode n_sweep$$ has prototype
 $codei%
 	size_t %n_sweep%
 %$$
 If $code SparseJacobianForward$$ ($code SparseJacobianReverse$$) is used, 
-$icode n_sweep$$ is the number of first order forward (reverse) sweeps 
-used to compute the requested Jacobian values. 
+$icode n_sweep$$ is the number of first order forward (reverse) 
+directions used to compute the requested Jacobian values. 
 (This is also the number of colors determined by the coloring method
 mentioned above).
 This is proportional to the total work that $code SparseJacobian$$ does, 
 not counting the zero order forward sweep, 
 or the work to combine multiple columns (rows) into a single sweep.
+(In forward mode, several directions are computed during each sweep;
+see $cref/max_direction/sparse_jacobian/work/max_direction/$$.)
 
 $head VectorBase$$
 The type $icode VectorBase$$ must be a $cref SimpleVector$$ class with
@@ -279,20 +303,28 @@ class sparse_jacobian_work {
 		/// Coloring method: "cppad", or "colpack"
 		/// (this field is set by user)
 		std::string color_method;
+		/// Maximum number of colors for one forward sweep,
+		/// zero for automatic (this field is set by user)
+		size_t max_direction;
 		/// indices that sort the user row and col arrays by color 
 		CppAD::vector<size_t> order;
 		/// results of the coloring algorithm
 		CppAD::vector<size_t> color;
+		/// first index in order for each thread in the parallel mode
+		/// (followed by the size of order)
+		CppAD::vector<size_t> team_start;
 	
 		/// constructor
-		sparse_jacobian_work(void) : color_method("cppad")
+		sparse_jacobian_work(void) : color_method("cppad"), max_direction(0)
 		{ }
-		/// reset coloring method to its default and
-		/// inform CppAD that color and order need to be recomputed
+		/// reset coloring method and maximum directions to their defaults
+		/// and inform CppAD that color and order need to be recomputed
 		void clear(void)
-		{	color_method = "cppad";
+		{	color_method  = "cppad";
+			max_direction = 0;
 			order.clear();
 			color.clear();
+			team_start.clear();
 		}
 };
 // ===========================================================================
@@ -421,6 +453,7 @@ size_t ADFun<Base>::SparseJacobianFor(
 		for(k = 0; k < K; k++)
 			key[k] = color[ col[k] ];
 		index_sort(key, order);
+		work.team_start.clear();
 	}
 	size_t n_color = 1;
 	for(j = 0; j < n; j++) if( color[j] < n )
@@ -430,34 +463,24 @@ size_t ADFun<Base>::SparseJacobianFor(
 	for(k = 0; k < K; k++)
 		jac[k] = zero;
 
-# if CPPAD_SPARSE_JACOBIAN_MAX_MULTIPLE_DIRECTION == 1
-	// direction vector and return values for calls to forward
-	VectorBase dx(n), dy(m);
-
-	// loop over colors
-	k = 0;
-	for(ell = 0; ell < n_color; ell++)
-	{	CPPAD_ASSERT_UNKNOWN( color[ col[ order[k] ] ] == ell );
+	// maximum number of colors for one sweep
+	size_t max_r = work.max_direction;
+	if( max_r == 0 )
+	{	max_r = CPPAD_SPARSE_JACOBIAN_MAX_MULTIPLE_DIRECTION;
+		size_t max_taylor = CPPAD_SPARSE_JACOBIAN_MAX_MULTIPLE_TAYLOR;
+		if( max_r * num_var_tape_ > max_taylor )
+			max_r = std::max( size_t(1), max_taylor / num_var_tape_ );
+	}
 
-		// combine all columns with this color
-		for(j = 0; j < n; j++)
-		{	dx[j] = zero;
-			if( color[j] == ell )
-				dx[j] = one;
-		}
-		// call forward mode for all these columns at once
-		dy = Forward(1, dx);
+	// split the colors among a team of threads in parallel mode
+	if( SparseTeam(
+		sparse_team_jac_for, max_r,
+		x, color, col, row, order, work.team_start, jac
+	) )	return n_color;
 
-		// set the corresponding components of the result
-		while( k < K && color[ col[order[k]] ] == ell ) 
-		{	jac[ order[k] ] = dy[row[order[k]]];
-			k++;
-		}
-	}
-# else
-	// abbreviation for this value
-	size_t max_r = CPPAD_SPARSE_JACOBIAN_MAX_MULTIPLE_DIRECTION;
-	CPPAD_ASSERT_UNKNOWN( max_r > 1 );
+	// split the colors evenly among the fewest sweeps possible
+	size_t n_sweep = (n_color + max_r - 1) / max_r;
+	size_t r_sweep = (n_color + n_sweep - 1) / n_sweep;
 
 	// count the number of colors done so far
 	size_t count_color = 0;
@@ -465,7 +488,7 @@ size_t ADFun<Base>::SparseJacobianFor(
 	k = 0;
 	while( count_color < n_color )
 	{	// number of colors we will do this time
-		size_t r = std::min(max_r , n_color - count_color);
+		size_t r = std::min(r_sweep , n_color - count_color);
 		VectorBase dx(n * r), dy(m * r);
 
 		// loop over colors we will do this tme
@@ -490,7 +513,6 @@ size_t ADFun<Base>::SparseJacobianFor(
 		}
 		count_color += r;
 	}
-# endif
 	return n_color;
 }
 /*!
@@ -618,6 +640,7 @@ size_t ADFun<Base>::SparseJacobianRev(
 		for(k = 0; k < K; k++)
 			key[k] = color[ row[k] ];
 		index_sort(key, order);
+		work.team_start.clear();
 	}
 	size_t n_color = 1;
 	for(i = 0; i < m; i++) if( color[i] < m ) 
@@ -633,6 +656,12 @@ size_t ADFun<Base>::SparseJacobianRev(
 	for(k = 0; k < K; k++)
 		jac[k] = zero;
 
+	// split the colors among a team of threads in parallel mode
+	if( SparseTeam(
+		sparse_team_jac_rev, 1,
+		x, color, row, col, order, work.team_start, jac
+	) )	return n_color;
+
 	// loop over colors
 	k = 0;
 	for(ell = 0; ell < n_color; ell++)
@@ -1054,4 +1083,5 @@ VectorBase ADFun<Base>::SparseJacobian( const VectorBase& x )
 
 } // END_CPPAD_NAMESPACE
 # undef CPPAD_SPARSE_JACOBIAN_MAX_MULTIPLE_DIRECTION
+# undef CPPAD_SPARSE_JACOBIAN_MAX_MULTIPLE_TAYLOR
 # endif
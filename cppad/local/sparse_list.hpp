@@ -24,6 +24,16 @@ Vector of sets of positive integers stored as singly linked lists.
 /*!
 Vector of sets of positive integers, each set stored as a singly
 linked list.
+
+The lists are shared; i.e., the same list element can be part of
+more than one set. For example, assigning one set to another only
+copies the index of the first element in the list,
+and the union of two sets shares the elements of one of the operands
+that are greater than all the elements in the other operand.
+Each element has a reference count (the number of sets and other
+elements that point to it). A list element is changed only when
+it is not shared (copy on write), and an element is put on a
+list of free elements, for later reuse, when its reference count is zero.
 */
 class sparse_list {
 public:
@@ -39,17 +49,25 @@ private:
 	/// Possible elements in each set are 0, 1, ..., end_ - 1;
 	size_t end_;
 
-	/// The data for all the elements in all the sets
+	/// index in data_ of the first element in each set
+	/// (zero for the empty set).
+	CppAD::pod_vector<size_t> start_;
+
+	/// The data for all the elements in all the sets.
+	/// The element with index zero marks the end of every list;
+	/// i.e., its value is end_.
 	CppAD::pod_vector<pair_size_t> data_;
 
-	/// next element
-	pair_size_t next_pair_;
+	/// reference count for each element in data_
+	/// (number of sets and other elements that have it as next).
+	CppAD::pod_vector<size_t> count_;
 
-	/// number of elements in data_ that are no longer being used.
-	size_t data_not_used_;
+	/// index of the first free element in data_ (zero if there is none).
+	/// The free elements are linked using their next field.
+	size_t free_;
 
-	/// temporary data vector used for garbage collection
-	CppAD::pod_vector<pair_size_t> data_tmp_;
+	/// next element
+	pair_size_t next_pair_;
 	// -----------------------------------------------------------------
 	/*! Private member function that counts number of elements in a set.
 
@@ -63,55 +81,126 @@ private:
 	{	CPPAD_ASSERT_UNKNOWN(index < n_set_ );
 
 		size_t count   = 0;
-		size_t i       = index;
-		size_t value = data_[i].value;
-		while( value < end_ )
+		size_t i       = start_[index];
+		while( i != 0 )
 		{	count++;
-			i     = data_[i].next;
-			value = data_[i].value;
+			i = data_[i].next;
 		}
 		return count;
 	}
 	// -----------------------------------------------------------------
-	/// Private member functions that does garbage collection.
-	void collect_garbage(void) 
-	{	CPPAD_ASSERT_UNKNOWN( 2 * data_not_used_ > data_.size() );
-		//
-		CPPAD_ASSERT_UNKNOWN( 
-			number_elements() + n_set_ + data_not_used_ == data_.size()
-		);
-
-		// copy the sets to a temporary data vector
-		data_tmp_.erase();
-		data_tmp_.extend(n_set_);
-		for(size_t i = 0; i < n_set_; i++)
-		{	size_t next     = i;
-			size_t next_tmp = i;
-			//
-			size_t value    = data_[next].value;
-			while( value < end_ )
-			{	data_tmp_[next_tmp].value = value;	
-				// data_tmp_[next_tmp].next  = data_tmp_.extend(1);
-				// does not seem to work ?
-				size_t index_tmp         = data_tmp_.extend(1);
-				data_tmp_[next_tmp].next = index_tmp;
-				//
-				next                     = data_[next].next;
-				next_tmp                 = data_tmp_[next_tmp].next;
-				//
-				value                    = data_[next].value;
-			}
-			data_tmp_[next_tmp].value = end_;
+	/*! Private member function that gets a new list element.
+
+	\param value
+	is the value for the new element.
+
+	\return
+	is the index in data_ of the new element. Its next field is zero
+	and its reference count is one (for the reference that the caller
+	stores).
+	*/
+	size_t new_element(size_t value)
+	{	size_t i = free_;
+		if( i != 0 )
+			free_ = data_[i].next;
+		else
+		{	i = data_.extend(1);
+			count_.extend(1);
 		}
-		CPPAD_ASSERT_UNKNOWN( 
-			data_tmp_.size() + data_not_used_ == data_.size()
-		);
+		data_[i].value = value;
+		data_[i].next  = 0;
+		count_[i]      = 1;
+		return i;
+	}
+	// -----------------------------------------------------------------
+	/*! Private member function that appends a list to a list.
+
+	\param first
+	is the index in data_ of the first element in the list
+	(zero for the empty list). If the list is empty,
+	it is set to \a next.
 
-		// swap the tmp and old data vectors
-		data_.swap(data_tmp_);
+	\param last
+	is the index in data_ of the last element in the list
+	(zero for the empty list). It is set to \a next.
+
+	\param next
+	is the index in data_ of the first element in the list that is
+	appended (the caller has already counted this reference).
+	*/
+	void append(size_t& first, size_t& last, size_t next)
+	{	if( last == 0 )
+			first = next;
+		else
+			data_[last].next = next;
+		last = next;
+	}
+	// -----------------------------------------------------------------
+	/*! Private member function that drops one reference to a list.
+
+	\param i
+	is the index in data_ of the first element in the list
+	(zero for the empty list).
+	Elements whose reference count becomes zero are put on the free list
+	(and the reference they hold to the next element is dropped).
+	*/
+	void drop(size_t i)
+	{	while( i != 0 )
+		{	CPPAD_ASSERT_UNKNOWN( count_[i] > 0 );
+			if( --count_[i] > 0 )
+				return;
+			size_t next    = data_[i].next;
+			data_[i].value = end_;
+			data_[i].next  = free_;
+			free_          = i;
+			i              = next;
+		}
+	}
+	// -----------------------------------------------------------------
+	/*! Private member function that sets the list for a set.
+
+	\param target
+	is the index of the set that is changed.
+
+	\param i
+	is the index in data_ of the first element in the new list for
+	this set. The caller has already counted the reference from
+	the target set.
+	*/
+	void set_start(size_t target, size_t i)
+	{	size_t old     = start_[target];
+		start_[target] = i;
+		drop(old);
+	}
+	// -----------------------------------------------------------------
+	/*! Private member function that determines if one set is a subset
+	of another.
+
+	\param left
+	is the index in data_ of the first element of the left list.
+
+	\param right
+	is the index in other.data_ of the first element of the right list.
+
+	\param other
+	is the object that contains the right list.
 
-		// all of the elements are used in this new version of data_
-		data_not_used_ = 0;
+	\return
+	is true if every element of the right list is in the left list.
+	*/
+	bool is_subset(size_t left, size_t right, const sparse_list& other) const
+	{	size_t left_value = data_[left].value;
+		while( right != 0 )
+		{	size_t right_value = other.data_[right].value;
+			while( left_value < right_value )
+			{	left       = data_[left].next;
+				left_value = data_[left].value;
+			}
+			if( left_value != right_value )
+				return false;
+			right = other.data_[right].next;
+		}
+		return true;
 	}
 public:
 	// -----------------------------------------------------------------
@@ -120,8 +209,12 @@ public:
 	sparse_list(void) : 
 	n_set_(0)                 , 
 	end_(0)                   ,
-	data_not_used_(0)
-	{	next_pair_.value = end_; }
+	free_(0)
+	{	next_pair_.value = end_;
+		start_.set_tag(thread_alloc::sparsity_tag);
+		data_.set_tag(thread_alloc::sparsity_tag);
+		count_.set_tag(thread_alloc::sparsity_tag);
+	}
 	// -----------------------------------------------------------------
 	/*! Using copy constructor is a programing (not user) error
  
@@ -154,17 +247,28 @@ public:
 	{	n_set_                 = n_set_in;
 		end_                   = end_in;
 		next_pair_.value       = end_in;
-		data_not_used_         = 0;
+		free_                  = 0;
 		if( n_set_in == 0 )
 		{	// free all memory connected with this object
+			start_.free();
 			data_.free();
+			count_.free();
 			return;
 		}
 		// now start a new vector with empty sets
-		data_.erase();
-		data_.extend(n_set_);
+		start_.erase();
+		start_.extend(n_set_);
 		for(size_t i = 0; i < n_set_; i++)
-			data_[i].value = end_;
+			start_[i] = 0;
+
+		// element that marks the end of every list
+		data_.erase();
+		data_.extend(1);
+		data_[0].value = end_;
+		data_[0].next  = 0;
+		count_.erase();
+		count_.extend(1);
+		count_[0] = 0;
 	}
 	// -----------------------------------------------------------------
 	/*! Add one element to a set.
@@ -183,34 +287,58 @@ public:
 	{	CPPAD_ASSERT_UNKNOWN( index   < n_set_ );
 		CPPAD_ASSERT_UNKNOWN( element < end_ );
 
-		size_t value = data_[index].value;
+		// search list for place to insert, and for the first shared element
+		size_t previous = 0;
+		size_t current  = start_[index];
+		size_t shared   = 0;
+		while( data_[current].value < element )
+		{	if( shared == 0 && count_[current] > 1 )
+				shared = current;
+			previous = current;
+			current  = data_[current].next;
+		}
+		if( data_[current].value == element )
+			return;
 
-		// case of inserting at beginning
-		if( element < value )
-		{	size_t insert       = data_.extend(1);
-			data_[insert]       = data_[index];
-			data_[index].value  = element;
-			data_[index].next   = insert;
+		// new element that points to current
+		size_t insert = new_element(element);
+		data_[insert].next = current;
+		if( shared == 0 )
+		{	// the elements before current are not shared, so the
+			// reference to current moves from previous to insert
+			if( previous == 0 )
+				start_[index] = insert;
+			else
+				data_[previous].next = insert;
 			return;
 		}
 
-		// search list for place to insert 
-		size_t  previous = index;
-		size_t  current  = data_[previous].next;
-		value            = data_[current].value;
-		while( value < element )
-		{	previous = current;
-			current = data_[previous].next;
-			value   = data_[current].value; 
+		// copy the elements from shared to previous (copy on write)
+		if( current != 0 )
+			count_[current]++;
+		size_t first = 0;
+		size_t last  = 0;
+		size_t i     = shared;
+		append(first, last, new_element( data_[i].value ) );
+		while( i != previous )
+		{	i = data_[i].next;
+			append(first, last, new_element( data_[i].value ) );
 		}
-		if( element != value )
-		{	CPPAD_ASSERT_UNKNOWN( element < value ); 
-			size_t insert         = data_.extend(1);
-			//
-			data_[insert].next    = data_[previous].next;
-			data_[previous].next  = insert;
-			data_[insert].value   = element;
+		append(first, last, insert);
+
+		// replace the reference to shared by a reference to the copy
+		// (the elements before shared are not shared)
+		size_t before = 0;
+		i             = start_[index];
+		while( i != shared )
+		{	before = i;
+			i      = data_[i].next;
 		}
+		if( before == 0 )
+			start_[index] = first;
+		else
+			data_[before].next = first;
+		drop(shared);
 	}
 	// -----------------------------------------------------------------
 	/*! Is an element in a set.
@@ -229,7 +357,7 @@ public:
 	{	CPPAD_ASSERT_UNKNOWN( index   < n_set_ );
 		CPPAD_ASSERT_UNKNOWN( element < end_ );
 
-		size_t i     = index;
+		size_t i     = start_[index];
 		size_t value = data_[i].value;
 		while( value < element )
 		{	i     = data_[i].next;
@@ -252,7 +380,7 @@ public:
 	void begin(size_t index)
 	{	// initialize element to search for in this set
 		CPPAD_ASSERT_UNKNOWN( index < n_set_ );
-		next_pair_  = data_[index]; 
+		next_pair_  = data_[ start_[index] ];
 
 		return;
 	}
@@ -281,26 +409,12 @@ public:
 	\param target
 	is the index of the set we are setting to the empty set.
 
-	\par data_not_used_
-	increments this value by number of elements lost.
-
 	\par Checked Assertions
 	\li target < n_set_
 	*/
 	void clear(size_t target)
 	{	CPPAD_ASSERT_UNKNOWN( target < n_set_ );
-
-		// number of elements that will be deleted by this operation
-		size_t number_delete = number_elements(target);
-
-		// delete the elements from the set
-		data_[target].value = end_;
-
-		// adjust data_not_used_
-		data_not_used_ += number_delete;
-
-		if( 2 * data_not_used_ > data_.size() )
-			collect_garbage();
+		set_start(target, 0);
 	}
 	// -----------------------------------------------------------------
 	/*! Assign one set equal to another set.
@@ -315,9 +429,8 @@ public:
 	\param other
 	is the other \c sparse_list object (which may be the same as this
 	\c sparse_list object).
-
-	\par data_not_used_
-	increments this value by number of elements lost.
+	If it is the same object, the list for the source set is shared
+	by the target set (no elements are copied).
 
 	\par Checked Assertions
 	\li this_target  < n_set_
@@ -331,31 +444,23 @@ public:
 		CPPAD_ASSERT_UNKNOWN( other_source <   other.n_set_  );
 		CPPAD_ASSERT_UNKNOWN( end_        == other.end()   );
 
-		// check if we are assigning a set to itself
-		if( (this == &other) & (this_target == other_source) )
+		size_t other_index = other.start_[other_source];
+		if( this == &other )
+		{	// share the list
+			if( other_index != 0 )
+				count_[other_index]++;
+			set_start(this_target, other_index);
 			return; 
-
-		// number of elements that will be deleted by this operation
-		size_t number_delete = number_elements(this_target);
-
-		size_t this_index        = this_target;
-		size_t other_index       = other_source;
-		size_t value             = other.data_[other_index].value;
-		while( value != end_ )
-		{	size_t next             = data_.extend(1);
-			data_[this_index].value = value;
-			data_[this_index].next  = next;
-			this_index              = next;
-			other_index             = other.data_[other_index].next;
-			value                   = other.data_[other_index].value;
 		}
-		data_[this_index].value = end_;
-
-		// adjust data_not_used_
-		data_not_used_ += number_delete;
 
-		if( 2 * data_not_used_ > data_.size() )
-			collect_garbage();
+		// copy the list
+		size_t first = 0;
+		size_t last  = 0;
+		while( other_index != 0 )
+		{	append(first, last, new_element(other.data_[other_index].value));
+			other_index = other.data_[other_index].next;
+		}
+		set_start(this_target, first);
 	}
 	// -----------------------------------------------------------------
 	/*! Assign a set equal to the union of two other sets.
@@ -377,6 +482,16 @@ public:
 	is the other \c sparse_list object (which may be the same as this
 	\c sparse_list object).
 
+	\par Sharing
+	If the right set is a subset of the left set, the target shares the
+	list for the left set.
+	If this is the same object as other and the left set is a subset of
+	the right set, the target shares the list for the right set.
+	Otherwise, a new list is created for the elements that are less than
+	or equal the maximum element in one of the operands, and the rest of
+	the new list is shared with the other operand
+	(when it is in this object).
+
 	\par Checked Assertions
 	\li this_target <  n_set_
 	\li this_left   <  n_set_
@@ -393,54 +508,75 @@ public:
 		CPPAD_ASSERT_UNKNOWN( other_right < other.n_set_   );
 		CPPAD_ASSERT_UNKNOWN( end_        == other.end()   );
 
-		// determine if we will delete the original version of the target
-		size_t number_delete = 0;
-		bool delete_target = this_target == this_left;
-		delete_target     |= (this == &other) & (this_target == other_right);
-		if( delete_target )
-		{	// number of elements that will be deleted by this operation
-			number_delete = number_elements(this_target);
+		size_t left  = start_[this_left];
+		size_t right = other.start_[other_right];
+		bool   same  = this == &other;
+
+		// check if the result is one of the operands
+		size_t result = 0;
+		bool   share  = true;
+		if( is_subset(left, right, other) )
+			result = left;
+		else if( same && is_subset(right, left, other) )
+			result = right;
+		else
+			share = false;
+		if( share )
+		{	if( result != 0 )
+				count_[result]++;
+			set_start(this_target, result);
+			return;
 		}
 
-		// value and next for left and right sets
-		size_t left_value  = data_[this_left].value;
-		size_t left_next   = data_[this_left].next;
-		size_t right_value = other.data_[other_right].value;
-		size_t right_next  = other.data_[other_right].next;
-
 		// merge left and right sets to form new target set
-		size_t current       = this_target;
-		while( (left_value < end_) | (right_value < end_) )
-		{	if( left_value == right_value )
-			{	right_value = other.data_[right_next].value;
-				right_next  = other.data_[right_next].next;
-			}
-			size_t next         = data_.extend(1);
-			data_[current].next = next;
-			if( left_value < right_value )
-			{	data_[current].value = left_value;
-				left_value           = data_[left_next].value;
-				left_next            = data_[left_next].next;
+		size_t left_value  = data_[left].value;
+		size_t right_value = other.data_[right].value;
+		size_t first       = 0;
+		size_t last        = 0;
+		while( (left_value < end_) & (right_value < end_) )
+		{	size_t value;
+			if( left_value <= right_value )
+			{	value = left_value;
+				if( left_value == right_value )
+				{	right       = other.data_[right].next;
+					right_value = other.data_[right].value;
+				}
+				left       = data_[left].next;
+				left_value = data_[left].value;
 			}
 			else
-			{	data_[current].value = right_value;
-				right_value = other.data_[right_next].value;
-				right_next  = other.data_[right_next].next;
+			{	value       = right_value;
+				right       = other.data_[right].next;
+				right_value = other.data_[right].value;
 			}
-			current = next;
+			append(first, last, new_element(value) );
 		}
-		data_[current].value = end_;
 
-		// adjust data_not_used_
-		data_not_used_ += number_delete;
-
-		if( 2 * data_not_used_ > data_.size() )
-			collect_garbage();
+		// rest of the result
+		if( left != 0 )
+		{	// share the rest of the left list
+			count_[left]++;
+			append(first, last, left);
+		}
+		else if( same )
+		{	// share the rest of the right list
+			if( right != 0 )
+				count_[right]++;
+			append(first, last, right);
+		}
+		else
+		{	// copy the rest of the right list
+			while( right != 0 )
+			{	append(first, last, new_element(other.data_[right].value) );
+				right = other.data_[right].next;
+			}
+		}
+		set_start(this_target, first);
 	}
 	// -----------------------------------------------------------------
 	/*! Sum over all sets of the number of elements
  
-	/return
+	\return
 	The the total number of elements
  	*/
 	size_t number_elements(void) const
@@ -451,6 +587,18 @@ public:
 		return count;
 	}
 	// -----------------------------------------------------------------
+	/*! Amount of memory used by this vector of sets
+
+	\return
+	The number of bytes allocated for the sets (shared list elements
+	are only counted once).
+ 	*/
+	size_t memory(void) const
+	{	return start_.capacity() * sizeof(size_t)
+		     + data_.capacity()  * sizeof(pair_size_t)
+		     + count_.capacity() * sizeof(size_t);
+	}
+	// -----------------------------------------------------------------
 	/*! Fetch n_set for vector of sets object.
 	
 	\return
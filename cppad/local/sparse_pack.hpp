@@ -3,7 +3,7 @@
 # define CPPAD_SPARSE_PACK_INCLUDED
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -59,7 +59,7 @@ public:
 	n_pack_(0)                    ,
 	next_index_(0)                ,
 	next_element_(0)
-	{ }
+	{	data_.set_tag(thread_alloc::sparsity_tag); }
 	// -----------------------------------------------------------------
 	/*! Make use of copy constructor an error
  
@@ -105,8 +105,9 @@ public:
 
 		if( i > 0 )
 		{	data_.extend(i);
-			while(i--)
-				data_[i] = zero;
+			Pack* data = data_.data();
+			for(size_t k = 0; k < i; k++)
+				data[k] = zero;
 		}
 
 		// values that signify past end of list
@@ -182,8 +183,7 @@ public:
 	If no such element exists, \c this->end() is returned.
 	*/
 	size_t next_element(void)
-	{	static Pack one(1);
-		CPPAD_ASSERT_UNKNOWN( next_index_ < n_set_ );
+	{	CPPAD_ASSERT_UNKNOWN( next_index_ < n_set_ );
 		CPPAD_ASSERT_UNKNOWN( next_element_ <= end_ );
 
 		if( next_element_ == end_ )
@@ -196,31 +196,31 @@ public:
 		size_t k  = next_element_ - j * n_bit_;
 
 		// start search at this packed value
-		Pack check = data_[ next_index_ * n_pack_ + j ];
-		while( true )
-		{	// increment next element before checking this one
-			next_element_++;
-			// check if this element is in the set
-			if( check & (one << k) )
-				return next_element_ - 1;
-			// check if no more elements in the set
-			if( next_element_ == end_ )
+		// (shifted so that its first bit corresponds to next_element_)
+		const Pack* data = data_.data() + next_index_ * n_pack_;
+		Pack check       = data[j] >> k;
+
+		// skip packed values that do not have any elements
+		while( check == Pack(0) )
+		{	if( ++j == n_pack_ )
+			{	next_element_ = end_;
 				return end_;
-			// increment bit index in Pack value so corresponds to 
-			// next element
-			k++;
-			CPPAD_ASSERT_UNKNOWN( k <= n_bit_ );
-			if( k == n_bit_ )
-			{	// get next packed value
-				k     = 0;
-				j++;
-				CPPAD_ASSERT_UNKNOWN( j < n_pack_ );
-				check = data_[ next_index_ * n_pack_ + j ];
 			}
+			check         = data[j];
+			next_element_ = j * n_bit_;
+		}
+		// the first element in this packed value
+		// (skip eight bits at a time and then one bit at a time)
+		while( (check & Pack(0xff)) == Pack(0) )
+		{	check         >>= 8;
+			next_element_  += 8;
 		}
-		// should never get here
-		CPPAD_ASSERT_UNKNOWN(false);
-		return end_;
+		while( (check & Pack(1)) == Pack(0) )
+		{	check         >>= 1;
+			next_element_  += 1;
+		}
+		CPPAD_ASSERT_UNKNOWN( next_element_ < end_ );
+		return next_element_++;
 	}
 	// -----------------------------------------------------------------
 	/*! Assign the empty set to one of the sets.
@@ -235,11 +235,9 @@ public:
 	{	// value with all its bits set to false
 		static Pack zero(0);
 		CPPAD_ASSERT_UNKNOWN( target < n_set_ );
-		size_t t = target * n_pack_;
-
-		size_t j = n_pack_;
-		while(j--)
-			data_[t++] = zero;
+		Pack* t = data_.data() + target * n_pack_;
+		for(size_t j = 0; j < n_pack_; j++)
+			t[j] = zero;
 	}
 	// -----------------------------------------------------------------
 	/*! Assign one set equal to another set.
@@ -267,14 +265,83 @@ public:
 	{	CPPAD_ASSERT_UNKNOWN( this_target  <   n_set_        );
 		CPPAD_ASSERT_UNKNOWN( other_value  <   other.n_set_  );
 		CPPAD_ASSERT_UNKNOWN( n_pack_      ==  other.n_pack_ );
-		size_t t = this_target * n_pack_;
-		size_t v = other_value * n_pack_;
+		if( this == &other && this_target == other_value )
+			return;
 
-		size_t j = n_pack_;
-		while(j--)
-			data_[t++] = other.data_[v++];
+		Pack*       t = data_.data()       + this_target * n_pack_;
+		const Pack* v = other.data_.data() + other_value * n_pack_;
+		for(size_t j = 0; j < n_pack_; j++)
+			t[j] = v[j];
 	}
 
+	// -----------------------------------------------------------------
+	/*! Assign a block of elements in one set equal to a block of elements
+	in another set.
+
+	\param this_target
+	is the index (in this \c sparse_pack object) of the set being assinged.
+
+	\param this_start
+	is the first element in the target block; i.e., the elements
+	<code>this_start, ..., this_start+count-1</code>
+	of the target set are replaced.
+	The other elements of the target set are not changed.
+
+	\param other_value
+	is the index (in the other \c sparse_pack object) of the set
+	that we are using as the value for the block.
+
+	\param other_start
+	is the first element in the value block; i.e.,
+	element <code>other_start+k</code> of the value set
+	is element <code>this_start+k</code> of the target set.
+
+	\param count
+	is the number of elements in each block.
+
+	\param other
+	is the other \c sparse_pack object (which must not be the same as this
+	\c sparse_pack object).
+
+	\par Checked Assertions
+	\li this_target  < n_set_
+	\li other_value  < other.n_set_
+	\li this_start  and other_start are multiples of n_bit()
+	\li this_start  + count <= end_
+	\li other_start + count <= other.end_
+	*/
+	void block_assignment(
+		size_t               this_target  ,
+		size_t               this_start   ,
+		size_t               other_value  ,
+		size_t               other_start  ,
+		size_t               count        ,
+		const sparse_pack&   other        )
+	{	CPPAD_ASSERT_UNKNOWN( this_target  <  n_set_           );
+		CPPAD_ASSERT_UNKNOWN( other_value  <  other.n_set_     );
+		CPPAD_ASSERT_UNKNOWN( this_start  % n_bit_ == 0        );
+		CPPAD_ASSERT_UNKNOWN( other_start % n_bit_ == 0        );
+		CPPAD_ASSERT_UNKNOWN( this_start  + count <= end_       );
+		CPPAD_ASSERT_UNKNOWN( other_start + count <= other.end_ );
+		CPPAD_ASSERT_UNKNOWN( this != &other );
+		if( count == 0 )
+			return;
+
+		Pack*       t = data_.data()
+		              + this_target * n_pack_ + this_start / n_bit_;
+		const Pack* v = other.data_.data()
+		              + other_value * other.n_pack_ + other_start / n_bit_;
+		size_t n_word = count / n_bit_;
+		for(size_t j = 0; j < n_word; j++)
+			t[j] = v[j];
+
+		// last Pack value is only partially in the block
+		size_t k = count - n_word * n_bit_;
+		if( k > 0 )
+		{	Pack mask = (Pack(1) << k) - Pack(1);
+			t[n_word] = (t[n_word] & ~mask) | (v[n_word] & mask);
+		}
+	}
 	// -----------------------------------------------------------------
 	/*! Assing a set equal to the union of two other sets.
 
@@ -311,13 +378,14 @@ public:
 		CPPAD_ASSERT_UNKNOWN( other_right < other.n_set_   );
 		CPPAD_ASSERT_UNKNOWN( n_pack_    ==  other.n_pack_ );
 
-		size_t t = this_target * n_pack_;
-		size_t l  = this_left  * n_pack_;
-		size_t r  = other_right * n_pack_;
-
-		size_t j = n_pack_;
-		while(j--)
-			data_[t++] = ( data_[l++] | other.data_[r++] );
+		// The target may be the same as an operand, but in that case
+		// each Pack value is only used to compute the corresponding value;
+		// i.e., this loop can be vectorized.
+		Pack*       t = data_.data()       + this_target * n_pack_;
+		const Pack* l = data_.data()       + this_left   * n_pack_;
+		const Pack* r = other.data_.data() + other_right * n_pack_;
+		for(size_t j = 0; j < n_pack_; j++)
+			t[j] = l[j] | r[j];
 	}
 	// -----------------------------------------------------------------
 	/*! Amount of memory used by this vector of sets
@@ -344,6 +412,16 @@ public:
 	*/
 	size_t end(void) const
 	{	return end_; }
+	// -----------------------------------------------------------------
+	/*! Number of elements in each \c Pack value.
+
+	\return
+	is the number of bits in the type used to pack elements.
+	Blocks of elements that start at a multiple of this value
+	do not share \c Pack values with the previous block.
+	*/
+	static size_t n_bit(void)
+	{	return n_bit_; }
 };
 
 /*! 
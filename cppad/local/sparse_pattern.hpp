@@ -18,6 +18,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 # include <cppad/local/sparse_pack.hpp>
 # include <cppad/local/sparse_set.hpp>
 # include <cppad/local/sparse_list.hpp>
+# include <cppad/local/sparse_hybrid.hpp>
 
 namespace CppAD { // BEGIN_CPPAD_NAMESPACE
 /*!
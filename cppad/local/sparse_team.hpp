@@ -0,0 +1,330 @@
+/* $Id$ */
+# ifndef CPPAD_SPARSE_TEAM_INCLUDED
+# define CPPAD_SPARSE_TEAM_INCLUDED
+
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+namespace CppAD { // BEGIN_CPPAD_NAMESPACE
+/*!
+\file sparse_team.hpp
+Split the colors for a sparse Jacobian or Hessian among a team of threads.
+*/
+
+/*!
+Information for one sparse derivative calculation by a team of threads
+(the pointers are only valid during the calculation).
+
+\tparam Base
+is the base type for the recording that is stored in the ADFun<Base> object.
+*/
+template <class Base>
+struct sparse_team_info {
+	/// kind of calculation
+	sparse_team_kind    kind;
+	/// function object that contains the zero order forward mode results
+	ADFun<Base>*        fun;
+	/// number of components in the direction (or weight) vector for a color
+	size_t              n_dir;
+	/// maximum number of colors computed during one sweep
+	size_t              max_r;
+	/// color for each component of the direction (or weight) vector
+	const size_t*       color;
+	/// index corresponding to the color for each result
+	const size_t*       key;
+	/// index in the derivative vector for each result
+	const size_t*       index;
+	/// indices that sort the results by color
+	const size_t*       order;
+	/// first index in order for each thread (and one past the last)
+	const size_t*       team_start;
+	/// range space weights (only used for the Hessian)
+	const Base*         w;
+	/// the results
+	Base*               result;
+};
+
+/*!
+Copy the zero order forward mode results from another function object.
+
+\param f
+is a function object with the same operation sequence as this one
+and for which the zero order forward mode results have been computed.
+The zero order Taylor coefficients, and the conditional skip and
+VecAD load information, are copied to this function object.
+The other orders of Taylor coefficients in this function object
+are no longer valid.
+*/
+template <class Base>
+void ADFun<Base>::taylor0_assign(const ADFun<Base>& f)
+{	CPPAD_ASSERT_UNKNOWN( num_var_tape_ == f.num_var_tape_ );
+	CPPAD_ASSERT_UNKNOWN( f.num_order_taylor_ > 0 );
+	CPPAD_ASSERT_UNKNOWN( cap_order_taylor_ > 0 );
+
+	// stride between variables in taylor_ for each object
+	size_t C        = cap_order_taylor_;
+	size_t r        = num_direction_taylor_;
+	size_t stride   = (C - 1) * r + 1;
+	size_t f_C      = f.cap_order_taylor_;
+	size_t f_r      = f.num_direction_taylor_;
+	size_t f_stride = (f_C - 1) * f_r + 1;
+	for(size_t i = 0; i < num_var_tape_; i++)
+		taylor_[ stride * i ] = f.taylor_[ f_stride * i ];
+	num_order_taylor_ = 1;
+
+	cskip_op_ = f.cskip_op_;
+	load_op_  = f.load_op_;
+}
+
+/*!
+Compute the colors assigned to one thread for a sparse derivative calculation.
+
+The colors for this thread are split evenly among the fewest sweeps
+that have at most info.max_r colors
+(multiple directions are only used for sparse_team_jac_for).
+
+This routine is called by each thread in the team.
+The first time a thread is used, it creates a copy of the function object;
+see parallel_sweep::team_fun.
+After that, the zero order forward mode results are copied to
+the thread's function object.
+
+\param thread
+is the thread number for this thread.
+
+\param info_vptr
+is a pointer to the sparse_team_info<Base> object for this calculation.
+*/
+template <class Base>
+void ADFun<Base>::sparse_team_worker(size_t thread, void* info_vptr)
+{	sparse_team_info<Base>& info =
+		*static_cast< sparse_team_info<Base>* >(info_vptr);
+	size_t k     = info.team_start[thread];
+	size_t k_end = info.team_start[thread + 1];
+	if( k == k_end )
+		return;
+
+	// this thread's copy of the function object
+	ADFun<Base>*  master = info.fun;
+	ADFun<Base>*& fun    = master->par_sweep_.team_fun(thread);
+	if( fun == CPPAD_NULL )
+	{	fun  = new ADFun<Base>;
+		*fun = *master;
+		fun->parallel_team(CPPAD_NULL);
+		fun->size_forward_bool(0);
+		fun->size_forward_set(0);
+	}
+	else	fun->taylor0_assign(*master);
+
+	size_t m = master->Range();
+	size_t n = master->Domain();
+	size_t i, d, r;
+	const Base zero(0);
+	const Base one(1);
+
+	CppAD::vector<Base> dir, w, val;
+	if( info.kind == sparse_team_hes )
+	{	w.resize(m);
+		for(i = 0; i < m; i++)
+			w[i] = info.w[i];
+	}
+
+	// split the colors for this thread evenly among the fewest sweeps
+	size_t ell_begin = info.color[ info.key[ info.order[k] ] ];
+	size_t ell_end   = info.color[ info.key[ info.order[k_end-1] ] ] + 1;
+	size_t n_color   = ell_end - ell_begin;
+	size_t n_sweep   = (n_color + info.max_r - 1) / info.max_r;
+	size_t r_sweep   = (n_color + n_sweep - 1) / n_sweep;
+
+	// loop over the sweeps for this thread
+	size_t ell = ell_begin;
+	while( ell < ell_end )
+	{	r = std::min(r_sweep, ell_end - ell);
+
+		// combine all the directions (or weights) with each color
+		dir.resize(info.n_dir * r);
+		for(i = 0; i < info.n_dir; i++)
+		{	for(d = 0; d < r; d++)
+				dir[i * r + d] = zero;
+			if( ell <= info.color[i] && info.color[i] < ell + r )
+				dir[i * r + info.color[i] - ell] = one;
+		}
+		size_t stride = 1, offset = 0;
+		switch( info.kind )
+		{	case sparse_team_jac_for:
+			val.resize(m * r);
+			val    = fun->Forward(1, r, dir);
+			stride = r;
+			break;
+
+			case sparse_team_jac_rev:
+			CPPAD_ASSERT_UNKNOWN( r == 1 );
+			val.resize(n);
+			val = fun->Reverse(1, dir);
+			break;
+
+			case sparse_team_hes:
+			CPPAD_ASSERT_UNKNOWN( r == 1 );
+			fun->Forward(1, dir);
+			val.resize(2 * n);
+			val    = fun->Reverse(2, w);
+			stride = 2;
+			offset = 1;
+			break;
+		}
+
+		// set the corresponding components of the result
+		while( k < k_end && info.color[ info.key[ info.order[k] ] ] < ell + r )
+		{	size_t o = info.order[k];
+			d        = info.color[ info.key[o] ] - ell;
+			info.result[o] = val[ info.index[o] * stride + offset + d ];
+			k++;
+		}
+		ell += r;
+	}
+}
+
+/*!
+Split the colors for a sparse derivative calculation among a team of threads.
+
+\tparam VectorBase
+is a simple vector class with elements of type \a Base.
+
+\tparam VectorSize
+is a simple vector class with elements of type \c size_t.
+
+\param kind
+is the kind of sparse derivative calculation.
+
+\param max_r
+is the maximum number of colors computed during one sweep.
+It must be one unless \a kind is sparse_team_jac_for.
+
+\param w
+is the range space weight vector (only used for the Hessian).
+
+\param color
+is the color for each component of the direction vectors (forward mode)
+or weight vectors (reverse mode).
+
+\param key
+is the index (in \a color) corresponding to each result; i.e.,
+\c col for SparseJacobianForward and \c row otherwise.
+
+\param index
+is the other index for each result; i.e.,
+\c row for SparseJacobianForward and \c col otherwise.
+
+\param order
+is the indices that sort the results by color.
+Each color, from zero to the maximum color, has at least one result.
+
+\param team_start [in,out]
+If its size is the number of threads plus one,
+it is the first index in \a order for each thread
+(followed by the number of results).
+Otherwise, it is set to this value.
+It must be cleared when \a color or \a order changes.
+
+\param result [out]
+is the vector of derivative values.
+It is only changed if the return value is true.
+In this case, the only Taylor coefficients in this function object
+are the zero order ones (size_order() is one);
+the calling routine computes them before calling SparseTeam and
+the other orders are computed by the threads' copies of this object.
+
+\return
+is false (and nothing is computed) if the parallel mode is off,
+there is only one thread, execution is currently parallel,
+there is only one color,
+or the operation sequence contains user atomic operations.
+In this case the calling routine should compute the result.
+*/
+template <class Base>
+template <class VectorBase, class VectorSize>
+bool ADFun<Base>::SparseTeam(
+	sparse_team_kind              kind        ,
+	size_t                        max_r       ,
+	const VectorBase&             w           ,
+	const CppAD::vector<size_t>&  color       ,
+	const VectorSize&             key         ,
+	const VectorSize&             index       ,
+	const CppAD::vector<size_t>&  order       ,
+	CppAD::vector<size_t>&        team_start  ,
+	VectorBase&                   result      )
+{	size_t n_thread = thread_alloc::num_threads();
+	bool use_team   = par_sweep_.active()
+		&& n_thread > 1
+		&& ! thread_alloc::in_parallel();
+	size_t K = size_t( result.size() );
+	if( ! use_team || K == 0 )
+		return false;
+	size_t n_color = color[ key[ order[K-1] ] ] + 1;
+	if( n_color < 2 )
+		return false;
+
+	// user atomic functions may not support calls by different threads
+	size_t num_op = play_.num_op_rec();
+	for(size_t i_op = 0; i_op < num_op; i_op++)
+	{	if( play_.GetOp(i_op) == UserOp )
+			return false;
+	}
+
+	// split the colors among the threads
+	size_t k, t;
+	if( team_start.size() != n_thread + 1 )
+	{	team_start.resize(n_thread + 1);
+		k = 0;
+		for(t = 0; t < n_thread; t++)
+		{	size_t first_color = (n_color * t) / n_thread;
+			while( k < K && color[ key[ order[k] ] ] < first_color )
+				k++;
+			team_start[t] = k;
+		}
+		team_start[n_thread] = K;
+	}
+
+	// copy of the user vectors that can be accessed by pointers
+	CppAD::vector<size_t> key_copy(K), index_copy(K);
+	for(k = 0; k < K; k++)
+	{	key_copy[k]   = key[k];
+		index_copy[k] = index[k];
+	}
+	CppAD::vector<Base> w_copy, result_copy(K);
+	if( kind == sparse_team_hes )
+	{	size_t m = Range();
+		w_copy.resize(m);
+		for(size_t i = 0; i < m; i++)
+			w_copy[i] = w[i];
+	}
+
+	sparse_team_info<Base> info;
+	info.kind       = kind;
+	info.fun        = this;
+	info.n_dir      = color.size();
+	info.max_r      = max_r;
+	info.color      = color.data();
+	info.key        = key_copy.data();
+	info.index      = index_copy.data();
+	info.order      = order.data();
+	info.team_start = team_start.data();
+	info.w          = w_copy.data();
+	info.result     = result_copy.data();
+	par_sweep_.team_call(sparse_team_worker, &info);
+
+	for(k = 0; k < K; k++)
+		result[k] = result_copy[k];
+	return true;
+}
+
+} // END_CPPAD_NAMESPACE
+# endif
@@ -104,15 +104,21 @@ inline void forward_sqrt_op_dir(
 		"Forward: attempt to take derivatve of square root of zero"
 	)
 
-	size_t m = (q-1) * r + 1;
-	for(size_t ell = 0; ell < r; ell++)
-	{	z[m+ell] = Base(0);
-		for(size_t k = 1; k < q; k++)
-			z[m+ell] -= Base(k) * z[(k-1)*r+1+ell] * z[(q-k-1)*r+1+ell];
-		z[m+ell] /= Base(q);
+	// loop over directions is innermost so it accesses contiguous memory
+	size_t k, ell, m = (q-1) * r + 1;
+	for(ell = 0; ell < r; ell++)
+		z[m+ell] = Base(0);
+	for(k = 1; k < q; k++)
+	{	const Base* zk = z + (k-1)*r + 1;
+		const Base* zq = z + (q-k-1)*r + 1;
+		for(ell = 0; ell < r; ell++)
+			z[m+ell] -= Base(k) * zk[ell] * zq[ell];
+	}
+	for(ell = 0; ell < r; ell++)
+	{	z[m+ell] /= Base(q);
 		z[m+ell] += x[m+ell] / Base(2);
 		z[m+ell] /= z[0];
-	}	
+	}
 }
 
 /*!
@@ -60,6 +60,8 @@ Preprecessor definitions that presist after cppad/cppad.hpp is included:
 # undef CPPAD_ASSERT_NARG_NRES
 # undef CPPAD_ASSERT_NOT_PARALLEL
 # undef CPPAD_ASSERT_ARG_BEFORE_RESULT
+# undef CPPAD_BINARY_SPARSE_VERSION
+# undef CPPAD_BINARY_TAPE_VERSION
 # undef CPPAD_BOOSTVECTOR
 # undef CPPAD_COND_EXP
 # undef CPPAD_COND_EXP_BASE_REL
@@ -79,6 +81,9 @@ Preprecessor definitions that presist after cppad/cppad.hpp is included:
 # undef CPPAD_MAX_NUM_CAPACITY
 # undef CPPAD_MIN_DOUBLE_CAPACITY
 # undef CPPAD_OP_CODE_TYPE
+# undef CPPAD_OPTIMIZE_TIMING
+# undef CPPAD_PAR_HASH_TABLE_SIZE
+# undef CPPAD_POD_ARENA_FIRST_BYTES
 # undef CPPAD_REVERSE_SWEEP_TRACE
 # undef CPPAD_REV_HES_SWEEP_TRACE
 # undef CPPAD_REV_JAC_SWEEP_TRACE
@@ -3,7 +3,7 @@
 # define CPPAD_THREAD_ALLOC_INCLUDED
 
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -14,9 +14,16 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 -------------------------------------------------------------------------- */
 
 # include <sstream>
+# include <iomanip>
 # include <limits>
 # include <memory>
 
+# if defined(__linux__)
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# endif
+
 
 # ifdef _MSC_VER
 // Supress warning that Microsoft compiler changed its behavior and is now 
@@ -62,6 +69,77 @@ that correspond to this thead and capacity CPPAD_TRACE_CAPACITY.
 */
 # define CPPAD_TRACE_THREAD 0
 
+/*!
+\def CPPAD_THREAD_ALLOC_REMOTE_FREE
+If this is one, memory returned by a thread that is not the thread that
+allocated it is put in a lock-free queue for the allocating thread.
+This requires compare and swap instructions, which are available
+with the GNU and Microsoft compilers.
+Otherwise, memory must be returned by the same thread that allocated it
+(or in sequential execution mode).
+*/
+# if defined(__GNUC__)
+# define CPPAD_THREAD_ALLOC_REMOTE_FREE 1
+# elif defined(_MSC_VER)
+# include <intrin.h>
+# define CPPAD_THREAD_ALLOC_REMOTE_FREE 1
+# else
+# define CPPAD_THREAD_ALLOC_REMOTE_FREE 0
+# endif
+
+/*!
+\def CPPAD_THREAD_ALLOC_CACHE_LINE
+Number of bytes used to separate the information that is written by
+other threads from the information that is only used by its own thread.
+*/
+# define CPPAD_THREAD_ALLOC_CACHE_LINE 64
+
+/*!
+\def CPPAD_THREAD_ALLOC_HUGE_PAGE
+If this is one, large allocations can be obtained from transparent huge pages
+using \c mmap and \c madvise; see thread_alloc::huge_page.
+*/
+# if defined(MAP_ANONYMOUS) && defined(MADV_HUGEPAGE)
+# define CPPAD_THREAD_ALLOC_HUGE_PAGE 1
+# else
+# define CPPAD_THREAD_ALLOC_HUGE_PAGE 0
+# endif
+
+/*!
+\def CPPAD_THREAD_ALLOC_HUGE_PAGE_SIZE
+Number of bytes in a transparent huge page. When huge pages are enabled,
+allocations with at least this capacity are aligned to, and a multiple of,
+this size.
+*/
+# define CPPAD_THREAD_ALLOC_HUGE_PAGE_SIZE 2097152
+
+/*!
+\def CPPAD_THREAD_ALLOC_NUMA
+If this is one, large allocations can be obtained using \c mmap and placed
+on the NUMA node of the thread that allocates them;
+see thread_alloc::numa_local.
+*/
+# if defined(MAP_ANONYMOUS)
+# define CPPAD_THREAD_ALLOC_NUMA 1
+# else
+# define CPPAD_THREAD_ALLOC_NUMA 0
+# endif
+
+/*!
+\def CPPAD_THREAD_ALLOC_NUMA_MIN_BYTES
+Minimum capacity for an allocation to be placed on a NUMA node
+when thread_alloc::numa_local is true.
+Smaller allocations use \c operator \c new.
+*/
+# define CPPAD_THREAD_ALLOC_NUMA_MIN_BYTES 65536
+
+/*!
+\def CPPAD_THREAD_ALLOC_TOUCH_STRIDE
+Stride in bytes used to touch each page of a NUMA local allocation
+(no larger than the smallest page size used by any system).
+*/
+# define CPPAD_THREAD_ALLOC_TOUCH_STRIDE 4096
+
 /*
 Note that Section 3.6.2 of ISO/IEC 14882:1998(E) states: "The storage for 
 objects with static storage duration (3.7.1) shall be zero-initialized
@@ -80,6 +158,24 @@ Allocator class that works well with an multi-threading environment.
 */
 class thread_alloc{
 // ============================================================================
+public:
+	/// Tags used to attribute memory to the part of CppAD that uses it;
+	/// see thread_alloc::statistics.
+	enum tag_type {
+		/// memory that is not attributed to one of the other tags
+		other_tag,
+		/// Taylor coefficients for ADFun objects
+		taylor_tag,
+		/// sparsity patterns
+		sparsity_tag,
+		/// operation sequence recordings
+		recorder_tag,
+		/// workspace for atomic functions
+		atomic_tag,
+		/// number of tags (also used for memory that is not attributed)
+		number_tag
+	};
+// ============================================================================
 private:
 	
 	class capacity_t {
@@ -88,6 +184,9 @@ private:
 		size_t number;
 		/// the different capacity values
 		size_t value[CPPAD_MAX_NUM_CAPACITY];
+		/// index of the first capacity value greater than or equal
+		/// two to the power b (or number-1 if there is no such value)
+		size_t octave[std::numeric_limits<size_t>::digits];
 		/// ctor
 		capacity_t(void)
 		{	// Cannot figure out how to call thread_alloc::in_parallel here. 
@@ -102,8 +201,16 @@ private:
 				value[number++] = capacity;
 				// next capactiy is 3/2 times the current one
 				capacity        = 3 * ( (capacity + 1) / 2 );
-			} 		 
+			}
 			CPPAD_ASSERT_UNKNOWN( number > 0 );
+			//
+			size_t c_index = 0;
+			for(size_t b = 0; b < std::numeric_limits<size_t>::digits; b++)
+			{	size_t power = size_t(1) << b;
+				while( c_index + 1 < number && value[c_index] < power )
+					++c_index;
+				octave[b] = c_index;
+			}
 		}
 	};
 
@@ -115,10 +222,22 @@ private:
 		size_t             tc_index_;
 		/// pointer to the next memory allocation with the same tc_index_
 		void*              next_;
+		/// pointer to the next block in the remote free queue for the
+		/// thread that allocated this block
+		void*              remote_next_;
+		/// was this block obtained using mmap (instead of operator new)
+		bool               mapped_;
+		/// is this block a huge page mapping
+		bool               huge_page_;
+		/// tag for this block (number_tag if statistics were not being
+		/// collected when it was obtained by get_memory)
+		unsigned char      tag_;
 		// -----------------------------------------------------------------
 		/// make default constructor private. It is only used by constructor
 		/// for `root arrays below.
-		block_t(void) : extra_(0), tc_index_(0), next_(CPPAD_NULL) 
+		block_t(void)
+		: extra_(0), tc_index_(0), next_(CPPAD_NULL), remote_next_(CPPAD_NULL)
+		, mapped_(false), huge_page_(false), tag_(number_tag)
 		{ }
 	};
 
@@ -142,6 +261,28 @@ private:
 		/// If NDEBUG is true, this memory is not used, but it still
 		/// helps separate this structure from one for the next thread.
 		block_t root_inuse_[CPPAD_MAX_NUM_CAPACITY];
+		/// keep remote_free_ on a different cache line from the values above
+		char    pad_before_[CPPAD_THREAD_ALLOC_CACHE_LINE];
+		/// Blocks allocated by this thread and returned by other threads
+		/// (linked by block_t::remote_next_). This is the only value in this
+		/// structure that is written by other threads.
+		void* volatile remote_free_;
+		/// keep remote_free_ on a different cache line from the next thread
+		char    pad_after_[CPPAD_THREAD_ALLOC_CACHE_LINE];
+	};
+	// ---------------------------------------------------------------------
+	/// Allocation statistics for each thread (only changed by its thread
+	/// or in sequential execution mode).
+	struct thread_alloc_stat {
+		/// maximum bytes in use after a call to get_memory
+		size_t  peak_inuse_;
+		/// number of calls to get_memory for each capacity
+		size_t  get_count_[CPPAD_MAX_NUM_CAPACITY];
+		/// number of calls to get_memory for each capacity
+		/// that used memory that was available for this thread
+		size_t  hit_count_[CPPAD_MAX_NUM_CAPACITY];
+		/// bytes currently in use for each tag
+		size_t  tag_inuse_[number_tag];
 	};
 	// ---------------------------------------------------------------------
 	/*!
@@ -163,6 +304,82 @@ private:
 			value = new_value;
 		return value;
 	}
+	/*!
+ 	Set and Get use huge pages flag.
+
+	\param set [in]
+	if true, the value returned by this return is changed.
+
+	\param new_value [in]
+	if \a set is true, this is the new value returned by this routine.
+	Otherwise, \c new_value is ignored.
+
+	\return
+	the current setting for this routine (which is initially false).
+	*/
+	static bool set_get_huge_page(bool set, bool new_value = false)
+	{	static bool value = false;
+		if( set )
+			value = new_value;
+		return value;
+	}
+	/*!
+ 	Set and Get NUMA local placement flag.
+
+	\param set [in]
+	if true, the value returned by this return is changed.
+
+	\param new_value [in]
+	if \a set is true, this is the new value returned by this routine.
+	Otherwise, \c new_value is ignored.
+
+	\return
+	the current setting for this routine (which is initially false).
+	*/
+	static bool set_get_numa_local(bool set, bool new_value = false)
+	{	static bool value = false;
+		if( set )
+			value = new_value;
+		return value;
+	}
+	/*!
+ 	Set and Get collect statistics flag.
+
+	\param set [in]
+	if true, the value returned by this return is changed.
+
+	\param new_value [in]
+	if \a set is true, this is the new value returned by this routine.
+	Otherwise, \c new_value is ignored.
+
+	\return
+	the current setting for this routine (which is initially false).
+	*/
+	static bool set_get_statistics(bool set, bool new_value = false)
+	{	static bool value = false;
+		if( set )
+			value = new_value;
+		return value;
+	}
+	// ---------------------------------------------------------------------
+	/*!
+	Get pointer to the allocation statistics for a thread.
+
+	The statistics are not deleted when the information for a thread is
+	cleared (see thread_info), so they are still available after
+	free_available.
+
+	\param thread [in]
+	Is the thread number for these statistics.
+
+	\return
+	is the statistics pointer for this thread.
+	*/
+	static thread_alloc_stat* thread_stat(size_t thread)
+	{	static thread_alloc_stat all_stat[CPPAD_MAX_NUM_THREADS];
+		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS );
+		return all_stat + thread;
+	}
 	// ---------------------------------------------------------------------
 	/*!
 	Get pointer to the information for this thread.
@@ -186,7 +403,8 @@ private:
 	In addition,
 	for <code>c = 0 , ... , CPPAD_MAX_NUM_CAPACITY-1</code>
 	<code>info->root_inuse_[c].next_ == CPPAD_NULL</code> and
-	<code>info->root_available_[c].next_ == CPPAD_NULL</code>.
+	<code>info->root_available_[c].next_ == CPPAD_NULL</code>,
+	and <code>info->remote_free_ == CPPAD_NULL</code>.
 	*/
 	static thread_alloc_info* thread_info(
 		size_t             thread          ,
@@ -205,7 +423,8 @@ private:
 # ifndef NDEBUG
 				CPPAD_ASSERT_UNKNOWN(
 					info->count_inuse_     == 0 &&
-					info->count_available_ == 0
+					info->count_available_ == 0 &&
+					info->remote_free_     == CPPAD_NULL
 				);
 				for(size_t c = 0; c < CPPAD_MAX_NUM_CAPACITY; c++)
 				{	CPPAD_ASSERT_UNKNOWN(
@@ -237,6 +456,7 @@ private:
 			}
 			info->count_inuse_     = 0;
 			info->count_available_ = 0;
+			info->remote_free_     = CPPAD_NULL;
 		}
 		return info;
 	}
@@ -335,6 +555,441 @@ private:
 		info->count_available_ =  info->count_available_ - dec;
 	}
 
+	// -----------------------------------------------------------------------
+	/*!
+	Index of the most significant bit that is set.
+
+	\param x [in]
+	is the value we are determining the most significant bit for
+	(must be greater than zero).
+
+	\return
+	is the largest integer b such that two to the power b is less than or
+	equal \a x.
+	*/
+	static size_t floor_log2(size_t x)
+	{	CPPAD_ASSERT_UNKNOWN( x > 0 );
+# if defined(__GNUC__)
+		if( sizeof(size_t) == sizeof(unsigned long) )
+		{	size_t n_digit = std::numeric_limits<unsigned long>::digits;
+			unsigned long ux = static_cast<unsigned long>(x);
+			return n_digit - 1 - size_t( __builtin_clzl(ux) );
+		}
+# elif defined(_MSC_VER) && defined(_WIN64)
+		unsigned long index;
+		_BitScanReverse64(&index, x);
+		return size_t(index);
+# elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, x);
+		return size_t(index);
+# endif
+# ifndef _MSC_VER
+		// binary search for the most significant bit
+		size_t b = 0;
+		size_t s = std::numeric_limits<size_t>::digits / 2;
+		while( s > 0 )
+		{	if( (x >> s) != 0 )
+			{	x >>= s;
+				b  += s;
+			}
+			s /= 2;
+		}
+		return b;
+# endif
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Determine the smallest capacity that is greater than or equal
+	a specified number of bytes.
+
+	The capacity values grow by a factor of 3/2, so there are at most two
+	capacity values between a power of two and the next power of two.
+	Starting at the first capacity in the octave for \a min_bytes,
+	at most two capacity values are checked.
+
+	\param min_bytes [in]
+	is the number of bytes that is requested.
+
+	\return
+	is the index of the capacity that is used for this request.
+	*/
+	static size_t capacity_index(size_t min_bytes)
+	{	const capacity_t* info = capacity_info();
+		size_t c_index = 0;
+		if( min_bytes > 0 )
+			c_index = info->octave[ floor_log2(min_bytes) ];
+		while( info->value[c_index] < min_bytes )
+		{	++c_index;
+			CPPAD_ASSERT_UNKNOWN( c_index < info->number );
+		}
+		return c_index;
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Number of bytes in the mapping for a block.
+
+	\param capacity [in]
+	is the capacity for the block.
+
+	\param huge_page [in]
+	is the block a huge page mapping.
+
+	\return
+	is the number of bytes, for the block and its capacity.
+	If \a huge_page is true,
+	it is rounded up to a multiple of CPPAD_THREAD_ALLOC_HUGE_PAGE_SIZE.
+	*/
+	static size_t map_length(size_t capacity, bool huge_page)
+	{	size_t length = sizeof(block_t) + capacity;
+		if( ! huge_page )
+			return length;
+		size_t page = CPPAD_THREAD_ALLOC_HUGE_PAGE_SIZE;
+		return ( (length + page - 1) / page ) * page;
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Number of NUMA nodes that this process can allocate memory on.
+
+	This uses the \c get_mempolicy system call (so that libnuma is not
+	required) and is only computed the first time this routine is called
+	(which must be in sequential execution mode).
+
+	\return
+	is the number of nodes in the set of memory nodes allowed for this
+	process. It is one if this set cannot be determined.
+	*/
+	static size_t numa_node_count(void)
+	{	static size_t count = 0;
+		if( count > 0 )
+			return count;
+		CPPAD_ASSERT_UNKNOWN( ! in_parallel() );
+		count = 1;
+# if defined(SYS_get_mempolicy)
+		// MPOL_F_MEMS_ALLOWED in <linux/mempolicy.h>
+		const unsigned long mpol_f_mems_allowed = 4;
+		// room for 1024 nodes (more than the kernel supports by default)
+		const size_t n_word = 16;
+		unsigned long mask[n_word];
+		size_t n_bit = std::numeric_limits<unsigned long>::digits;
+		int    mode;
+		if( 0 == syscall(SYS_get_mempolicy,
+			&mode, mask, n_word * n_bit, CPPAD_NULL, mpol_f_mems_allowed
+		) )
+		{	size_t n_node = 0;
+			for(size_t i = 0; i < n_word; i++)
+			{	for(size_t j = 0; j < n_bit; j++)
+					n_node += (mask[i] >> j) & 1;
+			}
+			if( n_node > 0 )
+				count = n_node;
+		}
+# endif
+		return count;
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Place memory on the NUMA node for the current thread.
+
+	The memory policy for the pages is set to prefer the node of the
+	processor that is running the current thread (using the \c mbind system
+	call, so that libnuma is not required).
+	If this is not possible, each page is touched by the current thread
+	so that the first touch policy places it on the same node.
+
+	\param c_map [in]
+	is the start of the memory (must be page aligned).
+
+	\param length [in]
+	is the number of bytes in the memory.
+	*/
+	static void numa_place(char* c_map, size_t length)
+	{	bool bound = false;
+# if defined(SYS_getcpu) && defined(SYS_mbind)
+		// MPOL_PREFERRED in <linux/mempolicy.h>
+		const int mpol_preferred = 1;
+		unsigned int cpu, node;
+		if( syscall(SYS_getcpu, &cpu, &node, CPPAD_NULL) == 0 )
+		{	unsigned long mask   = 1;
+			unsigned long n_bit  = std::numeric_limits<unsigned long>::digits;
+			if( node < n_bit )
+			{	mask <<= node;
+				// the system call ignores the last bit in the mask
+				bound = 0 == syscall(SYS_mbind,
+					c_map, length, mpol_preferred, &mask, n_bit + 1, 0
+				);
+			}
+		}
+# endif
+		if( ! bound )
+		{	size_t stride = CPPAD_THREAD_ALLOC_TOUCH_STRIDE;
+			for(size_t i = 0; i < length; i += stride)
+				c_map[i] = 0;
+		}
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Get a new block from the system.
+
+	If huge pages are enabled (see thread_alloc::huge_page) and
+	\a capacity is at least CPPAD_THREAD_ALLOC_HUGE_PAGE_SIZE,
+	the block is mapped at a huge page boundary and the system is advised
+	to use transparent huge pages for it.
+	If NUMA local placement is enabled (see thread_alloc::numa_local) and
+	\a capacity is at least CPPAD_THREAD_ALLOC_NUMA_MIN_BYTES,
+	the block is mapped and placed on the NUMA node for the current thread.
+	If this fails, or neither applies, \c operator \c new is used.
+
+	\param capacity [in]
+	is the capacity for the block.
+
+	\return
+	is the new block (only the mapped_ and huge_page_ fields are set).
+	*/
+	static block_t* new_node(size_t capacity)
+	{	block_t* node;
+# if CPPAD_THREAD_ALLOC_HUGE_PAGE || CPPAD_THREAD_ALLOC_NUMA
+		size_t page = CPPAD_THREAD_ALLOC_HUGE_PAGE_SIZE;
+		bool huge   = capacity >= page && set_get_huge_page(false);
+		bool numa   = capacity >= CPPAD_THREAD_ALLOC_NUMA_MIN_BYTES
+		            && set_get_numa_local(false);
+		if( huge || numa )
+		{	// a huge page mapping has an extra page so the block can start
+			// on a page boundary
+			size_t length = map_length(capacity, huge);
+			size_t extra  = 0;
+			if( huge )
+				extra = page;
+			void* v_map   = mmap(CPPAD_NULL, length + extra,
+				PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+			);
+			if( v_map != MAP_FAILED )
+			{	char* c_map = reinterpret_cast<char*>(v_map);
+# if CPPAD_THREAD_ALLOC_HUGE_PAGE
+				if( huge )
+				{	size_t lead = reinterpret_cast<size_t>(c_map) % page;
+					if( lead > 0 )
+						lead = page - lead;
+					// return the part of the mapping that is not used
+					if( lead > 0 )
+						munmap(c_map, lead);
+					munmap(c_map + lead + length, page - lead);
+					//
+					c_map += lead;
+					madvise(c_map, length, MADV_HUGEPAGE);
+				}
+# endif
+				if( numa )
+					numa_place(c_map, length);
+				node             = reinterpret_cast<block_t*>(c_map);
+				node->mapped_    = true;
+				node->huge_page_ = huge;
+				return node;
+			}
+		}
+# endif
+		void* v_node     = ::operator new(sizeof(block_t) + capacity);
+		node             = reinterpret_cast<block_t*>(v_node);
+		node->mapped_    = false;
+		node->huge_page_ = false;
+		return node;
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Return a block to the system.
+
+	\param node [in]
+	is a block that was created by new_node.
+
+	\param capacity [in]
+	is the capacity for the block.
+	*/
+	static void delete_node(block_t* node, size_t capacity)
+	{
+# if CPPAD_THREAD_ALLOC_HUGE_PAGE || CPPAD_THREAD_ALLOC_NUMA
+		if( node->mapped_ )
+		{	munmap(
+				reinterpret_cast<void*>(node),
+				map_length(capacity, node->huge_page_)
+			);
+			return;
+		}
+# endif
+		::operator delete( reinterpret_cast<void*>(node) );
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Record the statistics for a call to get_memory.
+
+	\param thread [in]
+	is the current thread.
+
+	\param c_index [in]
+	is the capacity index for this call.
+
+	\param hit [in]
+	is true if the memory was available for this thread.
+
+	\param tag [in]
+	is the tag for this call.
+
+	\param node [in]
+	is the block that is returned by this call.
+	If statistics are being collected its tag is set to \a tag.
+	Otherwise it is set to number_tag.
+	*/
+	static void record_get(
+		size_t   thread  ,
+		size_t   c_index ,
+		bool     hit     ,
+		tag_type tag     ,
+		block_t* node    )
+	{	if( ! set_get_statistics(false) )
+		{	node->tag_ = static_cast<unsigned char>(number_tag);
+			return;
+		}
+		CPPAD_ASSERT_UNKNOWN( tag < number_tag );
+		node->tag_              = static_cast<unsigned char>(tag);
+		thread_alloc_stat* stat = thread_stat(thread);
+		stat->get_count_[c_index]++;
+		if( hit )
+			stat->hit_count_[c_index]++;
+		stat->tag_inuse_[tag]  += capacity_info()->value[c_index];
+		size_t inuse            = thread_info(thread)->count_inuse_;
+		if( stat->peak_inuse_ < inuse )
+			stat->peak_inuse_ = inuse;
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Return a block to the lists for the thread that allocated it.
+
+	\param thread [in]
+	is the thread that allocated the block.
+	We must either be in sequential (not parallel) execution mode,
+	or \a thread must be the current thread.
+
+	\param node [in]
+	is the block that is being returned (it is currently in use).
+	*/
+	static void return_node(size_t thread, block_t* node)
+	{	size_t num_cap   = capacity_info()->number;
+		size_t c_index   = node->tc_index_ % num_cap;
+		size_t capacity  = capacity_info()->value[c_index];
+
+		CPPAD_ASSERT_UNKNOWN( thread == node->tc_index_ / num_cap );
+		thread_alloc_info* info = thread_info(thread);
+# ifndef NDEBUG
+		// remove node from inuse list
+		void* v_node         = reinterpret_cast<void*>(node);
+		void* v_ptr          = reinterpret_cast<void*>(node + 1);
+		block_t* inuse_root  = info->root_inuse_ + c_index;
+		block_t* previous    = inuse_root;
+		while( (previous->next_ != CPPAD_NULL) & (previous->next_ != v_node) )
+			previous = reinterpret_cast<block_t*>(previous->next_);	
+
+		// check that v_ptr is valid
+		if( previous->next_ != v_node )
+		{	using std::endl;
+			std::ostringstream oss;
+			oss << "return_memory: attempt to return memory not in use";
+			oss << endl;
+			oss << "v_ptr    = " << v_ptr    << endl;   
+			oss << "thread   = " << thread   << endl;   
+			oss << "capacity = " << capacity << endl;   
+			oss << "See CPPAD_TRACE_THREAD & CPPAD_TRACE_CAPACITY in";
+			oss << endl << "# include <cppad/thread_alloc.hpp>" << endl;
+			CPPAD_ASSERT_KNOWN(false, oss.str().c_str()	); 
+		}
+
+		// trace option
+		if( capacity==CPPAD_TRACE_CAPACITY && thread==CPPAD_TRACE_THREAD )
+		{	std::cout << "return_memory: v_ptr = " << v_ptr << std::endl; }
+
+		// remove v_ptr from inuse list
+		previous->next_  = node->next_;
+# endif
+		// capacity bytes are removed from the inuse pool
+		dec_inuse(capacity, thread);
+
+		// and from the bytes for its tag
+		if( node->tag_ < number_tag )
+			thread_stat(thread)->tag_inuse_[node->tag_] -= capacity;
+
+		// check for case where we just return the memory to the system
+		if( ! set_get_hold_memory(false) )
+		{	delete_node(node, capacity);
+			return;
+		}
+
+		// add this node to available list for this thread and capacity
+		block_t* available_root = info->root_available_ + c_index;
+		node->next_             = available_root->next_;
+		available_root->next_   = reinterpret_cast<void*>(node);
+
+		// capacity bytes are added to the available pool
+		inc_available(capacity, thread);
+	}
+# if CPPAD_THREAD_ALLOC_REMOTE_FREE
+	// -----------------------------------------------------------------------
+	/*!
+	Add a block to the remote free queue for the thread that allocated it.
+	This may be called by any thread (at the same time as other threads).
+
+	\param info [in]
+	is the information for the thread that allocated the block.
+
+	\param node [in]
+	is the block that is being returned (it is currently in use).
+	*/
+	static void remote_push(thread_alloc_info* info, block_t* node)
+	{	void* v_node = reinterpret_cast<void*>(node);
+		void* head;
+		do
+		{	head               = info->remote_free_;
+			node->remote_next_ = head;
+		}
+# if defined(__GNUC__)
+		while( ! __sync_bool_compare_and_swap(
+			&info->remote_free_, head, v_node
+		) );
+# else
+		while( _InterlockedCompareExchangePointer(
+			&info->remote_free_, v_node, head
+		) != head );
+# endif
+	}
+	// -----------------------------------------------------------------------
+	/*!
+	Return all the blocks in the remote free queue for a thread.
+
+	Only the thread that owns the queue removes blocks from it,
+	and it removes all of them at once, so there is no ABA problem.
+
+	\param thread [in]
+	is the thread that allocated the blocks.
+	We must either be in sequential (not parallel) execution mode,
+	or \a thread must be the current thread.
+	*/
+	static void remote_reclaim(size_t thread)
+	{	thread_alloc_info* info = thread_info(thread);
+		if( info->remote_free_ == CPPAD_NULL )
+			return;
+# if defined(__GNUC__)
+		void* v_node = __sync_lock_test_and_set(
+			&info->remote_free_, CPPAD_NULL
+		);
+# else
+		void* v_node = _InterlockedExchangePointer(
+			&info->remote_free_, CPPAD_NULL
+		);
+# endif
+		while( v_node != CPPAD_NULL )
+		{	block_t* node = reinterpret_cast<block_t*>(v_node);
+			v_node        = node->remote_next_;
+			return_node(thread, node);
+		}
+	}
+# endif
 	// ----------------------------------------------------------------------
 	/*!
 	Set and get the number of threads that are sharing memory.
@@ -740,7 +1395,9 @@ $index memory, allocate$$
 $index allocate, memory$$
 
 $head Syntax$$
-$icode%v_ptr% = thread_alloc::get_memory(%min_bytes%, %cap_bytes%)%$$
+$icode%v_ptr% = thread_alloc::get_memory(%min_bytes%, %cap_bytes%)
+%$$
+$icode%v_ptr% = thread_alloc::get_memory(%min_bytes%, %cap_bytes%, %tag%)%$$
 
 $head Purpose$$
 Use $cref thread_alloc$$ to obtain a minimum number of bytes of memory
@@ -769,6 +1426,15 @@ $codei%
 	%min_bytes% <= %cap_bytes%
 %$$
 
+$head tag$$
+This optional argument has prototype
+$codei%
+	thread_alloc::tag_type %tag%
+%$$
+and its default value is $code thread_alloc::other_tag$$.
+If $cref/statistics/ta_statistics/$$ are being collected,
+the memory is attributed to this tag until it is returned.
+
 $head v_ptr$$
 The return value $icode v_ptr$$ has prototype
 $codei%
@@ -783,9 +1449,15 @@ $list number$$
 The memory allocated by a previous call to $code get_memory$$ 
 is currently available for use.
 $lnext
-The current $icode min_bytes$$ is between 
+The current $icode min_bytes$$ is between
 the previous $icode min_bytes$$ and previous $icode cap_bytes$$.
 $lend
+The capacity for a request is determined in constant time
+using the most significant bit in $icode min_bytes$$.
+Large allocations can use transparent huge pages; see
+$cref/huge_page/ta_huge_page/$$.
+They can also be placed on the NUMA node of the thread that allocates them;
+see $cref/numa_local/ta_numa_local/$$.
 
 $head Alignment$$
 We call a memory allocation aligned if the address is a multiple
@@ -813,10 +1485,16 @@ $end
 	\param cap_bytes [out]
 	The actual number of bytes of memory obtained for use.
 
+	\param tag [in]
+	The memory is attributed to this tag (when statistics are collected).
+
 	\return
 	pointer to the beginning of the memory allocated for use.
  	*/
-	static void* get_memory(size_t min_bytes, size_t& cap_bytes)
+	static void* get_memory(
+		size_t   min_bytes          ,
+		size_t&  cap_bytes          ,
+		tag_type tag = other_tag    )
 	{	// see first_trace below	
 		CPPAD_ASSERT_FIRST_CALL_NOT_PARALLEL;
 
@@ -830,20 +1508,21 @@ $end
 		using std::cout;
 		using std::endl;
 
-		// determine the capacity for this request
-		size_t c_index   = 0;
-		const size_t* capacity_vec = capacity_info()->value;
-		while( capacity_vec[c_index] < min_bytes )
-		{	++c_index;	
-			CPPAD_ASSERT_UNKNOWN(c_index < num_cap );
-		}
-		cap_bytes = capacity_vec[c_index];
-
-		// determine the thread, capacity, and info for this thread
+		// determine the thread and info for this thread
 		size_t thread            = thread_num();
-		size_t tc_index          = thread * num_cap + c_index;
 		thread_alloc_info* info  = thread_info(thread);
 
+# if CPPAD_THREAD_ALLOC_REMOTE_FREE
+		// memory returned by other threads can now be used by this thread
+		if( info->remote_free_ != CPPAD_NULL )
+			remote_reclaim(thread);
+# endif
+
+		// determine the capacity for this request
+		size_t c_index  = capacity_index(min_bytes);
+		cap_bytes       = capacity_info()->value[c_index];
+		size_t tc_index = thread * num_cap + c_index;
+
 # ifndef NDEBUG
 		// trace allocation
 		static bool first_trace = true;
@@ -887,6 +1566,7 @@ $end
 			// adjust counts
 			inc_inuse(cap_bytes, thread);
 			dec_available(cap_bytes, thread);
+			record_get(thread, c_index, true, tag, node);
 
 			// return pointer to memory, do not inclue thread_alloc information
 			return v_ptr;
@@ -895,8 +1575,8 @@ $end
 		// Create a new node with thread_alloc information at front.
 		// This uses the system allocator, which is thread safe, but slower,
 		// because the thread might wait for a lock on the allocator.
-		v_node          = ::operator new(sizeof(block_t) + cap_bytes);
-		node            = reinterpret_cast<block_t*>(v_node);
+		node            = new_node(cap_bytes);
+		v_node          = reinterpret_cast<void*>(node);
 		node->tc_index_ = tc_index;
 		void* v_ptr     = reinterpret_cast<void*>(node + 1);
 
@@ -913,6 +1593,7 @@ $end
 
 		// adjust counts
 		inc_inuse(cap_bytes, thread);
+		record_get(thread, c_index, false, tag, node);
 
 		return v_ptr;
 	}
@@ -952,10 +1633,22 @@ obtained by a previous call to
 $cref/get_memory/ta_get_memory/$$ and not yet returned.
 
 $head Thread$$
-Either the $cref/current thread/ta_thread_num/$$ must be the same as during
+If the $cref/current thread/ta_thread_num/$$ is not the same as during
 the corresponding call to $cref/get_memory/ta_get_memory/$$,
-or the current execution mode must be sequential 
-(not $cref/parallel/ta_in_parallel/$$).
+and the current execution mode is $cref/parallel/ta_in_parallel/$$,
+the memory is put in a lock-free queue for the thread that allocated it.
+It is counted as in use by that thread until it next calls
+$cref/get_memory/ta_get_memory/$$,
+$cref/free_available/ta_free_available/$$,
+$cref/inuse/ta_inuse/$$, or
+$cref/available/ta_available/$$.
+(The last three can also be called for that thread in sequential mode.)
+This requires compare and swap instructions that are available with
+the GNU and Microsoft compilers.
+For other compilers,
+either the current thread must be the same as during
+the corresponding call to $code get_memory$$,
+or the current execution mode must be sequential.
 
 $head NDEBUG$$
 If $code NDEBUG$$ is defined, $icode v_ptr$$ is not checked (this is faster).
@@ -979,9 +1672,10 @@ $end
 	After this call, this pointer will available (and not in use).
 
 	\par
-	We must either be in sequential (not parallel) execution mode,
-	or the current thread must be the same as for the corresponding call
-	to \c get_memory.
+	If we are in parallel execution mode and the current thread is not
+	the same as for the corresponding call to \c get_memory,
+	the memory is put in the remote free queue for the thread that
+	allocated it (when CPPAD_THREAD_ALLOC_REMOTE_FREE is one).
  	*/
 	static void return_memory(void* v_ptr)
 	{	size_t num_cap   = capacity_info()->number;
@@ -989,62 +1683,22 @@ $end
 		block_t* node    = reinterpret_cast<block_t*>(v_ptr) - 1;
 		size_t tc_index  = node->tc_index_;
 		size_t thread    = tc_index / num_cap;
-		size_t c_index   = tc_index % num_cap;
-		size_t capacity  = capacity_info()->value[c_index];
 
 		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS );
+# if CPPAD_THREAD_ALLOC_REMOTE_FREE
+		// memory allocated by a different thread is returned to it later
+		if( thread != thread_num() && in_parallel() )
+		{	remote_push(thread_info(thread), node);
+			return;
+		}
+# else
 		CPPAD_ASSERT_KNOWN( 
 			thread == thread_num() || (! in_parallel()),
 			"Attempt to return memory for a different thread "
 			"while in parallel mode"
 		);
-
-		thread_alloc_info* info = thread_info(thread);
-# ifndef NDEBUG
-		// remove node from inuse list
-		void* v_node         = reinterpret_cast<void*>(node);
-		block_t* inuse_root  = info->root_inuse_ + c_index;
-		block_t* previous    = inuse_root;
-		while( (previous->next_ != CPPAD_NULL) & (previous->next_ != v_node) )
-			previous = reinterpret_cast<block_t*>(previous->next_);	
-
-		// check that v_ptr is valid
-		if( previous->next_ != v_node )
-		{	using std::endl;
-			std::ostringstream oss;
-			oss << "return_memory: attempt to return memory not in use";
-			oss << endl;
-			oss << "v_ptr    = " << v_ptr    << endl;   
-			oss << "thread   = " << thread   << endl;   
-			oss << "capacity = " << capacity << endl;   
-			oss << "See CPPAD_TRACE_THREAD & CPPAD_TRACE_CAPACITY in";
-			oss << endl << "# include <cppad/thread_alloc.hpp>" << endl;
-			CPPAD_ASSERT_KNOWN(false, oss.str().c_str()	); 
-		}
-
-		// trace option
-		if( capacity==CPPAD_TRACE_CAPACITY && thread==CPPAD_TRACE_THREAD )
-		{	std::cout << "return_memory: v_ptr = " << v_ptr << std::endl; }
-
-		// remove v_ptr from inuse list
-		previous->next_  = node->next_;
 # endif
-		// capacity bytes are removed from the inuse pool
-		dec_inuse(capacity, thread);
-
-		// check for case where we just return the memory to the system
-		if( ! set_get_hold_memory(false) )
-		{	::operator delete( reinterpret_cast<void*>(node) );
-			return;
-		}
-
-		// add this node to available list for this thread and capacity
-		block_t* available_root = info->root_available_ + c_index;
-		node->next_             = available_root->next_;
-		available_root->next_   = reinterpret_cast<void*>(node);
-
-		// capacity bytes are added to the available pool
-		inc_available(capacity, thread);
+		return_node(thread, node);
 	}
 /* -----------------------------------------------------------------------
 $begin ta_free_available$$
@@ -1116,6 +1770,9 @@ $end
 		size_t num_cap = capacity_info()->number;
 		if( num_cap == 0 )
 			return;
+# if CPPAD_THREAD_ALLOC_REMOTE_FREE
+		remote_reclaim(thread);
+# endif
 		const size_t*     capacity_vec  = capacity_info()->value;
 		size_t c_index;
 		thread_alloc_info* info = thread_info(thread);
@@ -1124,9 +1781,9 @@ $end
 			block_t* available_root = info->root_available_ + c_index;
 			void* v_ptr             = available_root->next_;
 			while( v_ptr != CPPAD_NULL )
-			{	block_t* node = reinterpret_cast<block_t*>(v_ptr); 
+			{	block_t* node = reinterpret_cast<block_t*>(v_ptr);
 				void* next    = node->next_;
-				::operator delete(v_ptr);
+				delete_node(node, capacity);
 				v_ptr         = next;
 
 				dec_available(capacity, thread);
@@ -1185,7 +1842,442 @@ $end
 	static void hold_memory(bool value)
 	{	bool set = true;
 		set_get_hold_memory(set, value);
-	}	
+	}
+/* -----------------------------------------------------------------------
+$begin ta_huge_page$$
+$spell
+	alloc
+	mmap
+	madvise
+	Taylor
+$$
+
+$section Use Huge Pages For Large Thread Alloc Memory$$
+$index thread_alloc, huge page$$
+$index huge page, thread_alloc$$
+$index memory, huge page$$
+
+$head Syntax$$
+$icode%ok% = thread_alloc::huge_page(%value%)%$$
+
+$head Purpose$$
+Sweeps over large arrays, for example the Taylor coefficients
+for a large operation sequence, can spend a significant amount of time
+on translation look-aside buffer misses.
+Calling $code huge_page$$ with $icode value$$ equal to true,
+instructs $code thread_alloc$$ to obtain new allocations,
+that have a capacity of at least two mega bytes,
+directly from the system using $code mmap$$
+and to advise the system to back them with transparent huge pages
+(using $code madvise$$).
+Smaller allocations are not affected.
+
+$head value$$
+This argument has prototype
+$codei%
+	bool %value%
+%$$
+If it is true, huge pages will be used for new large allocations.
+If it is false, future allocations will use the $code new$$ operator.
+By default (when $code huge_page$$ has not been called)
+huge pages are not used.
+Memory that has already been allocated is not affected;
+i.e., it is returned to the system using the method that allocated it.
+
+$head ok$$
+The return value has prototype
+$codei%
+	bool %ok%
+%$$
+It is true, if $icode value$$ is true and huge pages are supported
+on this system; i.e.,
+the system provides $code mmap$$ and $code madvise$$ with
+$code MADV_HUGEPAGE$$.
+Otherwise it is false (and huge pages are not used).
+Even when $icode ok$$ is true,
+the system may not back the memory with huge pages
+(for example if transparent huge pages are disabled).
+
+$head Parallel Mode$$
+This routine cannot be called in $cref/parallel/ta_in_parallel/$$
+execution mode.
+
+$head Example$$
+$cref thread_alloc.cpp$$
+
+$end
+*/
+	/*!
+ 	Change the thread_alloc huge page setting.
+
+	\param value [in]
+	New value for the thread_alloc huge page setting.
+
+	\return
+	is true if huge pages will be used for large allocations.
+	*/
+	static bool huge_page(bool value)
+	{	CPPAD_ASSERT_KNOWN(
+			! in_parallel(),
+			"huge_page: cannot be called in parallel mode"
+		);
+		bool set = true;
+# if CPPAD_THREAD_ALLOC_HUGE_PAGE
+		return set_get_huge_page(set, value);
+# else
+		set_get_huge_page(set, false);
+		return false;
+# endif
+	}
+/* -----------------------------------------------------------------------
+$begin ta_numa_local$$
+$spell
+	alloc
+	mmap
+	munmap
+	mbind
+	getcpu
+	mempolicy
+	libnuma
+	Taylor
+	NUMA
+	bool
+$$
+
+$section Place Large Thread Alloc Memory on the Local NUMA Node$$
+$index thread_alloc, NUMA$$
+$index NUMA, thread_alloc$$
+$index memory, NUMA$$
+
+$head Syntax$$
+$icode%ok% = thread_alloc::numa_local(%value%)%$$
+
+$head Purpose$$
+On systems with more than one memory node (for example a machine with
+two processor sockets), sweeps that read memory attached to
+a different node are slower.
+Calling $code numa_local$$ with $icode value$$ equal to true,
+instructs $code thread_alloc$$ to obtain new allocations,
+that have a capacity of at least 64 kilo bytes,
+directly from the system using $code mmap$$
+and to place them on the node of the processor that is running the thread
+that calls $cref/get_memory/ta_get_memory/$$.
+This includes the Taylor coefficient and partial derivative arrays
+used by $cref ADFun$$ objects in each thread.
+Smaller allocations are not affected.
+Each such allocation that is obtained from the system
+(instead of the thread's $cref/available/ta_available/$$ pool)
+costs a $code getcpu$$ and an $code mbind$$ system call,
+in addition to the $code mmap$$ call
+(and the corresponding $code munmap$$ call when it is freed).
+Thus this setting only helps when large allocations are reused,
+or are used for much longer than it takes to obtain them.
+
+$head Placement$$
+The memory policy for the allocation is set to prefer the current node
+(using the $code mbind$$ system call directly, so libnuma is not required).
+If this is not possible,
+the allocating thread touches each page of the allocation so that
+the system's first touch policy places the pages on its node.
+Note that memory that is returned to the
+$cref/available/ta_available/$$ pool of a thread
+is reused by the same thread, so it stays on the same node.
+
+$head value$$
+This argument has prototype
+$codei%
+	bool %value%
+%$$
+If it is true, large allocations will be placed on the local node.
+If it is false, future allocations will use the $code new$$ operator
+(unless $cref/huge_page/ta_huge_page/$$ applies).
+By default (when $code numa_local$$ has not been called)
+allocations are not placed.
+Memory that has already been allocated is not affected;
+i.e., it is returned to the system using the method that allocated it.
+
+$head ok$$
+The return value has prototype
+$codei%
+	bool %ok%
+%$$
+It is true, if $icode value$$ is true, this system provides
+anonymous memory mappings ($code mmap$$ with $code MAP_ANONYMOUS$$),
+and this process can allocate memory on more than one node
+(as reported by the $code get_mempolicy$$ system call).
+Otherwise it is false (and allocations are not placed).
+
+$head Parallel Mode$$
+This routine cannot be called in $cref/parallel/ta_in_parallel/$$
+execution mode.
+
+$head Example$$
+$cref thread_alloc.cpp$$, $cref thread_test.cpp$$
+
+$end
+*/
+	/*!
+ 	Change the thread_alloc NUMA local placement setting.
+
+	\param value [in]
+	New value for the thread_alloc NUMA local placement setting.
+
+	\return
+	is true if large allocations will be placed on the NUMA node
+	for the thread that allocates them
+	(this requires more than one node; see numa_node_count).
+	*/
+	static bool numa_local(bool value)
+	{	CPPAD_ASSERT_KNOWN(
+			! in_parallel(),
+			"numa_local: cannot be called in parallel mode"
+		);
+		bool set = true;
+# if CPPAD_THREAD_ALLOC_NUMA
+		// placement has no effect when there is only one node
+		return set_get_numa_local(set, value && numa_node_count() > 1);
+# else
+		set_get_numa_local(set, false);
+		return false;
+# endif
+	}
+/* -----------------------------------------------------------------------
+$begin ta_statistics$$
+$spell
+	alloc
+	inuse
+	num
+	os
+	std
+	ostream
+	Taylor
+	tag_type
+$$
+
+$section Thread Alloc Allocation Statistics$$
+$index thread_alloc, statistics$$
+$index statistics, thread_alloc$$
+$index memory, statistics$$
+$index peak, memory$$
+
+$head Syntax$$
+$codei%thread_alloc::statistics(%value%)
+%$$
+$icode%peak% = thread_alloc::peak_inuse(%thread%)
+%$$
+$icode%bytes% = thread_alloc::tag_inuse(%tag%, %thread%)
+%$$
+$codei%thread_alloc::statistics_report(%os%)%$$
+
+$head Purpose$$
+Collect statistics that can be used to size the memory for an application;
+the peak memory in use by each thread,
+the number of allocations for each capacity,
+the fraction of these allocations that used
+$cref/available/ta_available/$$ memory,
+and the amount of memory in use for each $icode tag$$.
+The cost of collecting these statistics is small,
+and when they are not being collected it is one test per
+$cref/get_memory/ta_get_memory/$$ call.
+
+$head value$$
+This argument has prototype
+$codei%
+	bool %value%
+%$$
+If it is true, the statistics are cleared (except for $icode bytes$$)
+and statistics are collected during future calls to
+$cref/get_memory/ta_get_memory/$$.
+If it is false, statistics are no longer collected.
+By default (when $code statistics$$ has not been called)
+statistics are not collected.
+This routine cannot be called in $cref/parallel/ta_in_parallel/$$
+execution mode.
+
+$head thread$$
+This argument has prototype
+$codei%
+	size_t %thread%
+%$$
+Either $cref/thread_num/ta_thread_num/$$ must be the same as $icode thread$$,
+or the current execution mode must be sequential
+(not $cref/parallel/ta_in_parallel/$$).
+
+$head peak$$
+The return value $icode peak$$ has prototype
+$codei%
+	size_t %peak%
+%$$
+It is the maximum, over the calls to $code get_memory$$ by the
+specified thread while statistics were being collected,
+of the number of bytes $cref/inuse/ta_inuse/$$ by the thread.
+
+$head tag$$
+This argument has prototype
+$codei%
+	thread_alloc::tag_type %tag%
+%$$
+The possible values for $icode tag$$ are listed below:
+$table
+$icode tag$$ $cnext memory used for $rnext
+$code thread_alloc::other_tag$$ $cnext
+	memory not included in the other tags $rnext
+$code thread_alloc::taylor_tag$$ $cnext
+	Taylor coefficients for $cref ADFun$$ objects $rnext
+$code thread_alloc::sparsity_tag$$ $cnext
+	sparsity patterns (vectors of sets) $rnext
+$code thread_alloc::recorder_tag$$ $cnext
+	recording and storing operation sequences $rnext
+$code thread_alloc::atomic_tag$$ $cnext
+	workspace for $cref/atomic/atomic_base/$$ functions
+$tend
+CppAD uses the first four values;
+$code atomic_tag$$ can be used by the implementation of
+an atomic function when it calls
+$cref/get_memory/ta_get_memory/tag/$$ or
+$cref/create_array/ta_create_array/tag/$$.
+
+$head bytes$$
+The return value $icode bytes$$ has prototype
+$codei%
+	size_t %bytes%
+%$$
+It is the number of bytes that are currently in use by the specified thread,
+were attributed to the specified $icode tag$$,
+and were obtained while statistics were being collected.
+
+$head os$$
+This argument has prototype
+$codei%
+	std::ostream& %os%
+%$$
+A report for each thread is written to $icode os$$.
+It contains $icode peak$$,
+the number of allocations and fraction from available memory
+for each capacity that was used,
+and $icode bytes$$ for each tag.
+This routine cannot be called in parallel execution mode.
+
+$head Example$$
+$cref thread_alloc.cpp$$
+
+$end
+*/
+	/*!
+	Start or stop collecting allocation statistics.
+
+	\param value [in]
+	If true, the statistics are cleared (except for the bytes in use for
+	each tag) and collected during future calls to get_memory.
+	If false, statistics are no longer collected.
+	*/
+	static void statistics(bool value)
+	{	CPPAD_ASSERT_KNOWN(
+			! in_parallel(),
+			"statistics: cannot be called in parallel mode"
+		);
+		if( value )
+		{	for(size_t thread = 0; thread < num_threads(); thread++)
+			{	thread_alloc_stat* stat = thread_stat(thread);
+				stat->peak_inuse_ = 0;
+				for(size_t c = 0; c < CPPAD_MAX_NUM_CAPACITY; c++)
+				{	stat->get_count_[c] = 0;
+					stat->hit_count_[c] = 0;
+				}
+			}
+		}
+		bool set = true;
+		set_get_statistics(set, value);
+	}
+	/*!
+	Peak memory in use by a thread.
+
+	\param thread [in]
+	Thread for which we are determining the peak memory.
+	This must either be the current thread,
+	or we must be in sequential mode.
+
+	\return
+	The maximum bytes in use after a call to get_memory while
+	statistics were being collected.
+	*/
+	static size_t peak_inuse(size_t thread)
+	{	CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+		CPPAD_ASSERT_UNKNOWN(
+			thread == thread_num() || (! in_parallel())
+		);
+		return thread_stat(thread)->peak_inuse_;
+	}
+	/*!
+	Memory in use by a thread for a tag.
+
+	\param tag [in]
+	Tag for which we are determining the memory.
+
+	\param thread [in]
+	Thread for which we are determining the memory.
+	This must either be the current thread,
+	or we must be in sequential mode.
+
+	\return
+	The bytes in use that were attributed to this tag
+	while statistics were being collected.
+	*/
+	static size_t tag_inuse(tag_type tag, size_t thread)
+	{	CPPAD_ASSERT_UNKNOWN( tag < number_tag );
+		CPPAD_ASSERT_UNKNOWN( thread < CPPAD_MAX_NUM_THREADS);
+		CPPAD_ASSERT_UNKNOWN(
+			thread == thread_num() || (! in_parallel())
+		);
+# if CPPAD_THREAD_ALLOC_REMOTE_FREE
+		remote_reclaim(thread);
+# endif
+		return thread_stat(thread)->tag_inuse_[tag];
+	}
+	/*!
+	Write a report of the allocation statistics for each thread.
+
+	\param os [in,out]
+	Stream that the report is written to.
+	*/
+	static void statistics_report(std::ostream& os)
+	{	CPPAD_ASSERT_KNOWN(
+			! in_parallel(),
+			"statistics_report: cannot be called in parallel mode"
+		);
+		using std::setw;
+		using std::endl;
+		static const char* tag_name[] = {
+			"other", "taylor", "sparsity", "recorder", "atomic"
+		};
+		CPPAD_ASSERT_UNKNOWN(
+			sizeof(tag_name) / sizeof(tag_name[0]) == size_t(number_tag)
+		);
+		const capacity_t* capacity = capacity_info();
+		for(size_t thread = 0; thread < num_threads(); thread++)
+		{	const thread_alloc_stat* stat = thread_stat(thread);
+			os << "thread = " << thread;
+			os << ", inuse = " << inuse(thread);
+			os << ", peak_inuse = " << stat->peak_inuse_ << endl;
+			os << setw(20) << "capacity";
+			os << setw(20) << "get_count";
+			os << setw(20) << "hit_fraction" << endl;
+			for(size_t c = 0; c < capacity->number; c++)
+			if( stat->get_count_[c] > 0 )
+			{	double fraction = double( stat->hit_count_[c] )
+				                / double( stat->get_count_[c] );
+				os << setw(20) << capacity->value[c];
+				os << setw(20) << stat->get_count_[c];
+				os << setw(20) << fraction << endl;
+			}
+			os << setw(20) << "tag";
+			os << setw(20) << "inuse" << endl;
+			for(size_t tag = 0; tag < size_t(number_tag); tag++)
+			{	os << setw(20) << tag_name[tag];
+				os << setw(20) << stat->tag_inuse_[tag] << endl;
+			}
+		}
+	}
 	
 /* -----------------------------------------------------------------------
 $begin ta_inuse$$
@@ -1226,6 +2318,9 @@ $codei%
 	size_t %num_bytes%
 %$$
 It is the number of bytes currently in use by the specified thread.
+Memory that was allocated by this thread, and
+$cref/returned/ta_return_memory/Thread/$$ by a different thread,
+is no longer counted as in use.
 
 $head Example$$
 $cref thread_alloc.cpp$$
@@ -1250,6 +2345,9 @@ $end
 		CPPAD_ASSERT_UNKNOWN( 
 			thread == thread_num() || (! in_parallel()) 
 		);
+# if CPPAD_THREAD_ALLOC_REMOTE_FREE
+		remote_reclaim(thread);
+# endif
 		thread_alloc_info* info = thread_info(thread);
 		return info->count_inuse_;
 	}
@@ -1308,6 +2406,9 @@ $end
 		CPPAD_ASSERT_UNKNOWN( 
 			thread == thread_num() || (! in_parallel()) 
 		);
+# if CPPAD_THREAD_ALLOC_REMOTE_FREE
+		remote_reclaim(thread);
+# endif
 		thread_alloc_info* info = thread_info(thread);
 		return info->count_available_;
 	}
@@ -1327,7 +2428,9 @@ $index array, allocate$$
 $index allocate, array$$
 
 $head Syntax$$
-$icode%array% = thread_alloc::create_array<%Type%>(%size_min%, %size_out%)%$$.
+$icode%array% = thread_alloc::create_array<%Type%>(%size_min%, %size_out%)
+%$$
+$icode%array% = thread_alloc::create_array<%Type%>(%size_min%, %size_out%, %tag%)%$$
 
 $head Purpose$$
 Create a new raw array using $cref thread_alloc$$ memory allocator 
@@ -1355,6 +2458,13 @@ Upon return, it is the actual number of elements
 in $icode array$$ 
 ($icode% size_min %<=% size_out%$$).
 
+$head tag$$
+This optional argument has prototype
+$codei%
+	thread_alloc::tag_type %tag%
+%$$
+It is passed to $cref/get_memory/ta_get_memory/tag/$$.
+
 $head array$$
 The return value $icode array$$ has prototype
 $codei%
@@ -1401,9 +2511,12 @@ $end
 	\param size_out [out]
 	The actual number of elements in the array.
 
+	\param tag [in]
+	The memory is attributed to this tag (when statistics are collected).
+
 	\return
 	pointer to the first element of the array.
-	The default constructor is used to initialize 
+	The default constructor is used to initialize
 	all the elements of the array.
 
 	\par
@@ -1411,12 +2524,15 @@ $end
 	is set to size_out.
 	*/
 	template <class Type>
-	static Type* create_array(size_t size_min, size_t& size_out)
+	static Type* create_array(
+		size_t   size_min           ,
+		size_t&  size_out           ,
+		tag_type tag = other_tag    )
 	{	// minimum number of bytes to allocate
 		size_t min_bytes = size_min * sizeof(Type);
-		// do the allocation 
+		// do the allocation
 		size_t num_bytes;
-		void*  v_ptr     = get_memory(min_bytes, num_bytes);
+		void*  v_ptr     = get_memory(min_bytes, num_bytes, tag);
 		// This is where the array starts
 		Type*  array     = reinterpret_cast<Type*>(v_ptr);
 		// number of Type values in the allocation
@@ -1585,4 +2701,11 @@ $end
 # undef CPPAD_MIN_DOUBLE_CAPACITY
 # undef CPPAD_TRACE_CAPACITY
 # undef CPPAD_TRACE_THREAD
+# undef CPPAD_THREAD_ALLOC_REMOTE_FREE
+# undef CPPAD_THREAD_ALLOC_CACHE_LINE
+# undef CPPAD_THREAD_ALLOC_HUGE_PAGE
+# undef CPPAD_THREAD_ALLOC_HUGE_PAGE_SIZE
+# undef CPPAD_THREAD_ALLOC_NUMA
+# undef CPPAD_THREAD_ALLOC_NUMA_MIN_BYTES
+# undef CPPAD_THREAD_ALLOC_TOUCH_STRIDE
 # endif
@@ -2,7 +2,7 @@
 # ifndef CPPAD_BASE_ALLOC_INCLUDED
 # define CPPAD_BASE_ALLOC_INCLUDED
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-13 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the
@@ -343,13 +343,13 @@ namespace CppAD {
 	public:
 		// machine epsilon
 		static base_alloc epsilon(void)
-		{	return std::numeric_limits<base_alloc>::epsilon(); }
+		{	return std::numeric_limits<double>::epsilon(); }
 		// minimum positive normalized value
 		static base_alloc min(void)
-		{	return std::numeric_limits<base_alloc>::min(); }
+		{	return std::numeric_limits<double>::min(); }
 		// maximum finite value
 		static base_alloc max(void)
-		{	return std::numeric_limits<base_alloc>::max(); }
+		{	return std::numeric_limits<double>::max(); }
 	};
 	// deprecated machine epsilon
 	template <> 
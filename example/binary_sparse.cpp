@@ -0,0 +1,174 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin binary_sparse.cpp$$
+$spell
+	Cpp
+$$
+
+$section Write and Read Sparse Derivative Information: Example and Test$$
+$index binary_sparse, example$$
+$index example, binary_sparse$$
+$index write_sparse, example$$
+$index read_sparse, example$$
+
+$code
+$verbatim%example/binary_sparse.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <sstream>
+# include <cppad/cppad.hpp>
+
+bool binary_sparse(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	using CppAD::vector;
+	double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+	size_t i, j, k;
+
+	// record a function with a tridiagonal Hessian
+	size_t n = 5;
+	vector< AD<double> > ax(n), ay(1);
+	for(j = 0; j < n; j++)
+		ax[j] = double(j + 1);
+	CppAD::Independent(ax);
+	ay[0] = 0.;
+	for(j = 0; j < n - 1; j++)
+		ay[0] += ax[j] * ax[j] * ax[j+1];
+	CppAD::ADFun<double> f(ax, ay);
+
+	// Hessian sparsity pattern
+	typedef vector< std::set<size_t> > SetVector;
+	SetVector r(n), s(1);
+	for(j = 0; j < n; j++)
+		r[j].insert(j);
+	f.ForSparseJac(n, r);
+	s[0].insert(0);
+	SetVector p = f.RevSparseHes(n, s);
+
+	// request the lower triangle of the Hessian
+	vector<size_t> row, col;
+	for(i = 0; i < n; i++)
+	{	std::set<size_t>::iterator itr;
+		for(itr = p[i].begin(); itr != p[i].end(); itr++) if( *itr <= i )
+		{	row.push_back(i);
+			col.push_back(*itr);
+		}
+	}
+	size_t K = row.size();
+
+	// compute the Hessian (this computes the coloring)
+	vector<double> x(n), w(1), hes_f(K), hes_g(K);
+	for(j = 0; j < n; j++)
+		x[j] = double(j + 2);
+	w[0] = 1.0;
+	CppAD::sparse_hessian_work work_f;
+	work_f.color_method = "cppad.acyclic";
+	f.SparseHessian(x, w, p, row, col, hes_f, work_f);
+
+	// write the sparsity pattern, requested entries, and coloring
+	// (a file opened with std::ios::binary could be used in place of
+	// the string stream)
+	std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+	f.write_sparse(ss, p, row, col, work_f);
+
+	// a function object g with the same operation sequence
+	// (as would be the case for a different process that records f
+	// or uses read_binary)
+	for(j = 0; j < n; j++)
+		ax[j] = double(n - j);
+	CppAD::Independent(ax);
+	ay[0] = 0.;
+	for(j = 0; j < n - 1; j++)
+		ay[0] += ax[j] * ax[j] * ax[j+1];
+	CppAD::ADFun<double> g(ax, ay);
+
+	// read the information (no sparsity or coloring calculation for g)
+	SetVector p_g;
+	vector<size_t> row_g, col_g;
+	CppAD::sparse_hessian_work work_g;
+	ok &= g.read_sparse(ss, p_g, row_g, col_g, work_g);
+	ok &= row_g.size() == K;
+	for(k = 0; k < K; k++)
+		ok &= row_g[k] == row[k] && col_g[k] == col[k];
+	for(i = 0; i < n; i++)
+		ok &= p_g[i] == p[i];
+	ok &= work_g.color_method == "cppad.acyclic";
+
+	// compute the Hessian for g using the information that was read
+	g.SparseHessian(x, w, p_g, row_g, col_g, hes_g, work_g);
+	for(k = 0; k < K; k++)
+		ok &= NearEqual(hes_f[k], hes_g[k], eps, eps);
+
+	// Jacobian information using a vector of bool sparsity pattern
+	vector<bool> p_jac(n), p_jac_g;
+	vector<size_t> r_jac(n), c_jac(n), r_jac_g, c_jac_g;
+	for(j = 0; j < n; j++)
+	{	p_jac[j] = true;
+		r_jac[j] = 0;
+		c_jac[j] = j;
+	}
+	vector<double> jac_f(n), jac_g(n);
+	CppAD::sparse_jacobian_work work_jac_f, work_jac_g;
+	f.SparseJacobianReverse(x, p_jac, r_jac, c_jac, jac_f, work_jac_f);
+	f.write_sparse(ss, p_jac, r_jac, c_jac, work_jac_f);
+	ok &= g.read_sparse(ss, p_jac_g, r_jac_g, c_jac_g, work_jac_g);
+	g.SparseJacobianReverse(x, p_jac_g, r_jac_g, c_jac_g, jac_g, work_jac_g);
+	for(j = 0; j < n; j++)
+		ok &= NearEqual(jac_f[j], jac_g[j], eps, eps);
+
+	// information for a Hessian can not be read as a Jacobian
+	ss.clear();
+	ss.seekg(0);
+	ok &= ! g.read_sparse(ss, p_jac_g, r_jac_g, c_jac_g, work_jac_g);
+
+	// a different operation sequence has a different fingerprint
+	CppAD::Independent(ax);
+	ay[0] = 0.;
+	for(j = 0; j < n - 1; j++)
+		ay[0] += ax[j] * ax[j+1] * ax[j+1];
+	CppAD::ADFun<double> h(ax, ay);
+	ss.clear();
+	ss.seekg(0);
+	CppAD::sparse_hessian_work work_h;
+	ok &= ! h.read_sparse(ss, p_g, row_g, col_g, work_h);
+	ok &= work_h.color.size() == 0;
+
+	// information that has been truncated
+	std::stringstream ss2(std::ios::in | std::ios::out | std::ios::binary);
+	f.write_sparse(ss2, p, row, col, work_f);
+	std::string data = ss2.str();
+	std::stringstream truncated(
+		data.substr(0, data.size() / 2),
+		std::ios::in | std::ios::binary
+	);
+	ok &= ! g.read_sparse(truncated, p_g, row_g, col_g, work_g);
+
+	// information where the length of the sparsity pattern has been
+	// corrupted (it follows the magic characters and 7 values of type size_t)
+	size_t offset = 8 + 7 * sizeof(size_t);
+	size_t length = 2 * n * n;
+	data.replace(offset, sizeof(size_t),
+		reinterpret_cast<const char*>(&length), sizeof(size_t)
+	);
+	std::stringstream corrupted(data, std::ios::in | std::ios::binary);
+	ok &= ! g.read_sparse(corrupted, p_g, row_g, col_g, work_g);
+
+	return ok;
+}
+
+// END C++
@@ -0,0 +1,141 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin binary_tape.cpp$$
+$spell
+	Cpp
+$$
+
+$section Write and Read an Operation Sequence in Binary Form: Example and Test$$
+$index binary_tape, example$$
+$index example, binary_tape$$
+$index write_binary, example$$
+$index read_binary, example$$
+
+$code
+$verbatim%example/binary_tape.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <sstream>
+# include <cppad/cppad.hpp>
+
+bool binary_tape(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	using CppAD::vector;
+	double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+	size_t j, i;
+
+	// domain space vector
+	size_t n = 2;
+	vector< AD<double> > ax(n);
+	ax[0] = 0.5;
+	ax[1] = 2.0;
+
+	// declare independent variables and starting recording
+	CppAD::Independent(ax);
+
+	// a VecAD object with a variable index
+	CppAD::VecAD<double> av(2);
+	av[0] = 3.0;
+	av[1] = 4.0;
+	AD<double> aindex = CppAD::CondExpLt(ax[0], ax[1], AD<double>(0), AD<double>(1));
+
+	// range space vector (the last component is a parameter)
+	size_t m = 3;
+	vector< AD<double> > ay(m);
+	ay[0] = exp( ax[0] ) * sin( ax[1] ) + av[aindex];
+	ay[1] = CppAD::CondExpLt(ax[0], ax[1], ax[0] * ax[1], ax[0] - ax[1]);
+	ay[2] = 5.0;
+
+	// create f: x -> y, stop tape recording, and optimize the tape
+	CppAD::ADFun<double> f(ax, ay);
+	f.optimize();
+
+	// write the operation sequence (a file opened with std::ios::binary
+	// could be used in place of the string stream)
+	std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+	f.write_binary(ss);
+
+	// read the operation sequence into g
+	CppAD::ADFun<double> g;
+	ok &= g.read_binary(ss);
+	ok &= g.Domain()   == n;
+	ok &= g.Range()    == m;
+	ok &= g.size_var() == f.size_var();
+	ok &= g.size_op()  == f.size_op();
+	ok &= g.size_par() == f.size_par();
+	ok &= g.Parameter(2);
+
+	// check g against f for both cases of the conditional expressions
+	vector<double> x(n), y_f, y_g, dx(n), dy_f, dy_g, w(m), dw_f, dw_g;
+	for(size_t k = 0; k < 2; k++)
+	{	x[0] = 0.5 + 2.0 * double(k);
+		x[1] = 2.0;
+		y_f  = f.Forward(0, x);
+		y_g  = g.Forward(0, x);
+		for(i = 0; i < m; i++)
+			ok &= y_f[i] == y_g[i];
+
+		dx[0] = 1.0;
+		dx[1] = 2.0;
+		dy_f  = f.Forward(1, dx);
+		dy_g  = g.Forward(1, dx);
+		for(i = 0; i < m; i++)
+			ok &= NearEqual(dy_f[i], dy_g[i], eps, eps);
+
+		for(i = 0; i < m; i++)
+			w[i] = double(i + 1);
+		dw_f = f.Reverse(1, w);
+		dw_g = g.Reverse(1, w);
+		for(j = 0; j < n; j++)
+			ok &= NearEqual(dw_f[j], dw_g[j], eps, eps);
+	}
+
+	// reading data that does not begin with a binary operation sequence
+	std::stringstream bad("not an operation sequence");
+	ok &= ! g.read_binary(bad);
+	ok &= g.Domain() == 0;
+	ok &= g.Range()  == 0;
+
+	// reading an operation sequence that has been truncated
+	std::stringstream ss2(std::ios::in | std::ios::out | std::ios::binary);
+	f.write_binary(ss2);
+	std::string data = ss2.str();
+	std::stringstream truncated(
+		data.substr(0, data.size() / 2),
+		std::ios::in | std::ios::binary
+	);
+	ok &= ! g.read_binary(truncated);
+	ok &= g.Domain() == 0;
+
+	// reading an operation sequence where the length of the operator
+	// vector has been corrupted (it follows the magic characters and
+	// 6 + 4 + n + 2 * m + 2 values of type size_t)
+	size_t offset = 8 + sizeof(size_t) * (6 + 4 + n + 2 * m + 2);
+	size_t length = size_t(-1) / 2;
+	data.replace(offset, sizeof(size_t),
+		reinterpret_cast<const char*>(&length), sizeof(size_t)
+	);
+	std::stringstream corrupted(data, std::ios::in | std::ios::binary);
+	ok &= ! g.read_binary(corrupted);
+	ok &= g.Domain() == 0;
+
+	return ok;
+}
+
+// END C++
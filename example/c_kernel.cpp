@@ -0,0 +1,136 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin c_kernel.cpp$$
+$spell
+	Cpp
+$$
+
+$section Generate, Compile, and Load C Source: Example and Test$$
+$index c_source, example$$
+$index c_kernel, example$$
+$index example, c_kernel$$
+
+$head Files$$
+The source and library files are written to a temporary directory
+that is removed at the end of the test.
+
+$code
+$verbatim%example/c_kernel.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <sstream>
+# include <cstdio>
+# include <cstdlib>
+# include <unistd.h>
+# include <cppad/cppad.hpp>
+# include <cppad/c_kernel.hpp>
+
+bool c_kernel(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	using CppAD::vector;
+	double eps = 100. * CppAD::numeric_limits<double>::epsilon();
+	size_t j, i;
+
+	// domain space vector
+	size_t n = 3;
+	vector< AD<double> > ax(n);
+	for(j = 0; j < n; j++)
+		ax[j] = double(j + 1);
+
+	// declare independent variables and starting recording
+	CppAD::Independent(ax);
+
+	// range space vector
+	size_t m = 2;
+	vector< AD<double> > ay(m);
+	AD<double> au = ax[0] * ax[1] - 2. / ax[2];
+	ay[0] = exp(au) * sin(ax[1]) + sqrt(ax[2]) - pow(ax[0], ax[2]);
+	ay[1] = CppAD::CondExpLt(ax[0], ax[1], log(ax[1]) / ax[0], cos(au));
+	ay[1] += abs(ax[0] - ax[2]) + ax[0] + ax[1] - 4.;
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+
+	// generate the C source code
+	std::ostringstream os;
+	ok &= f.c_source("c_kernel_example", os);
+
+	// temporary directory for the source and library files
+	// (its name contains a space and a quote, which are passed to the
+	// compile command as part of quoted file names)
+	char dir[] = "/tmp/cppad c_kernel's_XXXXXX";
+	if( mkdtemp(dir) == CPPAD_NULL )
+	{	std::cerr << "c_kernel: cannot create " << dir << std::endl;
+		return false;
+	}
+	std::string src_file = std::string(dir) + "/c_kernel_example.c";
+	std::string lib_file = std::string(dir) + "/libc_kernel_example.so";
+
+	// compile and load the source
+	std::string err_msg;
+	CppAD::c_kernel kernel(
+		"c_kernel_example", os.str(), err_msg, "cc -O2 -fPIC -shared", dir
+	);
+
+	// the library is loaded, so the files are no longer needed
+	std::remove( src_file.c_str() );
+	std::remove( lib_file.c_str() );
+	rmdir(dir);
+	if( err_msg != "" )
+	{	std::cerr << err_msg << std::endl;
+		return false;
+	}
+	ok &= kernel.Domain() == n;
+	ok &= kernel.Range()  == m;
+
+	// a name that is not a C identifier is an error (nothing is compiled)
+	std::string bad_msg;
+	CppAD::c_kernel bad("bad name;", os.str(), bad_msg);
+	ok &= bad_msg != "";
+
+	// check both cases for the conditional expression
+	vector<double> x(n), y_f, y_k, dx(n), dy_f, dy_k, w(m), dw_f, dw_k;
+	for(size_t k = 0; k < 2; k++)
+	{	x[0] = 0.5 + double(k);
+		x[1] = 1.0;
+		x[2] = 2.0;
+		y_f  = f.Forward(0, x);
+		y_k  = kernel.Forward(0, x);
+		for(i = 0; i < m; i++)
+			ok &= NearEqual(y_f[i], y_k[i], eps, eps);
+
+		for(j = 0; j < n; j++)
+			dx[j] = double(j + 1);
+		dy_f = f.Forward(1, dx);
+		dy_k = kernel.Forward(1, dx);
+		for(i = 0; i < m; i++)
+			ok &= NearEqual(dy_f[i], dy_k[i], eps, eps);
+
+		w[0] = 1.0;
+		w[1] = 2.0;
+		dw_f = f.Reverse(1, w);
+		dw_k = kernel.Reverse(1, w);
+		for(j = 0; j < n; j++)
+			ok &= NearEqual(dw_f[j], dw_k[j], eps, eps);
+	}
+
+	return ok;
+}
+
+// END C++
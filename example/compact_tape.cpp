@@ -0,0 +1,152 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin compact_tape.cpp$$
+$spell
+	Cpp
+$$
+
+$section Compact Operator Arguments: Example and Test$$
+$index compact_tape, example$$
+$index example, compact_tape$$
+$index test, compact_tape$$
+
+$code
+$verbatim%example/compact_tape.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+
+bool compact_tape(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	using CppAD::vector;
+	double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+	size_t j, i, k;
+
+	// domain space vector
+	size_t n = 3;
+	vector< AD<double> > ax(n);
+	for(j = 0; j < n; j++)
+		ax[j] = double(j + 1);
+
+	// declare independent variables and starting recording
+	CppAD::Independent(ax);
+
+	// a VecAD object with a variable index
+	CppAD::VecAD<double> av(2);
+	av[0] = 3.0;
+	av[1] = 4.0;
+	AD<double> aindex = CppAD::CondExpLt(
+		ax[0], ax[1], AD<double>(0), AD<double>(1)
+	);
+
+	// range space vector
+	size_t m = 2;
+	vector< AD<double> > ay(m);
+	AD<double> asum = 0.;
+	for(k = 0; k < 20; k++)
+		asum += sin( ax[k % n] ) * double(k) - ax[(k + 1) % n];
+	ay[0] = asum * av[aindex];
+	ay[1] = CppAD::CondExpLt(ax[0], ax[1], exp(ax[2]), ax[2] * ax[2]);
+
+	// create f: x -> y, stop tape recording, and optimize the tape
+	// (this generates cumulative summation and conditional skip operators)
+	CppAD::ADFun<double> f(ax, ay);
+	f.optimize();
+
+	// store the arguments for a copy of f in compact form
+	CppAD::ADFun<double> g;
+	g = f;
+	ok &= ! g.compact_tape();
+	ok &= g.size_op_arg_compact() == 0;
+	g.compact_tape(true);
+	ok &= g.compact_tape();
+
+	// the compact form is smaller than the original form
+	size_t s = g.size_op_arg_compact();
+	ok &= 0 < s && s < f.size_op_arg() * sizeof(CppAD::addr_t);
+	ok &= g.size_op_arg() == f.size_op_arg();
+	ok &= g.size_op_seq() < f.size_op_seq();
+
+	// compare f and g for both cases of the conditional expressions
+	size_t p = 2;
+	vector<double> x(n), xp(n * (p + 1)), w(m * (p + 1));
+	vector<double> y_f, y_g;
+	for(size_t c = 0; c < 2; c++)
+	{	for(j = 0; j < n; j++)
+		{	x[j] = double(j + 1) + 2. * double(c);
+			if( j == 1 )
+				x[j] = 2.5;
+			for(k = 0; k <= p; k++)
+				xp[j * (p + 1) + k] = k == 0 ? x[j] : double(j + k);
+		}
+		// forward mode orders zero through p
+		y_f = f.Forward(p, xp);
+		y_g = g.Forward(p, xp);
+		for(i = 0; i < m * (p + 1); i++)
+			ok &= NearEqual(y_f[i], y_g[i], eps, eps);
+
+		// reverse mode of order p + 1
+		for(i = 0; i < m * (p + 1); i++)
+			w[i] = double(i + 1);
+		vector<double> d_f = f.Reverse(p + 1, w);
+		vector<double> d_g = g.Reverse(p + 1, w);
+		for(j = 0; j < n * (p + 1); j++)
+			ok &= NearEqual(d_f[j], d_g[j], eps, eps);
+
+		// forward mode with multiple directions
+		size_t r = 2;
+		vector<double> xq(n * r);
+		f.Forward(0, x);
+		g.Forward(0, x);
+		for(j = 0; j < n * r; j++)
+			xq[j] = double(j + 1);
+		vector<double> dq_f = f.Forward(1, r, xq);
+		vector<double> dq_g = g.Forward(1, r, xq);
+		for(i = 0; i < m * r; i++)
+			ok &= NearEqual(dq_f[i], dq_g[i], eps, eps);
+	}
+
+	// sparsity patterns
+	vector<bool> r(n * n), s_f, s_g, h(m), h_f, h_g;
+	for(j = 0; j < n * n; j++)
+		r[j] = (j / n) == (j % n);
+	s_f = f.ForSparseJac(n, r);
+	s_g = g.ForSparseJac(n, r);
+	for(k = 0; k < m * n; k++)
+		ok &= s_f[k] == s_g[k];
+	for(i = 0; i < m; i++)
+		h[i] = true;
+	h_f = f.RevSparseHes(n, h);
+	h_g = g.RevSparseHes(n, h);
+	for(k = 0; k < n * n; k++)
+		ok &= h_f[k] == h_g[k];
+
+	// convert back to the original form
+	g.compact_tape(false);
+	ok &= ! g.compact_tape();
+	ok &= g.size_op_seq() == f.size_op_seq();
+	vector<double> z_f = f.Forward(0, x);
+	vector<double> z_g = g.Forward(0, x);
+	for(i = 0; i < m; i++)
+		ok &= z_f[i] == z_g[i];
+
+	return ok;
+}
+
+// END C++
@@ -60,7 +60,10 @@ extern bool Atan(void);
 extern bool Atan2(void);
 extern bool base_require(void);
 extern bool BenderQuad(void);
+extern bool binary_sparse(void);
+extern bool binary_tape(void);
 extern bool BoolFun(void);
+extern bool c_kernel(void);
 extern bool capacity_order(void);
 extern bool change_const(void);
 extern bool check_for_nan(void);
@@ -68,6 +71,7 @@ extern bool CheckNumericType(void);
 extern bool CheckSimpleVector(void);
 extern bool colpack_hes(void);
 extern bool colpack_jac(void);
+extern bool compact_tape(void);
 extern bool Compare(void);
 extern bool compare_change(void);
 extern bool complex_poly(void);
@@ -89,6 +93,7 @@ extern bool ForTwo(void);
 extern bool ForSparseJac(void);
 extern bool Forward(void);
 extern bool forward_dir(void);
+extern bool forward0_batch(void);
 extern bool forward_order(void);
 extern bool fun_assign(void);
 extern bool FunCheck(void);
@@ -140,6 +145,7 @@ extern bool Pow(void);
 extern bool pow_int(void);
 extern bool print_for(void);
 extern bool reverse_any(void);
+extern bool reverse_dir(void);
 extern bool reverse_one(void);
 extern bool reverse_three(void);
 extern bool reverse_two(void);
@@ -222,12 +228,15 @@ int main(void)
 	ok &= Run( Atan,              "Atan"             );
 	ok &= Run( Atan2,             "Atan2"            );
 	ok &= Run( BenderQuad,        "BenderQuad"       );
+	ok &= Run( binary_sparse,     "binary_sparse"    );
+	ok &= Run( binary_tape,       "binary_tape"      );
 	ok &= Run( BoolFun,           "BoolFun"          );
 	ok &= Run( capacity_order,    "capacity_order"   );
 	ok &= Run( change_const,      "change_const"     );
 	ok &= Run( check_for_nan,     "check_for_nan"    );
 	ok &= Run( CheckNumericType,  "CheckNumericType" );
 	ok &= Run( CheckSimpleVector, "CheckSimpleVector");
+	ok &= Run( compact_tape,      "compact_tape"     );
 	ok &= Run( Compare,           "Compare"          );
 	ok &= Run( compare_change,    "compare_change"   );
 	ok &= Run( complex_poly,      "complex_poly"     );
@@ -246,6 +255,7 @@ int main(void)
 	ok &= Run( ForTwo,            "ForTwo"           );
 	ok &= Run( Forward,           "Forward"          );
 	ok &= Run( forward_dir,       "forward_dir"      );
+	ok &= Run( forward0_batch,    "forward0_batch"   );
 	ok &= Run( forward_order,     "forward_order"    );
 	ok &= Run( ForSparseJac,      "ForSparseJac"     );
 	ok &= Run( fun_assign,        "fun_assign"       );
@@ -295,6 +305,7 @@ int main(void)
 	ok &= Run( Pow,               "Pow"              );
 	ok &= Run( pow_int,           "pow_int"          );
 	ok &= Run( reverse_any,       "reverse_any"      );
+	ok &= Run( reverse_dir,       "reverse_dir"      );
 	ok &= Run( reverse_one,       "reverse_one"      );
 	ok &= Run( reverse_three,     "reverse_three"    );
 	ok &= Run( reverse_two,       "reverse_two"      );
@@ -337,6 +348,9 @@ int main(void)
 	ok &= Run( colpack_hes,       "colpack_hes"      );
 	ok &= Run( colpack_jac,       "colpack_jac"      );
 # endif
+# ifdef CPPAD_C_KERNEL_EXAMPLES
+	ok &= Run( c_kernel,          "c_kernel"         );
+# endif
 # ifdef CPPAD_EIGEN_EXAMPLES
 	ok &= Run( eigen_array,       "eigen_array"      );
 	ok &= Run( eigen_det,         "eigen_det"        );
@@ -0,0 +1,98 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin forward0_batch.cpp$$
+$spell
+	Cpp
+$$
+
+$section Zero Order Forward at a Batch of Points: Example and Test$$
+$index forward0_batch, example$$
+$index example, forward0_batch$$
+$index batch, forward example$$
+
+$code
+$verbatim%example/forward0_batch.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+bool forward0_batch(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	using CppAD::vector;
+	size_t j, i, p;
+
+	// domain space vector
+	size_t n = 2;
+	vector< AD<double> > ax(n);
+	ax[0] = 1.;
+	ax[1] = 2.;
+
+	// declare independent variables and starting recording
+	CppAD::Independent(ax);
+
+	// range space vector
+	size_t m = 2;
+	vector< AD<double> > ay(m);
+	ay[0] = exp( ax[0] ) * sin( ax[1] ) + 3. / ax[1];
+	ay[1] = CppAD::CondExpLt(ax[0], ax[1], ax[0] * ax[1], ax[0] - ax[1]);
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+
+	// n_point argument values, the j-th component of the p-th point
+	// is x[ j * n_point + p ]
+	size_t n_point = 5;
+	vector<double> x(n * n_point), y;
+	for(p = 0; p < n_point; p++)
+	{	x[ 0 * n_point + p ] = double(p) / 2.;
+		x[ 1 * n_point + p ] = double(n_point - p);
+	}
+	y = f.forward0_batch(n_point, x);
+	ok &= y.size() == m * n_point;
+
+	// check the results against one point at a time
+	vector<double> xp(n), yp(m);
+	for(p = 0; p < n_point; p++)
+	{	for(j = 0; j < n; j++)
+			xp[j] = x[ j * n_point + p ];
+		yp = f.Forward(0, xp);
+		for(i = 0; i < m; i++)
+			ok &= y[ i * n_point + p ] == yp[i];
+	}
+
+	// the Taylor coefficients stored in f are not changed by forward0_batch
+	// (they correspond to the last call to Forward above)
+	y = f.forward0_batch(n_point, x);
+	ok &= f.size_order() == 1;
+	vector<double> xq(n), yq(m);
+	xq[0] = 1.;
+	xq[1] = 0.;
+	yq = f.Forward(1, xq);
+	p  = n_point - 1;
+	double x0 = x[ 0 * n_point + p ];
+	double x1 = x[ 1 * n_point + p ];
+	double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+	ok &= NearEqual(yq[0], exp(x0) * sin(x1), eps, eps);
+	if( x0 < x1 )
+		ok &= NearEqual(yq[1], x1, eps, eps);
+	else	ok &= NearEqual(yq[1], 1., eps, eps);
+
+	return ok;
+}
+
+// END C++
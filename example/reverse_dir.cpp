@@ -0,0 +1,101 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the 
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin reverse_dir.cpp$$
+$spell
+	Cpp
+$$
+
+$section Reverse Mode: Example and Test of Multiple Weight Vectors$$
+$index reverse, multiple weight vectors$$
+$index example, multiple weight vectors$$
+$index test, multiple weight vectors$$
+
+$code
+$verbatim%example/reverse_dir.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <limits>
+# include <cppad/cppad.hpp>
+bool reverse_dir(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	double eps = 10. * std::numeric_limits<double>::epsilon();
+	size_t i, j, ell;
+
+	// domain space vector
+	size_t n = 3;
+	CPPAD_TESTVECTOR(AD<double>) ax(n);
+	ax[0] = 0.;
+	ax[1] = 1.;
+	ax[2] = 2.;
+
+	// declare independent variables and starting recording
+	CppAD::Independent(ax);
+
+	// range space vector
+	size_t m = 2;
+	CPPAD_TESTVECTOR(AD<double>) ay(m);
+	ay[0] = ax[0] * ax[1] * ax[2];
+	ay[1] = sin( ax[0] ) + ax[2];
+
+	// create f: x -> y and stop tape recording
+	CppAD::ADFun<double> f(ax, ay);
+
+	// compute zero order coefficients at x = (3, 4, 5)
+	CPPAD_TESTVECTOR(double) x(n);
+	x[0] = 3.;
+	x[1] = 4.;
+	x[2] = 5.;
+	f.Forward(0, x);
+
+	// each weight vector picks out one component of f, so that
+	// dw contains the transpose of the Jacobian of f
+	size_t r = m;
+	CPPAD_TESTVECTOR(double) w(m * r), dw(n * r);
+	for(i = 0; i < m; i++)
+	{	for(ell = 0; ell < r; ell++)
+			w[ r * i + ell ] = 0.;
+		w[ r * i + i ] = 1.;
+	}
+	dw = f.Reverse(1, r, w);
+
+	// check the derivatives of y[0] = x[0] * x[1] * x[2]
+	ell = 0;
+	ok &= NearEqual(dw[ r * 0 + ell ], x[1] * x[2], eps, eps);
+	ok &= NearEqual(dw[ r * 1 + ell ], x[0] * x[2], eps, eps);
+	ok &= NearEqual(dw[ r * 2 + ell ], x[0] * x[1], eps, eps);
+
+	// check the derivatives of y[1] = sin(x[0]) + x[2]
+	ell = 1;
+	ok &= NearEqual(dw[ r * 0 + ell ], std::cos(x[0]), eps, eps);
+	ok &= NearEqual(dw[ r * 1 + ell ], 0.,             eps, eps);
+	ok &= NearEqual(dw[ r * 2 + ell ], 1.,             eps, eps);
+
+	// same values as Reverse(1, w1) when there is one weight vector
+	CPPAD_TESTVECTOR(double) w1(m), dw1(n), dwr(n);
+	w1[0] = 2.;
+	w1[1] = 3.;
+	dw1   = f.Reverse(1, w1);
+	r     = 1;
+	dwr   = f.Reverse(1, r, w1);
+	for(j = 0; j < n; j++)
+		ok &= NearEqual(dwr[j], dw1[j], eps, eps);
+
+	return ok;
+}
+// END C++
@@ -1,6 +1,6 @@
 /* $Id$ */
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-12 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -212,6 +212,137 @@ bool check_alignment(void)
 	return ok;
 }
 
+bool check_capacity(void)
+{	bool ok = true;
+	using CppAD::thread_alloc;
+
+	// capacity only changes when the previous capacity is not large enough
+	size_t min_bytes, cap_bytes, previous = 0;
+	for(min_bytes = 1; min_bytes < 100000; min_bytes++)
+	{	void* v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+		ok &= min_bytes <= cap_bytes;
+		if( cap_bytes != previous )
+			ok &= min_bytes == previous + 1;
+		previous = cap_bytes;
+		thread_alloc::return_memory(v_ptr);
+	}
+	return ok;
+}
+
+bool check_huge_page(void)
+{	bool ok = true;
+	using CppAD::thread_alloc;
+	size_t thread = thread_alloc::thread_num();
+
+	// use huge pages for large allocations (if supported)
+	bool huge = thread_alloc::huge_page(true);
+
+	// allocate three mega bytes of memory and use all of it
+	size_t min_bytes = 3 * 1024 * 1024;
+	size_t cap_bytes;
+	void* v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+	ok &= min_bytes <= cap_bytes;
+	char* c_ptr = reinterpret_cast<char*>(v_ptr);
+	for(size_t i = 0; i < cap_bytes; i++)
+		c_ptr[i] = char(i % 128);
+	ok &= c_ptr[cap_bytes - 1] == char( (cap_bytes - 1) % 128 );
+
+	// check that it is aligned
+	size_t n_byte   = std::numeric_limits<size_t>::digits / 8;
+	size_t v_size_t = reinterpret_cast<size_t>(v_ptr);
+	ok &= (v_size_t % n_byte) == 0;
+
+	// return the memory to the available pool and then to the system
+	thread_alloc::return_memory(v_ptr);
+	ok &= thread_alloc::available(thread) >= cap_bytes;
+	thread_alloc::free_available(thread);
+	ok &= thread_alloc::available(thread) == 0;
+
+	// return allocator to its default mode
+	ok &= thread_alloc::huge_page(false) == false;
+
+	// huge is only false if huge pages are not supported by this system
+	if( ! huge )
+		ok &= thread_alloc::huge_page(true) == false;
+	thread_alloc::huge_page(false);
+
+	return ok;
+}
+
+bool check_numa_local(void)
+{	bool ok = true;
+	using CppAD::thread_alloc;
+	size_t thread = thread_alloc::thread_num();
+
+	// place large allocations on the NUMA node for this thread
+	bool numa = thread_alloc::numa_local(true);
+
+	// allocate one mega byte of memory and use all of it
+	size_t min_bytes = 1024 * 1024;
+	size_t cap_bytes;
+	void* v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+	ok &= min_bytes <= cap_bytes;
+	char* c_ptr = reinterpret_cast<char*>(v_ptr);
+	for(size_t i = 0; i < cap_bytes; i++)
+		c_ptr[i] = char(i % 128);
+	ok &= c_ptr[cap_bytes - 1] == char( (cap_bytes - 1) % 128 );
+
+	// check that it is aligned
+	size_t n_byte   = std::numeric_limits<size_t>::digits / 8;
+	size_t v_size_t = reinterpret_cast<size_t>(v_ptr);
+	ok &= (v_size_t % n_byte) == 0;
+
+	// return the memory to the available pool and then to the system
+	thread_alloc::return_memory(v_ptr);
+	ok &= thread_alloc::available(thread) >= cap_bytes;
+	thread_alloc::free_available(thread);
+	ok &= thread_alloc::available(thread) == 0;
+
+	// return allocator to its default mode
+	ok &= thread_alloc::numa_local(false) == false;
+
+	// numa is only false if placement is not supported by this system
+	// (or this process can only allocate memory on one NUMA node)
+	if( ! numa )
+		ok &= thread_alloc::numa_local(true) == false;
+	thread_alloc::numa_local(false);
+
+	return ok;
+}
+
+bool check_statistics(void)
+{	bool ok = true;
+	using CppAD::thread_alloc;
+	size_t thread = thread_alloc::thread_num();
+
+	// start collecting statistics
+	thread_alloc::statistics(true);
+	ok &= thread_alloc::peak_inuse(thread) == 0;
+	size_t start = thread_alloc::tag_inuse(thread_alloc::atomic_tag, thread);
+
+	// attribute some memory to the atomic tag
+	size_t min_bytes = 1000;
+	size_t cap_bytes;
+	void* v_ptr = thread_alloc::get_memory(
+		min_bytes, cap_bytes, thread_alloc::atomic_tag
+	);
+	size_t bytes = thread_alloc::tag_inuse(thread_alloc::atomic_tag, thread);
+	ok &= bytes == start + cap_bytes;
+	ok &= thread_alloc::peak_inuse(thread) == thread_alloc::inuse(thread);
+	thread_alloc::return_memory(v_ptr);
+	bytes = thread_alloc::tag_inuse(thread_alloc::atomic_tag, thread);
+	ok &= bytes == start;
+
+	// write a report for each thread
+	std::stringstream os;
+	thread_alloc::statistics_report(os);
+	ok &= os.str().find("atomic") != std::string::npos;
+
+	// stop collecting statistics
+	thread_alloc::statistics(false);
+	return ok;
+}
+
 
 bool thread_alloc(void)
 {	bool ok  = true;
@@ -237,6 +368,18 @@ bool thread_alloc(void)
 	// check alignment
 	ok &= check_alignment();
 
+	// check capacity for each request
+	ok &= check_capacity();
+
+	// check huge page allocations
+	ok &= check_huge_page();
+
+	// check NUMA local allocations
+	ok &= check_numa_local();
+
+	// check allocation statistics
+	ok &= check_statistics();
+
 	// return allocator to its default mode
 	thread_alloc::hold_memory(false);
 	return ok;
@@ -0,0 +1,198 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin sweep_time.cpp$$
+$spell
+	num
+	bool
+	kilo
+	CppAD
+	ADFun
+$$
+$index sweep_time$$
+$index gradient, multi_thread speed$$
+$index multi_thread, gradient speed$$
+$index speed, multi_thread gradient$$
+$index time, multi_thread gradient$$
+
+
+$section Timing Test of Gradient Using a Team of Threads for ADFun Sweeps$$
+
+$head Syntax$$
+$icode%ok% = sweep_time(%time_out%, %test_time%, %num_threads%, %kilo_term%)%$$
+
+$head Purpose$$
+Runs a correctness and timing test for the gradient of a sum of
+independent terms
+$latex \[
+	f(x) = \sum_{i=0}^{N-1} \exp( c_i x_{i \% n} ) x_{(i+1) \% n}
+		+ \sqrt{ x_{i \% n} }
+\] $$
+using $cref/f.Forward(0, x)/forward_zero/$$ followed by
+$cref/f.Reverse(1, w)/reverse_one/$$.
+The function object $icode f$$ uses the team of threads for its
+sweeps; see $cref parallel_team$$.
+This routine must be called in sequential execution mode,
+even though $cref/in_parallel/ta_in_parallel/$$ may return true.
+
+$head ok$$
+This return value has prototype
+$codei%
+	bool %ok%
+%$$
+If it is true,
+$code sweep_time$$ passed the correctness test.
+Otherwise it is false.
+
+$head time_out$$
+This argument has prototype
+$codei%
+	double& %time_out%
+%$$
+The input value of the argument does not matter.
+Upon return it is the number of wall clock seconds required
+to compute the gradient.
+
+$head test_time$$
+Is the minimum amount of wall clock time that the test should take.
+The number of repeats for the test will be increased until this time
+is reached.
+The reported $icode time_out$$ is the total wall clock time divided by the
+number of repeats.
+
+$head num_threads$$
+This argument has prototype
+$codei%
+	size_t %num_threads%
+%$$
+It specifies the number of threads that are available for this test.
+If it is zero, the test is run without the multi-threading environment,
+the parallel mode is off, and
+$codei%
+	1 == CppAD::thread_alloc::num_threads()
+%$$
+when $code sweep_time$$ is called.
+If it is non-zero, the test is run with the multi-threading and
+$codei%
+	%num_threads% = CppAD::thread_alloc::num_threads()
+%$$
+when $code sweep_time$$ is called.
+
+$head kilo_term$$
+This argument has prototype
+$codei%
+	size_t& %kilo_term%
+%$$
+and is greater than zero.
+The number of terms $latex N$$ in the
+$cref/summation/sweep_time.cpp/Purpose/$$
+is equal to $latex 10^3$$ times $icode kilo_term$$.
+
+$head Source$$
+$code
+$verbatim%multi_thread/sweep_time.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include "team_thread.hpp"
+# include "sweep_time.hpp"
+
+namespace { // empty namespace
+	using CppAD::AD;
+	using CppAD::ADFun;
+	using CppAD::vector;
+
+	// number of independent variables
+	const size_t n_ = 10;
+
+	// function object used by test_once
+	ADFun<double>* f_ = CPPAD_NULL;
+
+	// gradient resulting from most recent call to test_once
+	vector<double> dw_;
+
+	// record the function
+	void record(size_t num_term, ADFun<double>& f)
+	{	vector< AD<double> > ax(n_), ay(1);
+		size_t j;
+		for(j = 0; j < n_; j++)
+			ax[j] = 1.;
+		CppAD::Independent(ax);
+		ay[0] = 0.;
+		for(size_t i = 0; i < num_term; i++)
+		{	AD<double> c = double(i) / double(num_term);
+			ay[0] += exp( c * ax[i % n_] ) * ax[(i + 1) % n_]
+			      +  sqrt( ax[i % n_] );
+		}
+		f.Dependent(ax, ay);
+	}
+
+	void test_once(void)
+	{	vector<double> x(n_), w(1);
+		for(size_t j = 0; j < n_; j++)
+			x[j] = double(j + 1) / double(n_);
+		w[0] = 1.;
+		f_->Forward(0, x);
+		dw_ = f_->Reverse(1, w);
+		return;
+	}
+
+	void test_repeat(size_t repeat)
+	{	size_t i;
+		for(i = 0; i < repeat; i++)
+			test_once();
+		return;
+	}
+} // end empty namespace
+
+bool sweep_time(
+	double& time_out, double test_time, size_t num_threads, size_t kilo_term)
+{	bool ok  = true;
+
+	// expect number of threads to already be set up
+	ok &= std::max(num_threads, size_t(1)) ==
+		CppAD::thread_alloc::num_threads();
+
+	// record the function and set its parallel mode
+	size_t num_term = kilo_term * 1000;
+	ADFun<double> f;
+	record(num_term, f);
+	if( num_threads > 0 )
+		f.parallel_team(team_work);
+	f_ = &f;
+
+	// run the test case and set the time return value
+	time_out = CppAD::time_test(test_repeat, test_time);
+
+	// Correctness check using the sequential sweeps
+	ADFun<double> g;
+	record(num_term, g);
+	vector<double> x(n_), w(1), dw(n_);
+	for(size_t j = 0; j < n_; j++)
+		x[j] = double(j + 1) / double(n_);
+	w[0] = 1.;
+	g.Forward(0, x);
+	dw = g.Reverse(1, w);
+	double eps = 1e3 * CppAD::numeric_limits<double>::epsilon();
+	for(size_t j = 0; j < n_; j++)
+		ok &= CppAD::NearEqual(dw[j], dw_[j], eps, eps);
+
+	f_ = CPPAD_NULL;
+	dw_.clear();
+	return ok;
+}
+
+// END C++
@@ -0,0 +1,162 @@
+// $Id$
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin team_free.cpp$$
+$spell
+	CppAD
+$$
+
+$section Returning Memory From a Different Thread: Example and Test$$
+
+$index thread, return memory$$
+$index return, memory different thread$$
+$index example, return memory different thread$$
+
+$head Purpose$$
+This example demonstrates recording $code ADFun$$ objects on one thread
+and using and destroying them on another thread
+(as in a producer consumer pipeline).
+The memory returned by the other thread is put in a queue
+for the thread that allocated it; see
+$cref/return_memory/ta_return_memory/Thread/$$.
+It checks that the memory in use by each thread is the same
+before the objects were created and after they are destroyed.
+
+$head thread_team$$
+The following three implementations of the
+$cref team_thread.hpp$$ specifications are included:
+$table
+$rref team_openmp.cpp$$
+$rref team_bthread.cpp$$
+$rref team_pthread.cpp$$
+$tend
+
+$head Source Code$$
+$code
+$verbatim%multi_thread/team_free.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+------------------------------------------------------------------------------
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include "team_thread.hpp"
+# define NUMBER_THREADS  4
+
+namespace {
+	using CppAD::thread_alloc;
+	using CppAD::AD;
+	using CppAD::ADFun;
+
+	// structure with information for one thread
+	typedef struct {
+		// memory in use by this thread before the producer is called
+		size_t          inuse;
+		// function recorded by this thread (producer output)
+		ADFun<double>*  f;
+		// memory allocated by this thread (producer output)
+		void*           v_ptr;
+		// false if an error occurs, true otherwise (worker output)
+		bool            ok;
+	} work_one_t;
+	// vector with information for all threads
+	// (use pointers instead of values to avoid false sharing)
+	work_one_t* work_all_[NUMBER_THREADS];
+	// --------------------------------------------------------------------
+	// record a function and allocate some memory using this thread
+	void producer(void)
+	{	size_t thread  = thread_alloc::thread_num();
+		work_one_t* work = work_all_[thread];
+		work->inuse    = thread_alloc::inuse(thread);
+
+		size_t j, n = 10;
+		CppAD::vector< AD<double> > ax(n), ay(1);
+		for(j = 0; j < n; j++)
+			ax[j] = double(j + 1);
+		Independent(ax);
+		ay[0] = 0.;
+		for(j = 0; j < n; j++)
+			ay[0] += double(thread + 1) * sin( ax[j] );
+		work->f = new ADFun<double>(ax, ay);
+
+		size_t min_bytes = 100 * sizeof(double), cap_bytes;
+		work->v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+		work->ok    = true;
+	}
+	// use and destroy the objects created by the next thread
+	void consumer(void)
+	{	size_t thread  = thread_alloc::thread_num();
+		size_t other   = (thread + 1) % NUMBER_THREADS;
+		work_one_t* work = work_all_[other];
+
+		// the Taylor coefficients in f are allocated by this thread
+		// and the ones from the recording by the other thread
+		size_t j, n = 10;
+		CppAD::vector<double> x(n), y(1), w(1), dw(n);
+		for(j = 0; j < n; j++)
+			x[j] = double(j) / double(n);
+		y     = work->f->Forward(0, x);
+		w[0]  = 1.;
+		dw    = work->f->Reverse(1, w);
+		bool ok = true;
+		double eps = 10. * CppAD::numeric_limits<double>::epsilon();
+		for(j = 0; j < n; j++)
+			ok &= CppAD::NearEqual(
+				dw[j], double(other + 1) * std::cos(x[j]), eps, eps
+			);
+
+		// return the memory for the other thread
+		delete work->f;
+		thread_alloc::return_memory(work->v_ptr);
+		work_all_[thread]->ok &= ok;
+	}
+	// check that the memory for this thread was returned
+	void check(void)
+	{	size_t thread  = thread_alloc::thread_num();
+		work_one_t* work = work_all_[thread];
+		work->ok &= thread_alloc::inuse(thread) == work->inuse;
+		// the memory is being held for future use by this thread
+		work->ok &= thread_alloc::available(thread) > 0;
+	}
+}
+
+// This test routine is only called by the master thread (thread_num = 0).
+bool team_free(void)
+{	bool ok = true;
+	size_t thread;
+
+	// allocate separate memory for each thread to avoid false sharing
+	for(thread = 0; thread < NUMBER_THREADS; thread++)
+	{	size_t min_bytes(sizeof(work_one_t)), cap_bytes;
+		void*  v_ptr = thread_alloc::get_memory(min_bytes, cap_bytes);
+		work_all_[thread]     = static_cast<work_one_t*>(v_ptr);
+		work_all_[thread]->ok = false;
+	}
+
+	ok &= team_create(NUMBER_THREADS);
+	ok &= team_work(producer);
+	ok &= team_work(consumer);
+	ok &= team_work(check);
+	ok &= team_destroy();
+
+	thread = NUMBER_THREADS;
+	while(thread--)
+	{	ok &= work_all_[thread]->ok;
+		void* v_ptr = static_cast<void*>( work_all_[thread] );
+		thread_alloc::return_memory( v_ptr );
+		thread_alloc::free_available(thread);
+	}
+	return ok;
+}
+// END C++
@@ -0,0 +1,299 @@
+// $Id$
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin team_sweep.cpp$$
+$spell
+	CppAD
+$$
+
+$section Using a Team of Threads for ADFun Sweeps: Example and Test$$
+
+$index thread, team ADFun sweep$$
+$index ADFun, team sweep example$$
+$index example, team ADFun sweep$$
+
+$head Purpose$$
+This example demonstrates using $cref parallel_team$$ so that
+a single $code ADFun$$ object splits its sweeps among a team of threads.
+The function is a sum of independent terms
+and the results are checked against the same function
+with the parallel mode off.
+The zero order forward results are identical and the
+first order reverse results are equal to within rounding.
+A second function, with a dense Jacobian sparsity pattern,
+checks that the forward mode Jacobian sparsity patterns are identical,
+and that the sparse Jacobians and Hessians are identical.
+When the operation sequence has been optimized,
+the same operations are skipped with the parallel mode on and off.
+
+$head thread_team$$
+The following three implementations of the
+$cref team_thread.hpp$$ specifications are included:
+$table
+$rref team_openmp.cpp$$
+$rref team_bthread.cpp$$
+$rref team_pthread.cpp$$
+$tend
+
+$head Source Code$$
+$code
+$verbatim%multi_thread/team_sweep.cpp%0%// BEGIN C++%// END C++%1%$$
+$$
+
+$end
+------------------------------------------------------------------------------
+*/
+// BEGIN C++
+# include <cppad/cppad.hpp>
+# include "team_thread.hpp"
+# define NUMBER_THREADS  4
+
+namespace {
+	using CppAD::AD;
+	using CppAD::ADFun;
+	using CppAD::vector;
+
+	// number of times the team has been used by the sweeps
+	size_t team_count_ = 0;
+	bool team_work_count(void worker(void))
+	{	team_count_++;
+		return team_work(worker);
+	}
+
+	// record a sum of independent terms
+	void record(size_t n, size_t num_term, ADFun<double>& f)
+	{	vector< AD<double> > ax(n), ay(2);
+		size_t j;
+		for(j = 0; j < n; j++)
+			ax[j] = double(j + 1) / double(n);
+		CppAD::Independent(ax);
+		AD<double> sum = 0.;
+		AD<double> zero = 0.;
+		for(size_t i = 0; i < num_term; i++)
+		{	AD<double> u = ax[i % n];
+			AD<double> v = ax[(i + 1) % n];
+			AD<double> c = double(i + 1) / double(num_term);
+			AD<double> term = exp(c * u) * sin(v) + sqrt(u * v) / (1. + c);
+			term += CppAD::CondExpLt(u, v, c * u * u, v / (u + c));
+			term -= pow(v, c) - log(1. + u);
+			sum  += term;
+		}
+		ay[0] = sum;
+		// a comparison operator
+		if( ax[0] < 1. )
+			ay[1] = ax[0] * ay[0];
+		else	ay[1] = ax[0] + ay[0];
+		f.Dependent(ax, ay);
+	}
+	// record a function with a lower triangular Jacobian
+	void record_triangle(size_t n, ADFun<double>& f)
+	{	vector< AD<double> > ax(n), ay(n);
+		size_t j;
+		for(j = 0; j < n; j++)
+			ax[j] = double(j + 1) / double(n);
+		CppAD::Independent(ax);
+		CppAD::VecAD<double> av(n);
+		ay[0] = ax[0];
+		for(j = 1; j < n; j++)
+		{	av[ ax[j] ] = ay[j-1];
+			if( j % 3 )
+				ay[j] = sin( ay[j-1] ) * ax[j];
+			else	ay[j] = av[ ax[j] ] + ax[j];
+		}
+		f.Dependent(ax, ay);
+	}
+	// check that parallel mode gives identical results
+	bool check(ADFun<double>& f, ADFun<double>& g, const vector<double>& x)
+	{	bool ok = true;
+		vector<double> y_f = f.Forward(0, x);
+		vector<double> y_g = g.Forward(0, x);
+		for(size_t i = 0; i < y_f.size(); i++)
+			ok &= y_f[i] == y_g[i];
+		ok &= f.compare_change_number() == g.compare_change_number();
+		ok &= f.compare_change_op_index() == g.compare_change_op_index();
+		return ok;
+	}
+}
+
+// This test routine is only called by the master thread (thread_num = 0).
+bool team_sweep(void)
+{	bool ok = true;
+	size_t n        = 5;
+	size_t num_term = 2000;
+	size_t j;
+
+	ok &= team_create(NUMBER_THREADS);
+	{	ADFun<double> f, g;
+		record(n, num_term, f);
+		record(n, num_term, g);
+		g.parallel_team(team_work_count, 10);
+
+		vector<double> x(n);
+		for(j = 0; j < n; j++)
+			x[j] = double(j + 2) / double(n);
+		ok &= check(f, g, x);
+		ok &= team_count_ > 0;
+
+		// case where the comparison operator changes
+		x[0] = 2.;
+		ok &= check(f, g, x);
+		ok &= g.compare_change_number() == 1;
+
+		// first order forward uses the zero order results
+		vector<double> dx(n), dy_f, dy_g;
+		for(j = 0; j < n; j++)
+			dx[j] = double(j + 1);
+		dy_f = f.Forward(1, dx);
+		dy_g = g.Forward(1, dx);
+		for(size_t i = 0; i < dy_f.size(); i++)
+			ok &= dy_f[i] == dy_g[i];
+
+		// first order reverse (zero order results are for x above)
+		vector<double> w(2), dw_f, dw_g, dw_h;
+		w[0] = 1.;
+		w[1] = 2.;
+		dw_f = f.Reverse(1, w);
+		dw_g = g.Reverse(1, w);
+		dw_h = g.Reverse(1, w);
+		double eps = 100. * CppAD::numeric_limits<double>::epsilon();
+		for(j = 0; j < n; j++)
+		{	ok &= CppAD::NearEqual(dw_f[j], dw_g[j], eps, eps);
+			// same result every time (for the same number of threads)
+			ok &= dw_g[j] == dw_h[j];
+		}
+
+		// zero order forward at a batch of points (split among the threads)
+		size_t p, n_point = 7, count = team_count_;
+		vector<double> xb(n * n_point), yb_f, yb_g;
+		for(j = 0; j < n; j++)
+		{	for(p = 0; p < n_point; p++)
+				xb[j * n_point + p] = double(j + p + 1) / double(n + n_point);
+		}
+		yb_f = f.forward0_batch(n_point, xb);
+		yb_g = g.forward0_batch(n_point, xb);
+		ok &= team_count_ == count + 1;
+		for(size_t i = 0; i < yb_f.size(); i++)
+			ok &= yb_f[i] == yb_g[i];
+
+		// optimized operation sequence (fewer terms so that the check
+		// in optimize is not sensitive to the order of the summation)
+		record(n, 50, f);
+		record(n, 50, g);
+		f.optimize();
+		g.optimize();
+		x[0] = 0.5;
+		ok &= check(f, g, x);
+		// the conditional skip operators are used in the same way
+		ok &= f.number_skip() > 0;
+		ok &= f.number_skip() == g.number_skip();
+		dw_f = f.Reverse(1, w);
+		dw_g = g.Reverse(1, w);
+		for(j = 0; j < n; j++)
+			ok &= CppAD::NearEqual(dw_f[j], dw_g[j], eps, eps);
+
+		// forward Jacobian sparsity (the columns are split among the threads)
+		size_t i, k, n_sparse = 300;
+		record_triangle(n_sparse, f);
+		record_triangle(n_sparse, g);
+		vector<bool> r(n_sparse * n_sparse), s_f, s_g;
+		for(i = 0; i < n_sparse; i++)
+		{	for(j = 0; j < n_sparse; j++)
+				r[i * n_sparse + j] = (i == j);
+		}
+		count = team_count_;
+		s_f   = f.ForSparseJac(n_sparse, r);
+		s_g   = g.ForSparseJac(n_sparse, r);
+		ok   &= team_count_ == count + 1;
+		for(i = 0; i < n_sparse * n_sparse; i++)
+			ok &= s_f[i] == s_g[i];
+		ok &= s_g[ (n_sparse - 1) * n_sparse ];
+		ok &= ! s_g[ n_sparse - 1 ];
+
+		// the Hessian sparsity uses the pattern stored by ForSparseJac
+		vector<bool> w_sparse(n_sparse), h_f, h_g;
+		for(i = 0; i < n_sparse; i++)
+			w_sparse[i] = (i == n_sparse - 1);
+		h_f = f.RevSparseHes(n_sparse, w_sparse);
+		h_g = g.RevSparseHes(n_sparse, w_sparse);
+		for(i = 0; i < n_sparse * n_sparse; i++)
+			ok &= h_f[i] == h_g[i];
+
+		// sparse Jacobian (the colors are split among the threads)
+		vector<double> xs(n_sparse), ws(n_sparse);
+		for(j = 0; j < n_sparse; j++)
+		{	xs[j] = double(j + 1) / double(n_sparse);
+			ws[j] = double(n_sparse - j) / double(n_sparse);
+		}
+		vector<size_t> row, col;
+		for(i = 0; i < n_sparse; i++)
+		{	for(j = 0; j < n_sparse; j++) if( s_f[i * n_sparse + j] )
+			{	row.push_back(i);
+				col.push_back(j);
+			}
+		}
+		size_t K = row.size();
+		vector<double> jac_f(K), jac_g(K);
+		CppAD::sparse_jacobian_work work_f, work_g;
+		for(size_t rep = 0; rep < 2; rep++)
+		{	// second time uses the copies of g created by the threads
+			// and at most three colors per sweep
+			work_g.max_direction = 3 * rep;
+			count = team_count_;
+			f.SparseJacobianForward(xs, s_f, row, col, jac_f, work_f);
+			g.SparseJacobianForward(xs, s_g, row, col, jac_g, work_g);
+			ok &= team_count_ > count;
+			for(k = 0; k < K; k++)
+				ok &= jac_f[k] == jac_g[k];
+			xs[0] = 2. * xs[0];
+		}
+		work_f.clear();
+		work_g.clear();
+		f.SparseJacobianReverse(xs, s_f, row, col, jac_f, work_f);
+		g.SparseJacobianReverse(xs, s_g, row, col, jac_g, work_g);
+		for(k = 0; k < K; k++)
+			ok &= jac_f[k] == jac_g[k];
+
+		// sparse Hessian (the colors are split among the threads)
+		for(i = 0; i < n_sparse; i++)
+			w_sparse[i] = true;
+		h_f = f.RevSparseHes(n_sparse, w_sparse);
+		row.clear();
+		col.clear();
+		for(i = 0; i < n_sparse; i++)
+		{	for(j = 0; j <= i; j++) if( h_f[i * n_sparse + j] )
+			{	row.push_back(i);
+				col.push_back(j);
+			}
+		}
+		K = row.size();
+		vector<double> hes_f(K), hes_g(K);
+		CppAD::sparse_hessian_work work_hf, work_hg;
+		f.SparseHessian(xs, ws, h_f, row, col, hes_f, work_hf);
+		g.SparseHessian(xs, ws, h_f, row, col, hes_g, work_hg);
+		for(k = 0; k < K; k++)
+			ok &= hes_f[k] == hes_g[k];
+
+		// acyclic coloring (the substitution follows the team sweeps)
+		work_hf.clear();
+		work_hg.clear();
+		work_hf.color_method = "cppad.acyclic";
+		work_hg.color_method = "cppad.acyclic";
+		f.SparseHessian(xs, ws, h_f, row, col, hes_f, work_hf);
+		g.SparseHessian(xs, ws, h_f, row, col, hes_g, work_hg);
+		for(k = 0; k < K; k++)
+			ok &= hes_f[k] == hes_g[k];
+	}
+	ok &= team_destroy();
+	return ok;
+}
+// END C++
@@ -55,6 +55,10 @@ next_program
 ./$program harmonic 1 4 1
 next_program
 echo
+# test_time=1 max_thread=4, kilo_term=100
+./$program sweep_time 1 4 100
+next_program
+echo
 # test_time= 2 max_thread=4, num_zero=20, num_sub=30, num_sum=500, use_ad=true
 ./$program multi_newton 2 4 20 30 500 true
 next_program
@@ -78,5 +82,9 @@ do
 		echo
 		./$program team_example
 		echo
+		./$program team_sweep
+		echo
+		./$program team_free
+		echo
 	fi
 done
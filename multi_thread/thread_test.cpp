@@ -1,6 +1,6 @@
 /* $Id$ */
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -22,6 +22,10 @@ $spell
 	pthreads
 	openmp
 	bthread
+	kilo
+	ADFun
+	numa
+	NUMA
 $$
 $index thread_test, example$$
 $index thread_test, speed$$
@@ -36,7 +40,10 @@ $head Syntax$$
 $codei%./multi_thread_%threading% a11c
 ./multi_thread_%threading% simple_ad
 ./multi_thread_%threading% team_example
+./multi_thread_%threading% team_sweep
+./multi_thread_%threading% team_free
 ./multi_thread_%threading% harmonic %test_time% %max_threads% %mega_sum%
+./multi_thread_%threading% sweep_time %test_time% %max_threads% %kilo_term%
 ./multi_thread_%threading% multi_newton %test_time% %max_threads% \
 	%num_zero% %num_sub% %num_sum% %use_ad%
 %$$ 
@@ -88,7 +95,10 @@ $children%
 	multi_thread/pthread/simple_ad_pthread.cpp%
 
 	multi_thread/team_example.cpp%
+	multi_thread/team_sweep.cpp%
+	multi_thread/team_free.cpp%
 	multi_thread/harmonic.cpp%
+	multi_thread/sweep_time.cpp%
 	multi_thread/multi_newton.cpp%
 
 	multi_thread/team_thread.hpp
@@ -117,6 +127,16 @@ The $cref team_example.cpp$$ routine
 demonstrates simple multi-threading with algorithmic differentiation
 and using a $cref/team of threads/team_thread.hpp/$$. 
 
+$head team_sweep$$
+The $cref team_sweep.cpp$$ routine
+demonstrates using a team of threads to split the sweeps
+for one $code ADFun$$ object; see $cref parallel_team$$.
+
+$head team_free$$
+The $cref team_free.cpp$$ routine
+demonstrates recording $code ADFun$$ objects on one thread
+and destroying them on a different thread.
+
 $head harmonic$$
 The $cref harmonic_time.cpp$$ routine
 preforms a timing test for a multi-threading 
@@ -143,6 +163,33 @@ The command line argument $icode mega_sum$$
 is an integer greater than or equal one and has the same meaning as in
 $cref/harmonic_time.cpp/harmonic_time.cpp/mega_sum/$$.
 
+$head sweep_time$$
+The $cref sweep_time.cpp$$ routine
+preforms a timing test for the gradient of a sum of independent terms
+where one $code ADFun$$ object uses a team of threads for its sweeps;
+see $cref parallel_team$$.
+
+$subhead test_time$$
+Is the minimum amount of wall clock time that the test should take.
+The number of repeats for the test will be increased until this time
+is reached.
+The reported time is the total wall clock time divided by the
+number of repeats.
+
+$subhead max_threads$$
+If the argument $icode max_threads$$ is a non-negative integer specifying
+the maximum number of threads to use for the test.
+The specified test is run with the following number of threads:
+$codei%
+	%num_threads% = 0 , %...% , %max_threads%
+%$$
+The value of zero corresponds to not using the multi-threading system.
+
+$subhead kilo_term$$
+The command line argument $icode kilo_term$$
+is an integer greater than or equal one and has the same meaning as in
+$cref/sweep_time.cpp/sweep_time.cpp/kilo_term/$$.
+
 $head multi_newton$$
 The $cref multi_newton_time.cpp$$ routine
 preforms a timing test for a multi-threading 
@@ -184,6 +231,27 @@ The command line argument $icode use_ad$$ is either
 $code true$$ or $code false$$ and has the same meaning as in
 $cref/multi_newton_time.cpp/multi_newton_time.cpp/use_ad/$$.
 
+$head numa_local$$
+If $cref/numa_local/ta_numa_local/$$ is supported by the system,
+and this process can allocate memory on more than one NUMA node,
+the output contains the line
+$codei%
+	numa_local    = true;
+%$$
+and the timing tests $code harmonic$$, $code sweep_time$$, and
+$code multi_newton$$ report two times for each number of threads.
+The first time is with $code numa_local$$ false
+and the second is with $code numa_local$$ true; i.e.,
+with large allocations placed on the NUMA node for the thread that
+allocates them.
+Comparing these columns shows the effect of remote memory access
+on the scaling of the tests.
+Otherwise the output contains the line
+$codei%
+	numa_local    = false;
+%$$
+and only the first time is reported.
+
 $head Team Implementations$$
 The following routines are used to implement the specific threading
 systems through the common interface $cref team_thread.hpp$$:
@@ -208,7 +276,10 @@ $end
 # include <ctime>
 # include "team_thread.hpp"
 # include "team_example.hpp"
+# include "team_sweep.hpp"
+# include "team_free.hpp"
 # include "harmonic_time.hpp"
+# include "sweep_time.hpp"
 # include "multi_newton_time.hpp"
 
 extern bool a11c(void);
@@ -250,7 +321,10 @@ int main(int argc, char *argv[])
 	"./<thread>_test a11c\n"
 	"./<thread>_test simple_ad\n"
 	"./<thread>_test team_example\n"
+	"./<thread>_test team_sweep\n"
+	"./<thread>_test team_free\n"
 	"./<thread>_test harmonic    test_time max_threads mega_sum\n"
+	"./<thread>_test sweep_time  test_time max_threads kilo_term\n"
 	"./<thread>_test multi_newton test_time max_threads\\\n"
 	"	num_zero num_sub num_sum use_ad\\\n"
 	"where <thread> is bthread, openmp, or pthread";
@@ -288,11 +362,15 @@ int main(int argc, char *argv[])
 	bool run_a11c         = std::strcmp(test_name, "a11c")         == 0;
 	bool run_simple_ad    = std::strcmp(test_name, "simple_ad")    == 0;
 	bool run_team_example = std::strcmp(test_name, "team_example") == 0;
+	bool run_team_sweep   = std::strcmp(test_name, "team_sweep")   == 0;
+	bool run_team_free    = std::strcmp(test_name, "team_free")    == 0;
 	bool run_harmonic     = std::strcmp(test_name, "harmonic")     == 0;
+	bool run_sweep_time   = std::strcmp(test_name, "sweep_time")   == 0;
 	bool run_multi_newton = std::strcmp(test_name, "multi_newton") == 0;
-	if( run_a11c || run_simple_ad || run_team_example )
+	if( run_a11c || run_simple_ad || run_team_example || run_team_sweep
+	||  run_team_free )
 		ok = (argc == 2);
-	else if( run_harmonic )
+	else if( run_harmonic || run_sweep_time )
 		ok = (argc == 5);  
 	else if( run_multi_newton )
 		ok = (argc == 8);
@@ -302,12 +380,17 @@ int main(int argc, char *argv[])
 		std::cerr << usage << endl;
 		exit(1);
 	}
-	if( run_a11c || run_simple_ad || run_team_example )
+	if( run_a11c || run_simple_ad || run_team_example || run_team_sweep
+	||  run_team_free )
 	{	if( run_a11c )
 			ok        = a11c();
 		else if( run_simple_ad )
 			ok        = simple_ad();
-		else	ok        = team_example();
+		else if( run_team_example )
+			ok        = team_example();
+		else if( run_team_sweep )
+			ok        = team_sweep();
+		else	ok        = team_free();
 		if( thread_alloc::free_all() )
 			cout << "free_all      = true;"  << endl;
 		else
@@ -331,12 +414,19 @@ int main(int argc, char *argv[])
 	);
 
 	size_t mega_sum = 0; // assignment to avoid compiler warning
+	size_t kilo_term = 0;
 	if( run_harmonic )
 	{	// mega_sum
 		mega_sum = arg2size_t( *++argv, 1, 
 			"run: mega_sum is less than one"
 		);
 	}
+	else if( run_sweep_time )
+	{	// kilo_term
+		kilo_term = arg2size_t( *++argv, 1,
+			"run: kilo_term is less than one"
+		);
+	}
 	else
 	{	ok &= run_multi_newton;
 
@@ -368,52 +458,74 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	// is placement of memory on the NUMA node for each thread supported
+	// (it is only supported when there is more than one node)
+	bool numa_local = thread_alloc::numa_local(true);
+	thread_alloc::numa_local(false);
+	if( numa_local )
+		cout << "numa_local    = true;"  << endl;
+	else	cout << "numa_local    = false;" << endl;
+
 	// run the test for each number of threads
 	size_t num_threads, inuse_this_thread = 0;
 	cout << "time_all  = [" << endl;
 	for(num_threads = 0; num_threads <= max_threads; num_threads++)
-	{	double time_out;
-
-		// set the number of threads
-		if( num_threads > 0 )
-			ok &= team_create(num_threads);
-
-		// ammount of memory initialy inuse by thread zero
-		ok &= 0 == thread_alloc::thread_num();
-		inuse_this_thread = thread_alloc::inuse(0);
-
-		// run the requested test
-		if( run_harmonic ) ok &= 
-			harmonic_time(time_out, test_time, num_threads, mega_sum);
-		else
-		{	ok &= run_multi_newton;
-			ok &= multi_newton_time(
-				time_out                ,
-				test_time               ,
-				num_threads             ,
-				num_zero                ,
-				num_sub                 ,
-				num_sum                 ,
-				use_ad
-			);
-		}
-
-		// set back to one thread and fee all avaialable memory
-		if( num_threads > 0 )
-			ok &= team_destroy();
-		size_t thread;
-		for(thread = 0; thread < num_threads; thread++)
-		{	thread_alloc::free_available(thread);
-			if( thread == 0 )
-				ok &= thread_alloc::inuse(thread) == inuse_this_thread;
-			else	ok &= thread_alloc::inuse(thread) == 0;
+	{	cout << "\t";
+		// without and then with NUMA local placement (if supported)
+		size_t numa, num_numa = 1;
+		if( numa_local )
+			num_numa = 2;
+		for(numa = 0; numa < num_numa; numa++)
+		{	double time_out;
+			thread_alloc::numa_local(numa == 1);
+			// so that new memory is allocated with this setting
+			thread_alloc::free_available(0);
+
+			// set the number of threads
+			if( num_threads > 0 )
+				ok &= team_create(num_threads);
+
+			// ammount of memory initialy inuse by thread zero
+			ok &= 0 == thread_alloc::thread_num();
+			inuse_this_thread = thread_alloc::inuse(0);
+
+			// run the requested test
+			if( run_harmonic ) ok &= 
+				harmonic_time(time_out, test_time, num_threads, mega_sum);
+			else if( run_sweep_time ) ok &=
+				sweep_time(time_out, test_time, num_threads, kilo_term);
+			else
+			{	ok &= run_multi_newton;
+				ok &= multi_newton_time(
+					time_out                ,
+					test_time               ,
+					num_threads             ,
+					num_zero                ,
+					num_sub                 ,
+					num_sum                 ,
+					use_ad
+				);
+			}
+
+			// set back to one thread and fee all avaialable memory
+			if( num_threads > 0 )
+				ok &= team_destroy();
+			size_t thread;
+			for(thread = 0; thread < num_threads; thread++)
+			{	thread_alloc::free_available(thread);
+				if( thread == 0 )
+					ok &= thread_alloc::inuse(thread) == inuse_this_thread;
+				else	ok &= thread_alloc::inuse(thread) == 0;
+			}
+			cout << time_out << " ";
 		}
-		cout << "\t" << time_out << " % ";
+		cout << "% ";
 		if( num_threads == 0 )
 			cout << "no threading" << endl;
 		else	cout << num_threads << " threads" << endl;
 	}
 	cout << "];" << endl;
+	thread_alloc::numa_local(false);
 	//
 	if( thread_alloc::free_all() )
 		cout << "free_all      = true;"  << endl;
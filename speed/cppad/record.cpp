@@ -0,0 +1,103 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the 
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin cppad_record.cpp$$
+$spell
+	onetape
+	ADScalar
+	vector Vector
+	typedef
+	cppad
+	CppAD
+	hpp
+	const
+	bool
+	std
+$$
+
+$section CppAD Speed: Recording an Operation Sequence$$
+
+$index link_record, cppad$$
+$index cppad, link_record$$
+$index speed, cppad$$
+$index cppad, speed$$
+$index record, speed cppad$$
+
+$head Specifications$$
+See $cref link_record$$.
+
+$head Implementation$$
+
+$codep */
+# include <cppad/cppad.hpp>
+# include <cppad/speed/uniform_01.hpp>
+
+// Note that CppAD uses global_memory at the main program level
+extern bool
+	global_onetape, global_atomic, global_optimize;
+
+bool link_record(
+	size_t                     size     , 
+	size_t                     repeat   , 
+	CppAD::vector<double>     &a        ,  // parameters in the function
+	CppAD::vector<double>     &x        ,  // function argument value
+	CppAD::vector<double>     &y        )  // function value
+{
+	// speed test global option values
+	// (this test is the time for recording so there is only one tape)
+	if( global_onetape || global_atomic )
+		return false;
+
+	// -----------------------------------------------------
+	// setup
+	typedef CppAD::AD<double>       ADScalar; 
+	typedef CppAD::vector<ADScalar> ADVector; 
+
+	size_t j;      // temporary index
+	size_t m = 1;  // number of dependent variables
+	size_t n = 1;  // number of independent variables
+	ADVector X(n); // AD domain space vector
+	ADVector Y(m); // AD range space vector
+
+	// AD function object
+	CppAD::ADFun<double> f;
+
+	// --------------------------------------------------------------------
+	while(repeat--)
+	{	// choose the parameters and the argument value
+		CppAD::uniform_01(size, a);
+		CppAD::uniform_01(1, x);
+		X[0] = x[0];
+
+		// declare independent variables
+		Independent(X);
+
+		// AD computation of the function value 
+		// (each parameter is recorded twice)
+		Y[0] = 0.;
+		for(j = 0; j < size; j++)
+			Y[0] += a[j] * sin( X[0] + a[j] );
+
+		// create function object f : X -> Y
+		f.Dependent(X, Y);
+
+		if( global_optimize )
+			f.optimize();
+	}
+	// value of the last function recorded
+	y = f.Forward(0, x);
+
+	return true;
+}
+/* $$
+$end
+*/
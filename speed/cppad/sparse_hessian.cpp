@@ -56,7 +56,7 @@ $codep */
 
 // Note that CppAD uses global_memory at the main program level
 extern bool
-	global_onetape, global_colpack, 
+	global_onetape, global_colpack, global_acyclic,
 	global_atomic, global_optimize, global_boolsparsity;
 
 namespace {
@@ -167,6 +167,8 @@ bool link_sparse_hessian(
 
 		// structure that holds some of work done by SparseHessian
 		CppAD::sparse_hessian_work work;
+		if( global_acyclic )
+			work.color_method = "cppad.acyclic";
 # ifdef CPPAD_COLPACK_SPEED
 		if( global_colpack )
 			work.color_method = "colpack.star";
@@ -208,6 +210,8 @@ bool link_sparse_hessian(
 
 		// declare structure that holds some of work done by SparseHessian
 		CppAD::sparse_hessian_work work;
+		if( global_acyclic )
+			work.color_method = "cppad.acyclic";
 # ifdef CPPAD_COLPACK_SPEED
 		if( global_colpack )
 			work.color_method = "colpack.star";
@@ -0,0 +1,128 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the 
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin cppad_sparsity.cpp$$
+$spell
+	boolsparsity
+	onetape
+	ADScalar
+	vector Vector
+	typedef
+	cppad
+	CppAD
+	hpp
+	bool
+	std
+$$
+
+$section CppAD Speed: Jacobian Sparsity Pattern$$
+
+$index link_sparsity, cppad$$
+$index cppad, link_sparsity$$
+$index speed, cppad$$
+$index cppad, speed$$
+$index sparsity, speed cppad$$
+
+$head Specifications$$
+See $cref link_sparsity$$.
+
+$head Implementation$$
+
+$codep */
+# include <cppad/cppad.hpp>
+
+// Note that CppAD uses global_memory at the main program level
+extern bool
+	global_onetape, global_atomic, global_optimize, global_boolsparsity;
+
+namespace {
+	using CppAD::vector;
+	typedef vector< std::set<size_t> >  SetVector;
+	typedef vector<bool>                BoolVector;
+
+	void calc_sparsity(
+		CppAD::ADFun<double>& f, SetVector& r, vector<size_t>& n_nonzero)
+	{	size_t n = f.Domain();
+		SetVector s = f.ForSparseJac(n, r);
+		for(size_t i = 0; i < n; i++)
+			n_nonzero[i] = s[i].size();
+	}
+	void calc_sparsity(
+		CppAD::ADFun<double>& f, BoolVector& r, vector<size_t>& n_nonzero)
+	{	size_t n = f.Domain();
+		BoolVector s = f.ForSparseJac(n, r);
+		for(size_t i = 0; i < n; i++)
+		{	n_nonzero[i] = 0;
+			for(size_t j = 0; j < n; j++)
+				n_nonzero[i] += size_t( s[i * n + j] );
+		}
+	}
+}
+
+bool link_sparsity(
+	size_t                     size      ,
+	size_t                     repeat    ,
+	CppAD::vector<size_t>     &n_nonzero )  // nonzeros in each row
+{
+	// speed test global option values
+	// (the function is always recorded once)
+	if( global_onetape || global_atomic || global_optimize )
+		return false;
+
+	// -----------------------------------------------------
+	// setup
+	typedef CppAD::AD<double>       ADScalar;
+	typedef CppAD::vector<ADScalar> ADVector;
+
+	size_t i, j;
+	size_t n = size; // number of independent variables
+	size_t m = size; // number of dependent variables
+	ADVector X(n);   // AD domain space vector
+	ADVector Y(m);   // AD range space vector
+
+	// record the cumulative product
+	for(j = 0; j < n; j++)
+		X[j] = double(j + 1) / double(n);
+	Independent(X);
+	Y[0] = X[0];
+	for(i = 1; i < m; i++)
+		Y[i] = Y[i-1] * X[i];
+	CppAD::ADFun<double> f(X, Y);
+
+	// seed for computing the Jacobian sparsity pattern
+	SetVector  r_set;
+	BoolVector r_bool;
+	if( global_boolsparsity )
+	{	r_bool.resize(n * n);
+		for(i = 0; i < n; i++)
+		{	for(j = 0; j < n; j++)
+				r_bool[i * n + j] = (i == j);
+		}
+	}
+	else
+	{	r_set.resize(n);
+		for(j = 0; j < n; j++)
+			r_set[j].insert(j);
+	}
+
+	// --------------------------------------------------------------------
+	while(repeat--)
+	{	if( global_boolsparsity )
+			calc_sparsity(f, r_bool, n_nonzero);
+		else
+			calc_sparsity(f, r_set, n_nonzero);
+	}
+	return true;
+}
+/* $$
+$end
+*/
@@ -0,0 +1,70 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the 
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+/*
+$begin double_record.cpp$$
+$spell
+	onetape
+	bool
+	cppad
+	CppAD
+	hpp
+	std
+$$
+
+$section Double Speed: Evaluate the Recording Test Function$$
+
+$index link_record, double$$
+$index double, link_record$$
+$index speed, double$$
+$index double, speed$$
+$index record, speed double$$
+
+$head Specifications$$
+See $cref link_record$$.
+
+$head Implementation$$
+
+$codep */
+# include <cmath>
+# include <cppad/vector.hpp>
+# include <cppad/speed/uniform_01.hpp>
+
+// Note that CppAD uses global_memory at the main program level
+extern bool
+	global_onetape, global_atomic, global_optimize;
+
+bool link_record(
+	size_t                     size     , 
+	size_t                     repeat   , 
+	CppAD::vector<double>     &a        ,  // parameters in the function
+	CppAD::vector<double>     &x        ,  // function argument value
+	CppAD::vector<double>     &y        )  // function value
+{
+	if(global_onetape||global_atomic||global_optimize)
+		return false;
+	// -----------------------------------------------------
+	size_t j;
+	while(repeat--)
+	{	// choose the parameters and the argument value
+		CppAD::uniform_01(size, a);
+		CppAD::uniform_01(1, x);
+
+		// evaluate the function
+		y[0] = 0.;
+		for(j = 0; j < size; j++)
+			y[0] += a[j] * std::sin( x[0] + a[j] );
+	}
+	return true;
+}
+/* $$
+$end
+*/
@@ -0,0 +1,39 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the 
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/vector.hpp>
+
+/*
+$begin fadbad_record.cpp$$
+$spell
+	Fadbad
+	bool
+	CppAD
+$$
+
+$section Fadbad Speed: Recording an Operation Sequence$$
+
+$codep */
+// A fadbad version of this test is not yet implemented 
+extern bool link_record(
+	size_t                     size     , 
+	size_t                     repeat   , 
+	CppAD::vector<double>     &a        ,
+	CppAD::vector<double>     &x        ,
+	CppAD::vector<double>     &y        
+)
+{
+	return false;
+}
+/* $$
+$end
+*/
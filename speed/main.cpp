@@ -47,6 +47,7 @@ Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
 /*
 $begin speed_main$$
 $spell
+	acyclic
 	colpack
 	onetape
 	boolsparsity
@@ -123,8 +124,10 @@ $cref/det_lu/link_det_lu/$$,
 $cref/mat_mul/link_mat_mul/$$,
 $cref/ode/link_ode/$$,
 $cref/poly/link_poly/$$,
+$cref/record/link_record/$$,
 $cref/sparse_hessian/link_sparse_hessian/$$,
-$cref/sparse_jacobian/link_sparse_jacobian/$$.
+$cref/sparse_jacobian/link_sparse_jacobian/$$,
+$cref/sparsity/link_sparsity/$$.
 You can experiment with changing the implementation of a
 particular test for a particular package.
 
@@ -215,8 +218,9 @@ If it is false, CppAD will used standard memory allocation.
 
 $head Sparsity Options$$
 The following options only apply to the 
-$cref/sparse_jacobian/link_sparse_jacobian/$$ and
-$cref/sparse_hessian/link_sparse_hessian/$$ tests.
+$cref/sparse_jacobian/link_sparse_jacobian/$$,
+$cref/sparse_hessian/link_sparse_hessian/$$ and
+$cref/sparsity/link_sparsity/$$ tests.
 The other tests will ignore these options:
 
 $subhead boolsparsity$$
@@ -242,6 +246,20 @@ CppAD will use $cref/colpack/colpack_prefix/$$ to do the coloring
 for its 
 Otherwise, it will use it's own coloring algorithm.
 
+$subhead acyclic$$
+If the option $code acyclic$$ is present, the symbol
+$codep
+	extern bool global_acyclic
+$$
+is true and otherwise it is false.
+If this external symbol is true,
+CppAD will use its
+$cref/cppad.acyclic/sparse_hessian/work/color_method/$$ coloring
+(and recover the Hessian by substitution)
+for the sparse Hessian test.
+Comparing the number of sweeps with and without this option
+compares this coloring with the default coloring.
+
 $head Correctness Results$$
 One, but not both, of the following two output lines
 $codei%
@@ -291,8 +309,10 @@ $children%
 	speed/src/link_mat_mul.cpp%
 	speed/src/link_ode.cpp%
 	speed/src/link_poly.cpp%
+	speed/src/link_record.cpp%
 	speed/src/link_sparse_hessian.cpp%
 	speed/src/link_sparse_jacobian.cpp%
+	speed/src/link_sparsity.cpp%
 	speed/src/microsoft_timer.cpp
 %$$
 
@@ -306,8 +326,10 @@ $rref link_det_minor$$
 $rref link_mat_mul$$
 $rref link_ode$$
 $rref link_poly$$
+$rref link_record$$
 $rref link_sparse_hessian$$
 $rref link_sparse_jacobian$$
+$rref link_sparsity$$
 $tend
 
 
@@ -326,8 +348,10 @@ CPPAD_DECLARE_SPEED(det_minor);
 CPPAD_DECLARE_SPEED(mat_mul);
 CPPAD_DECLARE_SPEED(ode);
 CPPAD_DECLARE_SPEED(poly);
+CPPAD_DECLARE_SPEED(record);
 CPPAD_DECLARE_SPEED(sparse_hessian);
 CPPAD_DECLARE_SPEED(sparse_jacobian);
+CPPAD_DECLARE_SPEED(sparsity);
 
 // info is different for each test
 extern void info_sparse_jacobian(size_t size, size_t& n_sweep);
@@ -337,6 +361,7 @@ extern void info_sparse_hessian(size_t size, size_t& n_sweep);
 
 bool   global_onetape;
 bool   global_colpack;
+bool   global_acyclic;
 bool   global_optimize;
 bool   global_atomic;
 bool   global_memory;
@@ -352,6 +377,7 @@ namespace {
 		cout << " is not availabe with " << endl;
 		cout << "onetape = " << global_onetape << endl;
 		cout << "colpack = " << global_colpack << endl;
+		cout << "acyclic = " << global_acyclic << endl;
 		cout << "optimize = " << global_optimize << endl;
 		cout << "atomic = " << global_atomic << endl;
 		cout << "memory = " << global_memory << endl;
@@ -395,6 +421,8 @@ namespace {
 			cout << "_onetape";
 		if( global_colpack )
 			cout << "_colpack";
+		if( global_acyclic )
+			cout << "_acyclic";
 		if( global_optimize )
 			cout << "_optimize";
 		if( global_atomic )
@@ -458,8 +486,10 @@ int main(int argc, char *argv[])
 		test_mat_mul,
 		test_ode,
 		test_poly,
+		test_record,
 		test_sparse_hessian,
 		test_sparse_jacobian,
+		test_sparsity,
 		test_error
 	};
 	struct test_struct {
@@ -474,8 +504,10 @@ int main(int argc, char *argv[])
 		{ "mat_mul",            test_mat_mul         },
 		{ "ode",                test_ode             },
 		{ "poly",               test_poly            },
+		{ "record",             test_record          },
 		{ "sparse_hessian",     test_sparse_hessian  },
-		{ "sparse_jacobian",    test_sparse_jacobian }
+		{ "sparse_jacobian",    test_sparse_jacobian },
+		{ "sparsity",           test_sparsity        }
 	};
 	const size_t n_test  = sizeof(test_list) / sizeof(test_list[0]);
 
@@ -492,6 +524,7 @@ int main(int argc, char *argv[])
 		error |= iseed < 0;
 		global_onetape      = false;
 		global_colpack      = false;
+		global_acyclic      = false;
 		global_optimize     = false;
 		global_atomic       = false;
 		global_memory       = false;
@@ -501,6 +534,8 @@ int main(int argc, char *argv[])
 				global_onetape = true;
 			else if( strcmp(argv[i], "colpack") == 0 )
 				global_colpack = true;
+			else if( strcmp(argv[i], "acyclic") == 0 )
+				global_acyclic = true;
 			else if( strcmp(argv[i], "optimize") == 0 )
 				global_optimize = true;
 			else if( strcmp(argv[i], "atomic") == 0 )
@@ -524,6 +559,7 @@ int main(int argc, char *argv[])
 		cout << "option choices: ";
 		cout << " \"onetape\",";
 		cout << " \"colpack\",";
+		cout << " \"acyclic\",";
 		cout << " \"optimize\",";
 		cout << " \"atomic\",";
 		cout << " \"memory\",";
@@ -543,16 +579,20 @@ int main(int argc, char *argv[])
 	CppAD::vector<size_t> size_mat_mul(n_size);
 	CppAD::vector<size_t> size_ode(n_size);
 	CppAD::vector<size_t> size_poly(n_size);
+	CppAD::vector<size_t> size_record(n_size);
 	CppAD::vector<size_t> size_sparse_hessian(n_size);
 	CppAD::vector<size_t> size_sparse_jacobian(n_size);
+	CppAD::vector<size_t> size_sparsity(n_size);
 	for(i = 0; i < n_size; i++) 
 	{	size_det_minor[i]   = i + 1;
 		size_det_lu[i]      = 10 * i + 1;
 		size_mat_mul[i]     = 10 * i + 1;
 		size_ode[i]         = 10 * i + 1;
 		size_poly[i]        = 10 * i + 1;
+		size_record[i]      = (i == 0) ? 100 : 10 * size_record[i-1];
 		size_sparse_hessian[i]  = 100 * (i + 1) * (i + 1);
 		size_sparse_jacobian[i] = 100 * (i + 1) * (i + 1);
+		size_sparsity[i]        = 1000 * (i + 1);
 	}
 
 	switch(match)
@@ -572,6 +612,9 @@ int main(int argc, char *argv[])
 		);
 		ok &= run_correct( available_poly, correct_poly, "poly"         
 		);
+		ok &= run_correct(
+			available_record, correct_record, "record"         
+		);
 		ok &= run_correct(
 			available_sparse_hessian, 
 			correct_sparse_hessian,
@@ -582,6 +625,9 @@ int main(int argc, char *argv[])
 			correct_sparse_jacobian,
 			"sparse_jacobian"         
 		);
+		ok &= run_correct(
+			available_sparsity, correct_sparsity, "sparsity"
+		);
 		// summarize results
 		assert( ok || (Run_error_count > 0) );
 		if( ok )
@@ -611,12 +657,18 @@ int main(int argc, char *argv[])
 		if( available_poly() ) run_speed(
 		speed_poly,            size_poly,            "poly"
 		);
+		if( available_record() ) run_speed(
+		speed_record,          size_record,          "record"
+		);
 		if( available_sparse_hessian() ) run_speed(
 		speed_sparse_hessian,  size_sparse_hessian,  "sparse_hessian"
 		);
 		if( available_sparse_jacobian() ) run_speed(
 		speed_sparse_jacobian, size_sparse_jacobian, "sparse_jacobian"
 		);
+		if( available_sparsity() ) run_speed(
+		speed_sparsity,        size_sparsity,        "sparsity"
+		);
 		ok = true;
 		break;
 		// ---------------------------------------------------------
@@ -681,6 +733,18 @@ int main(int argc, char *argv[])
 		break;
 		// ---------------------------------------------------------
 
+		case test_record:
+		if( ! available_record() )
+		{	not_available_message( argv[1] ); 
+			exit(1);
+		}
+		ok &= run_correct(
+			available_record, correct_record, "record"
+		);
+		run_speed(speed_record,    size_record,    "record");
+		break;
+		// ---------------------------------------------------------
+
 		case test_sparse_hessian:
 		if( ! available_sparse_hessian() )
 		{	not_available_message( argv[1] ); 
@@ -732,6 +796,17 @@ int main(int argc, char *argv[])
 		cout << " ]" << endl;
 		break;
 		// ---------------------------------------------------------
+		case test_sparsity:
+		if( ! available_sparsity() )
+		{	not_available_message( argv[1] );
+			exit(1);
+		}
+		ok &= run_correct(
+			available_sparsity, correct_sparsity, "sparsity"
+		);
+		run_speed(speed_sparsity,  size_sparsity,  "sparsity");
+		break;
+		// ---------------------------------------------------------
 		
 		default:
 		assert(0);
@@ -743,8 +818,10 @@ int main(int argc, char *argv[])
 	size_mat_mul.clear();
 	size_ode.clear();
 	size_poly.clear();
+	size_record.clear();
 	size_sparse_hessian.clear();
 	size_sparse_jacobian.clear();
+	size_sparsity.clear();
 	// check for memory leak
 	if( CppAD::thread_alloc::free_all() )
 	{	Run_ok_count++;
@@ -0,0 +1,38 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the 
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+# include <cppad/vector.hpp>
+
+/*
+$begin sacado_sparsity.cpp$$
+$spell
+	Sacado
+	bool
+	CppAD
+	Jacobian
+$$
+
+$section Sacado Speed: Jacobian Sparsity Pattern$$
+
+$codep */
+// A sacado version of this test is not yet implemented
+extern bool link_sparsity(
+	size_t                     size      ,
+	size_t                     repeat    ,
+	CppAD::vector<size_t>     &n_nonzero
+)
+{
+	return false;
+}
+/* $$
+$end
+*/
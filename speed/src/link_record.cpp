@@ -0,0 +1,126 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the 
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin link_record$$
+$spell
+	bool
+	CppAD
+$$
+
+$index link_record$$
+$index record, speed test$$
+$index speed, test record$$
+$index test, record speed$$
+
+$section Speed Testing Recording an Operation Sequence$$
+
+$head Prototype$$
+$codei%extern bool link_record(
+	size_t                 %size%    , 
+	size_t                 %repeat%  , 
+	CppAD::vector<double> &%a%       ,
+	CppAD::vector<double> &%x%       ,
+	CppAD::vector<double> &%y%
+);
+%$$
+
+$head Purpose$$
+Each $cref/package/speed_main/package/$$
+must define a version of this routine as specified below.
+This is used by the $cref speed_main$$ program 
+to run the corresponding speed and correctness tests.
+
+$head Method$$
+The function that is recorded is
+$latex \[
+	y = f(x) = \sum_{j=0}^{size-1} a_j \sin( x + a_j )
+\] $$
+where the parameters $latex a_j$$ are all different.
+This tests the speed of recording operation sequences that have
+a large number of parameters.
+If the $cref/optimize/speed_main/option_list/optimize/$$ option is present,
+the time to optimize the recording is included.
+
+$head Return Value$$
+If this speed test is not yet
+supported by a particular $icode package$$,
+the corresponding return value for $code link_record$$ 
+should be $code false$$.
+
+$head size$$
+The argument $icode size$$ is the number of parameters $latex a_j$$
+in the function (and the number of terms in the summation).
+
+$head repeat$$
+The argument $icode repeat$$ is the number of times the function is recorded
+(a new set of parameters and a new argument value is used for each recording).
+
+$head a$$
+The argument $icode a$$ is a vector with $icode%size%$$ elements.
+The input value of its elements does not matter. 
+The output value of its elements is the parameters
+in the last function that was recorded.
+
+$head x$$
+The argument $icode x$$ is a vector with one element.
+The input value of the element does not matter.
+The output of its element is the argument value
+for the last function that was recorded.
+
+$head y$$
+The argument $icode y$$ is a vector with one element.
+The input value of its element does not matter.
+The output value of its element is the value of the last function
+that was recorded at the argument value $icode x$$.
+
+$end 
+-----------------------------------------------------------------------------
+*/
+# include <cmath>
+# include <cppad/vector.hpp>
+# include <cppad/near_equal.hpp>
+
+extern bool link_record(
+	size_t                     size     , 
+	size_t                     repeat   , 
+	CppAD::vector<double>      &a       ,
+	CppAD::vector<double>      &x       ,
+	CppAD::vector<double>      &y        
+);
+bool available_record(void)
+{	size_t size   = 10;
+	size_t repeat = 1;
+	CppAD::vector<double>  a(size), x(1), y(1);
+
+	return link_record(size, repeat, a, x, y);
+}
+bool correct_record(bool is_package_double)
+{	size_t size   = 10;
+	size_t repeat = 1;
+	CppAD::vector<double>  a(size), x(1), y(1);
+
+	link_record(size, repeat, a, x, y);
+
+	double check = 0.;
+	for(size_t j = 0; j < size; j++)
+		check += a[j] * std::sin( x[0] + a[j] );
+
+	bool ok = CppAD::NearEqual(check, y[0], 1e-10, 1e-10);
+	return ok;
+}
+void speed_record(size_t size, size_t repeat)
+{	CppAD::vector<double>  a(size), x(1), y(1);
+
+	link_record(size, repeat, a, x, y);
+	return;
+}
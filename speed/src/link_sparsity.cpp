@@ -0,0 +1,116 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the 
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+$begin link_sparsity$$
+$spell
+	bool
+	CppAD
+	Jacobian
+	boolsparsity
+$$
+
+$index link_sparsity$$
+$index sparsity, speed test$$
+$index speed, test sparsity$$
+$index test, sparsity speed$$
+
+$section Speed Testing Jacobian Sparsity Patterns$$
+
+$head Prototype$$
+$codei%extern bool link_sparsity(
+	size_t                 %size%      ,
+	size_t                 %repeat%    ,
+	CppAD::vector<size_t> &%n_nonzero%
+);
+%$$
+
+$head Purpose$$
+Each $cref/package/speed_main/package/$$
+must define a version of this routine as specified below.
+This is used by the $cref speed_main$$ program
+to run the corresponding speed and correctness tests.
+
+$head Method$$
+The function $latex f : \B{R}^n \rightarrow \B{R}^n$$
+is the cumulative product
+$latex \[
+	f_i (x) = \prod_{j=0}^{i} x_j
+\] $$
+where $latex n$$ is equal to $icode size$$.
+The sparsity pattern for its Jacobian is computed using
+forward mode with the $latex n \times n$$ identity matrix as the seed.
+The pattern is lower triangular, so most of the sets propagated
+by the computation are dense
+(this tests the speed of operations on wide sparsity patterns).
+The time to record the function is not included
+(it is recorded once for each call to $code link_sparsity$$).
+The $cref/boolsparsity/speed_main/Sparsity Options/boolsparsity/$$
+option determines which type of sparsity pattern is used.
+
+$head Return Value$$
+If this speed test is not yet
+supported by a particular $icode package$$,
+the corresponding return value for $code link_sparsity$$
+should be $code false$$.
+
+$head size$$
+The argument $icode size$$ is the number of independent variables
+(and the number of dependent variables) for the function.
+
+$head repeat$$
+The argument $icode repeat$$ is the number of times the sparsity pattern
+is computed.
+
+$head n_nonzero$$
+The argument $icode n_nonzero$$ is a vector with $icode%size%$$ elements.
+The input value of its elements does not matter.
+The output value of $icode%n_nonzero%[%i%]%$$ is the number of
+elements in row $icode i$$ of the sparsity pattern
+(for the last time it was computed).
+
+$end
+-----------------------------------------------------------------------------
+*/
+# include <cppad/vector.hpp>
+
+extern bool link_sparsity(
+	size_t                     size      ,
+	size_t                     repeat    ,
+	CppAD::vector<size_t>      &n_nonzero
+);
+bool available_sparsity(void)
+{	size_t size   = 10;
+	size_t repeat = 1;
+	CppAD::vector<size_t>  n_nonzero(size);
+
+	return link_sparsity(size, repeat, n_nonzero);
+}
+bool correct_sparsity(bool is_package_double)
+{	// more than one Pack value per row for sparse_pack
+	size_t size   = 150;
+	size_t repeat = 1;
+	CppAD::vector<size_t>  n_nonzero(size);
+
+	link_sparsity(size, repeat, n_nonzero);
+
+	bool ok = true;
+	for(size_t i = 0; i < size; i++)
+		ok &= n_nonzero[i] == i + 1;
+	return ok;
+}
+void speed_sparsity(size_t size, size_t repeat)
+{	CppAD::vector<size_t>  n_nonzero(size);
+
+	link_sparsity(size, repeat, n_nonzero);
+	return;
+}
@@ -0,0 +1,105 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+Check the thread_alloc statistics for the memory used by ADFun objects.
+*/
+
+# include <cppad/cppad.hpp>
+
+bool alloc_statistics(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::thread_alloc;
+	size_t thread = thread_alloc::thread_num();
+	size_t j;
+
+	// start collecting statistics
+	thread_alloc::statistics(true);
+	ok &= thread_alloc::peak_inuse(thread) == 0;
+	size_t other = thread_alloc::tag_inuse(thread_alloc::other_tag, thread);
+	{
+		// recording is attributed to the recorder tag
+		size_t n = 20;
+		CppAD::vector< AD<double> > a_x(n), a_y(1);
+		for(j = 0; j < n; j++)
+			a_x[j] = double(j);
+		CppAD::Independent(a_x);
+		a_y[0] = 0.;
+		for(j = 0; j < n; j++)
+			a_y[0] += a_x[j] * a_x[j];
+		ok &= thread_alloc::tag_inuse(thread_alloc::recorder_tag, thread) > 0;
+
+		// Taylor coefficients are attributed to the Taylor tag
+		CppAD::ADFun<double> f(a_x, a_y);
+		size_t recorder =
+			thread_alloc::tag_inuse(thread_alloc::recorder_tag, thread);
+		size_t taylor   =
+			thread_alloc::tag_inuse(thread_alloc::taylor_tag, thread);
+		ok &= recorder > 0;
+		ok &= taylor >= f.size_var() * sizeof(double);
+
+		// sparsity patterns are attributed to the sparsity tag
+		CppAD::vector<bool> r(n * n), s(n);
+		for(j = 0; j < n * n; j++)
+			r[j] = (j % (n + 1)) == 0;
+		s = f.ForSparseJac(n, r);
+		ok &= thread_alloc::tag_inuse(thread_alloc::sparsity_tag, thread) > 0;
+
+		// so are the sets in a sparse_hybrid vector of sets
+		size_t sparsity =
+			thread_alloc::tag_inuse(thread_alloc::sparsity_tag, thread);
+		CppAD::sparse_hybrid hybrid;
+		hybrid.resize(n, 10 * n);
+		for(j = 0; j < n; j++)
+			hybrid.add_element(j, j);
+		ok &= thread_alloc::tag_inuse(thread_alloc::sparsity_tag, thread)
+			>= sparsity + n * sizeof(size_t);
+
+		// more orders of Taylor coefficients
+		CppAD::vector<double> x(n), dx(n);
+		for(j = 0; j < n; j++)
+		{	x[j]  = double(j);
+			dx[j] = 1.;
+		}
+		f.Forward(0, x);
+		f.Forward(1, dx);
+		ok &= thread_alloc::tag_inuse(thread_alloc::taylor_tag, thread) > taylor;
+
+		// so are the Taylor coefficients in a copy of f
+		// (for example, the copy used by each thread in parallel mode)
+		taylor = thread_alloc::tag_inuse(thread_alloc::taylor_tag, thread);
+		CppAD::ADFun<double> g;
+		g = f;
+		ok &= g.size_order() == 2;
+		ok &= thread_alloc::tag_inuse(thread_alloc::taylor_tag, thread)
+			>= taylor + 2 * f.size_var() * sizeof(double);
+
+		// peak includes all the memory above
+		ok &= thread_alloc::peak_inuse(thread) >= recorder + taylor;
+
+		// the report contains a line for each tag
+		std::stringstream os;
+		thread_alloc::statistics_report(os);
+		ok &= os.str().find("taylor") != std::string::npos;
+		ok &= os.str().find("recorder") != std::string::npos;
+	}
+	// all the memory above has been returned
+	ok &= thread_alloc::tag_inuse(thread_alloc::taylor_tag, thread) == 0;
+	ok &= thread_alloc::tag_inuse(thread_alloc::recorder_tag, thread) == 0;
+	ok &= thread_alloc::tag_inuse(thread_alloc::sparsity_tag, thread) == 0;
+	ok &= thread_alloc::tag_inuse(thread_alloc::other_tag, thread) == other;
+
+	// stop collecting statistics
+	thread_alloc::statistics(false);
+	return ok;
+}
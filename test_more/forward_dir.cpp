@@ -1580,6 +1580,116 @@ namespace {
 	}
 	bool tanh_op(void)
 	{	return check_identity(tanh_fun, 0.5); }
+	// ---------------------------------------------------------------------
+	// Many directions and higher orders compared with one direction at a time
+	bool many_dir(void)
+	{	bool ok = true;
+		double eps = 100. * std::numeric_limits<double>::epsilon();
+		size_t j, i, k, ell;
+
+		// domain space vector
+		size_t n = 2;
+		CPPAD_TESTVECTOR(AD<double>) ax(n);
+		ax[0] = 0.5;
+		ax[1] = 2.0;
+
+		// declare independent variables and starting recording
+		CppAD::Independent(ax);
+
+		// range space vector
+		size_t m = 3;
+		CPPAD_TESTVECTOR(AD<double>) ay(m);
+		AD<double> au = ax[0] * ax[1];
+		ay[0] = exp(au) / sqrt(ax[1]) - log(ax[1]) * au;
+		ay[1] = sin(au) * cos(ax[0]) + sinh(ax[0]) / cosh(au);
+		ay[2] = 3.0 / ax[1] + au * ay[0];
+
+		// create f: x -> y and stop tape recording
+		CppAD::ADFun<double> f(ax, ay);
+
+		// zero order Taylor coefficients
+		CPPAD_TESTVECTOR(double) x0(n), y0;
+		x0[0] = 0.5;
+		x0[1] = 2.0;
+		y0    = f.Forward(0, x0);
+
+		// orders one through three in r directions at the same time
+		size_t r = 5, p = 3;
+		CPPAD_TESTVECTOR(double) xq(r*n);
+		CPPAD_TESTVECTOR(double) yq[3];
+		for(k = 1; k <= p; k++)
+		{	for(j = 0; j < n; j++)
+			{	for(ell = 0; ell < r; ell++)
+					xq[r*j+ell] = double(k + j + 2 * ell + 1) / double(r);
+			}
+			yq[k-1] = f.Forward(k, r, xq);
+			ok &= yq[k-1].size() == r*m;
+		}
+
+		// one direction at a time
+		CPPAD_TESTVECTOR(double) xk(n), yk;
+		for(ell = 0; ell < r; ell++)
+		{	f.Forward(0, x0);
+			for(k = 1; k <= p; k++)
+			{	for(j = 0; j < n; j++)
+					xk[j] = double(k + j + 2 * ell + 1) / double(r);
+				yk = f.Forward(k, xk);
+				for(i = 0; i < m; i++)
+					ok &= NearEqual(yk[i], yq[k-1][r*i+ell], eps, eps);
+			}
+		}
+		return ok;
+	}
+	// ---------------------------------------------------------------------
+	// ErfOp (many directions compared with one direction at a time)
+	bool erf_op(void)
+	{	bool ok = true;
+# if CPPAD_COMPILER_HAS_ERF
+		double eps = 100. * std::numeric_limits<double>::epsilon();
+		size_t j, k, ell;
+
+		// f(x) = erf( x[0] * x[1] )
+		size_t n = 2, m = 1;
+		CPPAD_TESTVECTOR(AD<double>) ax(n), ay(m);
+		ax[0] = 0.5;
+		ax[1] = 2.0;
+		CppAD::Independent(ax);
+		ay[0] = erf( ax[0] * ax[1] );
+		CppAD::ADFun<double> f(ax, ay);
+
+		// zero order Taylor coefficients
+		CPPAD_TESTVECTOR(double) x0(n);
+		x0[0] = 0.5;
+		x0[1] = 0.25;
+		f.Forward(0, x0);
+
+		// orders one through three in r directions at the same time
+		size_t r = 3, p = 3;
+		CPPAD_TESTVECTOR(double) xq(r*n);
+		CPPAD_TESTVECTOR(double) yq[3];
+		for(k = 1; k <= p; k++)
+		{	for(j = 0; j < n; j++)
+			{	for(ell = 0; ell < r; ell++)
+					xq[r*j+ell] = double(k + j + 2 * ell + 1) / double(r);
+			}
+			yq[k-1] = f.Forward(k, r, xq);
+			ok &= yq[k-1].size() == r*m;
+		}
+
+		// one direction at a time
+		CPPAD_TESTVECTOR(double) xk(n), yk;
+		for(ell = 0; ell < r; ell++)
+		{	f.Forward(0, x0);
+			for(k = 1; k <= p; k++)
+			{	for(j = 0; j < n; j++)
+					xk[j] = double(k + j + 2 * ell + 1) / double(r);
+				yk = f.Forward(k, xk);
+				ok &= NearEqual(yk[0], yq[k-1][ell], eps, eps);
+			}
+		}
+# endif
+		return ok;
+	}
 }
 
 bool forward_dir(void)
@@ -1599,9 +1709,11 @@ bool forward_dir(void)
 	ok     &= divpv_op();
 	ok     &= divvp_op();
 	ok     &= divvv_op();
+	ok     &= erf_op();
 	ok     &= exp_op();
 	ok     &= load_op();
 	ok     &= log_op();
+	ok     &= many_dir();
 	ok     &= mulpv_op();
 	ok     &= par_op();
 	ok     &= powpv_op();
@@ -1,6 +1,6 @@
 /* $Id$ */
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-12 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -43,6 +43,74 @@ Vector eval_jac_g(const Vector&  x)
 	return jac_g;
 }
 
+// Jacobian and Hessian with more than 64 directions; i.e., more than
+// one multiple direction sweep, with and without VecAD operations
+bool many_directions(size_t n, size_t m, bool use_vecad)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::vector;
+	using CppAD::NearEqual;
+	size_t i, j, k, a, b, c;
+	double eps = 100. * CppAD::epsilon<double>();
+
+	vector< AD<double> > ax(n), ay(m);
+	vector<double> x(n), w(m);
+	for(j = 0; j < n; j++)
+		ax[j] = x[j] = 1. + double(j) / double(n);
+	CppAD::Independent(ax);
+	CppAD::VecAD<double> av(1);
+	AD<double> azero = 0.;
+	av[azero] = ax[0];
+	// y[i] = x[a] * x[b] + sin( x[c] )
+	for(i = 0; i < m; i++)
+	{	a = i % n;
+		b = (i + 1) % n;
+		c = (i + 2) % n;
+		if( use_vecad & (i == 0) )
+			ay[i] = av[azero] * ax[b] + sin( ax[c] );
+		else
+			ay[i] = ax[a] * ax[b] + sin( ax[c] );
+		w[i] = 1. / double(i + 1);
+	}
+	// last component of f is a parameter
+	ay[m-1] = 2.;
+	CppAD::ADFun<double> f(ax, ay);
+
+	// Jacobian
+	vector<double> jac = f.Jacobian(x);
+	for(i = 0; i < m; i++)
+	{	a = i % n;
+		b = (i + 1) % n;
+		c = (i + 2) % n;
+		vector<double> check(n);
+		for(j = 0; j < n; j++)
+			check[j] = 0.;
+		if( i < m - 1 )
+		{	check[a] += x[b];
+			check[b] += x[a];
+			check[c] += std::cos( x[c] );
+		}
+		for(j = 0; j < n; j++)
+			ok &= NearEqual(jac[i * n + j], check[j], eps, eps);
+	}
+
+	// Hessian
+	vector<double> hes = f.Hessian(x, w), check(n * n);
+	for(k = 0; k < n * n; k++)
+		check[k] = 0.;
+	for(i = 0; i < m - 1; i++)
+	{	a = i % n;
+		b = (i + 1) % n;
+		c = (i + 2) % n;
+		check[a * n + b] += w[i];
+		check[b * n + a] += w[i];
+		check[c * n + c] -= w[i] * std::sin( x[c] );
+	}
+	for(k = 0; k < n * n; k++)
+		ok &= NearEqual(hes[k], check[k], eps, eps);
+
+	return ok;
+}
 
 } // End empty namespace 
 
@@ -98,6 +166,12 @@ bool jacobian(void)
 	for(k = 0; k < m *n; k++)
 		ok &= CppAD::NearEqual(jac_g[k], check[k], 1e-10, 1e-10);
 
+	// forward mode (n <= m) and reverse mode (n > m) cases
+	ok &= many_directions(100, 150, false);
+	ok &= many_directions(150, 100, false);
+	ok &= many_directions(100, 150, true);
+	ok &= many_directions(150, 100, true);
+
 	return ok;
 }
 // END PROGRAM
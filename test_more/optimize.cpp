@@ -874,6 +874,62 @@ namespace {
 
 		return ok;
 	}
+	// -------------------------------------------------------------------
+	bool duplicate_five(void)
+	{	// Check that matches are found when there are more operations
+		// than CPPAD_HASH_TABLE_SIZE between an expression and its duplicate
+		// (the hash table size grows with the size of the tape).
+		bool ok = true;
+		using CppAD::AD;
+		size_t j;
+
+		// domain space vector
+		size_t n  = 1;
+		CppAD::vector< AD<double> > X(n);
+		X[0] = 1.;
+
+		// range space vector
+		size_t m = 2;
+		CppAD::vector< AD<double> > Y(m);
+
+		// declare independent variables and start tape recording
+		CppAD::Independent(X);
+
+		// the same chain of operations twice
+		size_t n_operations = std::min(
+			2 * size_t(CPPAD_HASH_TABLE_SIZE),
+			size_t(std::numeric_limits<CPPAD_TAPE_ADDR_TYPE>::max()) / 3
+		);
+		Y[0] = X[0];
+		Y[1] = X[0];
+		for(j = 0; j < n_operations; j++)
+			Y[0] = abs(Y[0]);
+		for(j = 0; j < n_operations; j++)
+			Y[1] = abs(Y[1]);
+
+		// create f: X -> Y and stop tape recording
+		CppAD::ADFun<double> F;
+		F.Dependent(X, Y); 
+
+		// check number of variables in original function
+		ok &= (F.size_var() ==  1 + n + 2 * n_operations ); 
+	
+		CppAD::vector<double> x(n), y(m);
+		x[0] = -1.;
+
+		y   = F.Forward(0, x);
+		ok &= ( y[0] == 1. && y[1] == 1. );
+
+		F.optimize();
+
+		// check the second chain has been removed in optimized version
+		ok &= (F.size_var() == 1 + n + n_operations ); 
+
+		y   = F.Forward(0, x);
+		ok &= ( y[0] == 1. && y[1] == 1. );
+
+		return ok;
+	}
 	// ====================================================================
 	bool cummulative_sum(void)
 	{	// test conversion of a sequence of additions and subtraction
@@ -1715,6 +1771,7 @@ bool optimize(void)
 	ok     &= duplicate_two();
 	ok     &= duplicate_three();
 	ok     &= duplicate_four();
+	ok     &= duplicate_five();
 	// convert sequence of additions to cummulative summation
 	ok     &= cummulative_sum();
 	ok     &= forward_csum();
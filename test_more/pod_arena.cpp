@@ -0,0 +1,120 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+Test the segmented vectors used by the recorder.
+*/
+# include <cppad/cppad.hpp>
+
+namespace {
+	// ----------------------------------------------------------------
+	// Test pod_arena directly
+	bool arena_elements(void)
+	{	bool ok = true;
+		size_t i, j;
+
+		// number of elements (more than fit in the first few segments)
+		size_t n = 10001;
+
+		CppAD::pod_arena<double> arena;
+		CppAD::pod_vector<double> vec;
+		for(size_t repeat = 0; repeat < 2; repeat++)
+		{	// add elements three at a time (some are split between segments)
+			for(i = 0; i < n; i += 3)
+			{	size_t k = arena.extend(3);
+				ok &= k == i;
+				if( i == 0 && repeat == 1 )
+				{	// first segment holds all the elements from last time
+					ok &= arena.capacity() >= n;
+				}
+				for(j = 0; j < 3; j++)
+					arena[k + j] = double(k + j);
+			}
+			ok &= arena.size() == i;
+			ok &= arena.size() <= arena.capacity();
+
+			// check element values (in reverse order)
+			for(j = 0; j < i; j++)
+				ok &= arena[i - j - 1] == double(i - j - 1);
+
+			// move to a pod_vector
+			arena.flatten(vec);
+			ok &= arena.size() == 0;
+			ok &= arena.capacity() == 0;
+			ok &= vec.size() == i;
+			for(j = 0; j < i; j++)
+				ok &= vec[j] == double(j);
+		}
+		return ok;
+	}
+	// ----------------------------------------------------------------
+	// Record the same function twice using the same tape
+	bool record_twice(void)
+	{	bool ok = true;
+		using CppAD::AD;
+		using CppAD::vector;
+
+		// number of terms (more than fit in the first few segments)
+		size_t n_term = 5000;
+		size_t n = 2, m = 2, j, k;
+
+		vector<double> x(n), y_0, y_1;
+		x[0] = 0.5;
+		x[1] = 1.5;
+		size_t size_var = 0;
+		for(size_t repeat = 0; repeat < 2; repeat++)
+		{	vector< AD<double> > ax(n), ay(m);
+			for(j = 0; j < n; j++)
+				ax[j] = x[j];
+			CppAD::Independent(ax);
+
+			// use operators, parameters, and VecAD vectors
+			CppAD::VecAD<double> av(n_term);
+			AD<double> asum = 0.;
+			for(k = 0; k < n_term; k++)
+			{	AD<double> ak = double(k);
+				av[ak]  = double(k) / double(n_term);
+				asum   += av[ak] * sin( ax[k % n] + double(k) );
+			}
+			ay[0] = asum;
+			ay[1] = av[ ax[0] ];
+			CppAD::ADFun<double> f(ax, ay);
+
+			if( repeat == 0 )
+			{	y_0      = f.Forward(0, x);
+				size_var = f.size_var();
+			}
+			else
+			{	y_1 = f.Forward(0, x);
+				ok &= f.size_var() == size_var;
+				for(k = 0; k < m; k++)
+					ok &= y_0[k] == y_1[k];
+			}
+		}
+		// check the function value
+		double check = 0.;
+		for(k = 0; k < n_term; k++)
+			check += double(k) / double(n_term) * sin(x[k % n] + double(k));
+		double eps = 100. * CppAD::numeric_limits<double>::epsilon();
+		ok &= CppAD::NearEqual(y_0[0], check, eps, eps);
+		ok &= y_0[1] == 0.;
+
+		return ok;
+	}
+}
+
+bool pod_arena(void)
+{	bool ok = true;
+	ok     &= arena_elements();
+	ok     &= record_twice();
+	return ok;
+}
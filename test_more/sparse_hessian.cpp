@@ -1,6 +1,6 @@
 /* $Id$ */
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-12 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -15,6 +15,8 @@ Old SparseHessian example
 */
 
 # include <cppad/cppad.hpp>
+# include <cppad/speed/sparse_hes_fun.hpp>
+# include <cppad/speed/uniform_01.hpp>
 namespace { // ---------------------------------------------------------
 
 bool rc_tridiagonal(void)
@@ -97,6 +99,198 @@ bool rc_tridiagonal(void)
 
 	return ok;
 }
+bool color_method(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	size_t i, j, k, ell;
+	double eps = 10. * CppAD::epsilon<double>();
+
+	// random lower triangle entries (and all the diagonal entries)
+	size_t n = 30;
+	CppAD::vector<size_t> row, col;
+	CppAD::vector<double> random(5);
+	for(i = 0; i < n; i++)
+	{	CppAD::uniform_01(5, random);
+		row.push_back(i);
+		col.push_back(i);
+		for(ell = 0; ell < 5; ell++)
+		{	j = size_t( random[ell] * double(i) );
+			bool found = false;
+			for(k = 0; k < row.size(); k++)
+				found |= row[k] == i && col[k] == j;
+			if( ! found )
+			{	row.push_back(i);
+				col.push_back(j);
+			}
+		}
+	}
+	size_t K = row.size();
+
+	// function corresponding to these entries
+	CppAD::vector< AD<double> > a_x(n), a_y(1);
+	CppAD::vector<double> x(n), w(1), check(K), hes(K);
+	for(j = 0; j < n; j++)
+		a_x[j] = x[j] = double(j + 1) / double(n);
+	CppAD::Independent(a_x);
+	CppAD::sparse_hes_fun< AD<double> >(n, a_x, row, col, 0, a_y);
+	CppAD::ADFun<double> f(a_x, a_y);
+	CppAD::sparse_hes_fun<double>(n, x, row, col, 2, check);
+	w[0] = 1.0;
+
+	// sparsity pattern for the Hessian
+	typedef CppAD::vector< std::set<size_t> > VectorSet;
+	VectorSet r(n), s(1);
+	for(j = 0; j < n; j++)
+		r[j].insert(j);
+	f.ForSparseJac(n, r);
+	s[0].insert(0);
+	VectorSet p = f.RevSparseHes(n, s);
+
+	// compare the coloring methods
+	const char* method[] = {
+		"cppad.symmetric", "cppad.general", "cppad.star", "cppad.acyclic",
+		"cppad.edge"
+	};
+	size_t n_method = sizeof(method) / sizeof(method[0]);
+	CppAD::vector<size_t> n_sweep(n_method);
+	for(ell = 0; ell < n_method; ell++)
+	{	CppAD::sparse_hessian_work work;
+		work.color_method = method[ell];
+		for(size_t rep = 0; rep < 2; rep++)
+		{	// second time uses the coloring stored in work
+			n_sweep[ell] = f.SparseHessian(x, w, p, row, col, hes, work);
+			for(k = 0; k < K; k++)
+				ok &= NearEqual(check[k], hes[k], eps, eps);
+		}
+	}
+	// the acyclic coloring does not use more colors than the star coloring
+	ok &= n_sweep[3] <= n_sweep[2];
+
+	// a path (tridiagonal Hessian) has an acyclic coloring with two colors
+	n = 12;
+	a_x.resize(n);
+	x.resize(n);
+	for(j = 0; j < n; j++)
+		a_x[j] = x[j] = double(j + 1);
+	CppAD::Independent(a_x);
+	a_y[0] = 0.;
+	for(j = 0; j < n - 1; j++)
+		a_y[0] += a_x[j] * a_x[j] * a_x[j+1];
+	f.Dependent(a_x, a_y);
+	row.resize(0);
+	col.resize(0);
+	p.resize(n);
+	for(i = 0; i < n; i++)
+	{	p[i].clear();
+		for(j = 0; j < n; j++) if( j + 1 >= i && j <= i + 1 )
+		{	p[i].insert(j);
+			row.push_back(i);
+			col.push_back(j);
+		}
+	}
+	K = row.size();
+	hes.resize(K);
+	for(ell = 2; ell < n_method; ell++)
+	{	CppAD::sparse_hessian_work work;
+		work.color_method = method[ell];
+		n_sweep[ell] = f.SparseHessian(x, w, p, row, col, hes, work);
+		for(k = 0; k < K; k++)
+		{	i = row[k];
+			j = col[k];
+			double value = 0.;
+			if( i == j && i + 1 < n )
+				value += 2. * x[i+1];
+			if( i == j + 1 || j == i + 1 )
+				value += 2. * x[ std::min(i, j) ];
+			ok &= NearEqual(value, hes[k], eps, eps);
+		}
+	}
+	ok &= n_sweep[2] == 3;
+	ok &= n_sweep[3] == 2;
+	ok &= n_sweep[4] == 1;
+
+	return ok;
+}
+bool edge_pushing(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::NearEqual;
+	size_t i, j, k;
+	double eps = 100. * CppAD::epsilon<double>();
+
+	// function that uses most of the operators
+	size_t n = 4, m = 3;
+	CppAD::vector< AD<double> > a_x(n), a_y(m);
+	CppAD::vector<double> x(n), w(m);
+	for(j = 0; j < n; j++)
+		a_x[j] = x[j] = 0.1 * double(j + 1);
+	CppAD::Independent(a_x);
+	AD<double> a_sum = 2. * a_x[0] + a_x[1] - a_x[2] - 3.;
+	a_y[0]  = a_sum * a_sum + a_x[0] * a_x[1] / a_x[2];
+	a_y[0] += pow(a_x[1], a_x[2]) + pow(a_x[2], 3.) + pow(2., a_x[3]);
+	a_y[0] += sin(a_x[0]) * cos(a_x[1]) + exp(a_x[2]) * log(a_x[3]);
+	a_y[0] += sqrt(a_x[0]) * tan(a_x[1]) + atan(a_x[2]) / a_x[3];
+	a_y[1]  = sinh(a_x[0]) * cosh(a_x[3]) + tanh(a_x[1]) * abs(a_x[2]);
+	a_y[1] += asin(a_x[0]) * acos(a_x[1]) + 3. / a_x[2] + a_x[3] / 4.;
+	a_y[2]  = CondExpLt(a_x[0], a_x[1], a_x[2] * a_x[3], a_x[0] * a_x[0]);
+	CppAD::ADFun<double> f(a_x, a_y);
+	// use cumulative summations and conditional skips
+	f.optimize();
+	for(i = 0; i < m; i++)
+		w[i] = double(i + 1);
+	CppAD::vector<double> check = f.Hessian(x, w);
+
+	// sparsity pattern corresponding to all the entries
+	CppAD::vector<bool> p(n * n);
+	CppAD::vector<size_t> row, col;
+	for(i = 0; i < n; i++)
+	{	for(j = 0; j < n; j++)
+		{	p[i * n + j] = true;
+			row.push_back(i);
+			col.push_back(j);
+		}
+	}
+	size_t K = row.size();
+	CppAD::vector<double> hes(K);
+
+	// edge pushing uses one sweep
+	CppAD::sparse_hessian_work work;
+	work.color_method = "cppad.edge";
+	size_t n_sweep = f.SparseHessian(x, w, p, row, col, hes, work);
+	ok &= n_sweep == 1;
+	for(k = 0; k < K; k++)
+		ok &= NearEqual(check[k], hes[k], eps, eps);
+
+	// other branch of the conditional expression
+	x[0] = 0.3;
+	x[1] = 0.2;
+	check = f.Hessian(x, w);
+	n_sweep = f.SparseHessian(x, w, p, row, col, hes, work);
+	ok &= n_sweep == 1;
+	for(k = 0; k < K; k++)
+		ok &= NearEqual(check[k], hes[k], eps, eps);
+
+	// VecAD operations are not supported by edge pushing
+	CppAD::VecAD<double> a_v(2);
+	AD<double> a_zero = 0.;
+	Independent(a_x);
+	a_v[a_zero] = a_x[0] * a_x[1];
+	a_y[0] = a_v[a_zero] * a_x[2];
+	a_y[1] = a_x[3] * a_x[3];
+	a_y[2] = 0.;
+	f.Dependent(a_x, a_y);
+	check = f.Hessian(x, w);
+	work.clear();
+	work.color_method = "cppad.edge";
+	n_sweep = f.SparseHessian(x, w, p, row, col, hes, work);
+	ok &= work.color_method == "cppad.symmetric";
+	ok &= n_sweep > 1;
+	for(k = 0; k < K; k++)
+		ok &= NearEqual(check[k], hes[k], eps, eps);
+
+	return ok;
+}
 
 
 template <class VectorBase, class VectorBool> 
@@ -236,6 +430,8 @@ bool sparse_hessian(void)
 {	bool ok = true;
 
 	ok &= rc_tridiagonal();
+	ok &= color_method();
+	ok &= edge_pushing();
 	// ---------------------------------------------------------------
 	// vector of bool cases
 	ok &= bool_case< CppAD::vector  <double>, CppAD::vectorBool   >();
@@ -0,0 +1,177 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+Test the sparse_hybrid vector of sets (each set a list or packed bools).
+*/
+# include <cppad/cppad.hpp>
+# include <cppad/local/sparse_hybrid.hpp>
+# include <set>
+
+namespace {
+	typedef CppAD::vector< std::set<size_t> > vector_set;
+
+	// check that a sparse_hybrid has the same sets as a vector of std::set
+	bool check_sets(CppAD::sparse_hybrid& list, const vector_set& check)
+	{	bool ok = true;
+		size_t end = list.end();
+		for(size_t i = 0; i < list.n_set(); i++)
+		{	std::set<size_t>::const_iterator itr = check[i].begin();
+			list.begin(i);
+			size_t element = list.next_element();
+			while( element != end )
+			{	ok &= itr != check[i].end();
+				if( ok )
+					ok &= *itr++ == element;
+				element = list.next_element();
+			}
+			ok &= itr == check[i].end();
+			for(element = 0; element < end; element++)
+			{	bool found = check[i].find(element) != check[i].end();
+				ok &= list.is_element(i, element) == found;
+			}
+		}
+		return ok;
+	}
+	// ----------------------------------------------------------------
+	// compare the results of random operations with std::set operations
+	bool random_operations(void)
+	{	bool ok = true;
+		size_t n_set = 10, end = 200;
+
+		CppAD::sparse_hybrid left, right;
+		left.resize(n_set, end);
+		right.resize(n_set, end);
+		vector_set left_check(n_set), right_check(n_set);
+
+		// simple pseudo random numbers
+		size_t seed = 1;
+		for(size_t k = 0; k < 5000; k++)
+		{	seed = (1103515245 * seed + 12345) % 2147483648u;
+			size_t op     = (seed / 65536) % 5;
+			size_t target = (seed / 16) % n_set;
+			size_t source = (seed / 256) % n_set;
+			size_t value  = (seed / 4096) % end;
+			bool   same   = (seed / 8) % 2 == 0;
+			CppAD::sparse_hybrid& other       = same ? left : right;
+			vector_set&         other_check = same ? left_check : right_check;
+			std::set<size_t> result;
+			switch(op)
+			{	case 0:
+				left.add_element(target, value);
+				left_check[target].insert(value);
+				break;
+
+				case 1:
+				right.add_element(source, value);
+				right_check[source].insert(value);
+				break;
+
+				case 2:
+				left.assignment(target, source, other);
+				left_check[target] = other_check[source];
+				break;
+
+				case 3:
+				result = left_check[source];
+				result.insert(
+					other_check[value % n_set].begin(),
+					other_check[value % n_set].end()
+				);
+				left.binary_union(target, source, value % n_set, other);
+				left_check[target] = result;
+				break;
+
+				case 4:
+				if( value % 4 == 0 )
+				{	left.clear(target);
+					left_check[target].clear();
+				}
+				break;
+			}
+			if( k % 100 == 0 )
+			{	ok &= check_sets(left, left_check);
+				ok &= check_sets(right, right_check);
+			}
+		}
+		ok &= check_sets(left, left_check);
+		ok &= check_sets(right, right_check);
+
+		size_t count = 0;
+		for(size_t i = 0; i < n_set; i++)
+			count += left_check[i].size();
+		ok &= left.number_elements() == count;
+
+		return ok;
+	}
+	// ----------------------------------------------------------------
+	// sparse sets are lists and dense sets are packed
+	bool sparse_and_dense(void)
+	{	bool ok = true;
+		size_t n_set = 1000, end = 1000 * 64, i, j;
+		size_t n_pack = end / std::numeric_limits<size_t>::digits;
+
+		CppAD::sparse_hybrid hybrid;
+		hybrid.resize(n_set, end);
+		vector_set check(n_set);
+
+		// each set has one element
+		for(i = 0; i < n_set; i++)
+		{	hybrid.add_element(i, i * 64);
+			check[i].insert(i * 64);
+		}
+		// much less memory than packing all the sets
+		ok &= hybrid.memory() < n_set * n_pack * sizeof(size_t) / 10;
+
+		// set zero is dense
+		for(j = 0; j < end; j += 2)
+		{	hybrid.add_element(0, j);
+			check[0].insert(j);
+		}
+		// union of a dense set and a sparse set
+		hybrid.binary_union(1, 1, 0, hybrid);
+		check[1].insert(check[0].begin(), check[0].end());
+
+		// union of two lists that is dense
+		for(j = 0; j < n_pack; j++)
+		{	hybrid.add_element(2, 2 * j + 1);
+			check[2].insert(2 * j + 1);
+			hybrid.add_element(3, 2 * j + 3);
+			check[3].insert(2 * j + 3);
+		}
+		hybrid.binary_union(4, 2, 3, hybrid);
+		check[4] = check[2];
+		check[4].insert(check[3].begin(), check[3].end());
+
+		// a dense set becomes sparse
+		hybrid.assignment(0, n_set - 1, hybrid);
+		check[0] = check[n_set - 1];
+		ok &= check_sets(hybrid, check);
+
+		// the dense sets use their packed values
+		ok &= hybrid.memory() < n_set * n_pack * sizeof(size_t) / 10;
+
+		size_t count = 0;
+		for(i = 0; i < n_set; i++)
+			count += check[i].size();
+		ok &= hybrid.number_elements() == count;
+
+		return ok;
+	}
+}
+
+bool sparse_hybrid(void)
+{	bool ok = true;
+	ok     &= random_operations();
+	ok     &= sparse_and_dense();
+	return ok;
+}
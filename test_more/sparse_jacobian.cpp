@@ -1,6 +1,6 @@
 /* $Id$ */
 /* --------------------------------------------------------------------------
-CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-14 Bradley M. Bell
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
 
 CppAD is distributed under multiple licenses. This distribution is under
 the terms of the 
@@ -549,6 +549,65 @@ bool multiple_of_n_bit(void)
 
 	return ok;
 }
+bool max_direction(void)
+{	bool ok = true;
+	using CppAD::AD;
+	using CppAD::vector;
+	size_t i, j, k, ell;
+
+	// banded lower triangular function with band width 10
+	size_t n = 25, band = 10;
+	vector< AD<double> > a_x(n), a_y(n);
+	for(j = 0; j < n; j++)
+		a_x[j] = double(j + 1);
+	CppAD::Independent(a_x);
+	for(i = 0; i < n; i++)
+	{	a_y[i] = 0.;
+		for(j = i + 1 - std::min(i + 1, band); j <= i; j++)
+			a_y[i] += double(i + 1) * a_x[j] * a_x[j];
+	}
+	CppAD::ADFun<double> f(a_x, a_y);
+
+	// sparsity pattern and the row and column indices for the band
+	vector<bool> p(n * n);
+	vector<size_t> row, col;
+	for(i = 0; i < n; i++)
+	{	for(j = 0; j < n; j++)
+		{	p[i * n + j] = j <= i && i < j + band;
+			if( p[i * n + j] )
+			{	row.push_back(i);
+				col.push_back(j);
+			}
+		}
+	}
+	size_t K = row.size();
+
+	// point at which to compute the Jacobian
+	vector<double> x(n), jac(K);
+	for(j = 0; j < n; j++)
+		x[j] = double(j + 2);
+
+	// the number of colors does not depend on max_direction
+	size_t max_r[] = { 1, 3, 4, 64, 0 };
+	for(ell = 0; ell < sizeof(max_r) / sizeof(max_r[0]); ell++)
+	{	CppAD::sparse_jacobian_work work;
+		work.max_direction = max_r[ell];
+		size_t n_sweep = f.SparseJacobianForward(x, p, row, col, jac, work);
+		ok &= n_sweep == band;
+		for(k = 0; k < K; k++)
+		{	double check = 2. * double(row[k] + 1) * x[ col[k] ];
+			ok &= CppAD::NearEqual(check, jac[k], 1e-10, 1e-10);
+		}
+	}
+
+	// clear resets max_direction to automatic
+	CppAD::sparse_jacobian_work work;
+	work.max_direction = 2;
+	work.clear();
+	ok &= work.max_direction == 0;
+
+	return ok;
+}
 } // End empty namespace 
 # include <vector>
 # include <valarray>
@@ -556,6 +615,7 @@ bool sparse_jacobian(void)
 {	bool ok = true;
 	ok &= rc_tridiagonal();
 	ok &= multiple_of_n_bit();
+	ok &= max_direction();
 	// ---------------------------------------------------------------
 	// vector of bool cases
 	ok &=      rc_bool< CppAD::vector<double>, CppAD::vectorBool   >();
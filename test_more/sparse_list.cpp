@@ -0,0 +1,159 @@
+/* $Id$ */
+/* --------------------------------------------------------------------------
+CppAD: C++ Algorithmic Differentiation: Copyright (C) 2003-15 Bradley M. Bell
+
+CppAD is distributed under multiple licenses. This distribution is under
+the terms of the
+                    Eclipse Public License Version 1.0.
+
+A copy of this license is included in the COPYING file of this distribution.
+Please visit http://www.coin-or.org/CppAD/ for information on other licenses.
+-------------------------------------------------------------------------- */
+
+/*
+Test the sparse_list vector of sets (which shares lists between sets).
+*/
+# include <cppad/cppad.hpp>
+# include <set>
+
+namespace {
+	typedef CppAD::vector< std::set<size_t> > vector_set;
+
+	// check that a sparse_list has the same sets as a vector of std::set
+	bool check_sets(CppAD::sparse_list& list, const vector_set& check)
+	{	bool ok = true;
+		size_t end = list.end();
+		for(size_t i = 0; i < list.n_set(); i++)
+		{	std::set<size_t>::const_iterator itr = check[i].begin();
+			list.begin(i);
+			size_t element = list.next_element();
+			while( element != end )
+			{	ok &= itr != check[i].end();
+				if( ok )
+					ok &= *itr++ == element;
+				element = list.next_element();
+			}
+			ok &= itr == check[i].end();
+			for(element = 0; element < end; element++)
+			{	bool found = check[i].find(element) != check[i].end();
+				ok &= list.is_element(i, element) == found;
+			}
+		}
+		return ok;
+	}
+	// ----------------------------------------------------------------
+	// compare the results of random operations with std::set operations
+	bool random_operations(void)
+	{	bool ok = true;
+		size_t n_set = 10, end = 20;
+
+		CppAD::sparse_list left, right;
+		left.resize(n_set, end);
+		right.resize(n_set, end);
+		vector_set left_check(n_set), right_check(n_set);
+
+		// simple pseudo random numbers
+		size_t seed = 1;
+		for(size_t k = 0; k < 5000; k++)
+		{	seed = (1103515245 * seed + 12345) % 2147483648u;
+			size_t op     = (seed / 65536) % 5;
+			size_t target = (seed / 16) % n_set;
+			size_t source = (seed / 256) % n_set;
+			size_t value  = (seed / 4096) % end;
+			bool   same   = (seed / 8) % 2 == 0;
+			CppAD::sparse_list& other       = same ? left : right;
+			vector_set&         other_check = same ? left_check : right_check;
+			std::set<size_t> result;
+			switch(op)
+			{	case 0:
+				left.add_element(target, value);
+				left_check[target].insert(value);
+				break;
+
+				case 1:
+				right.add_element(source, value);
+				right_check[source].insert(value);
+				break;
+
+				case 2:
+				left.assignment(target, source, other);
+				left_check[target] = other_check[source];
+				break;
+
+				case 3:
+				result = left_check[source];
+				result.insert(
+					other_check[value % n_set].begin(),
+					other_check[value % n_set].end()
+				);
+				left.binary_union(target, source, value % n_set, other);
+				left_check[target] = result;
+				break;
+
+				case 4:
+				if( value % 4 == 0 )
+				{	left.clear(target);
+					left_check[target].clear();
+				}
+				break;
+			}
+			if( k % 100 == 0 )
+			{	ok &= check_sets(left, left_check);
+				ok &= check_sets(right, right_check);
+			}
+		}
+		ok &= check_sets(left, left_check);
+		ok &= check_sets(right, right_check);
+
+		size_t count = 0;
+		for(size_t i = 0; i < n_set; i++)
+			count += left_check[i].size();
+		ok &= left.number_elements() == count;
+
+		return ok;
+	}
+	// ----------------------------------------------------------------
+	// equal sets share their elements
+	bool shared_memory(void)
+	{	bool ok = true;
+		size_t n_set = 1000, end = 1000, i, j;
+
+		CppAD::sparse_list list;
+		list.resize(n_set, end);
+		vector_set check(n_set);
+
+		// set zero is all the elements except the last one
+		for(j = 0; j < end - 1; j++)
+		{	list.add_element(0, j);
+			check[0].insert(j);
+		}
+		size_t memory = list.memory();
+
+		// the other sets are the same as set zero (or a subset of it)
+		for(i = 1; i < n_set; i++)
+		{	if( i % 2 )
+				list.assignment(i, i - 1, list);
+			else
+				list.binary_union(i, i - 1, i / 2, list);
+			check[i] = check[0];
+		}
+		ok &= list.memory() == memory;
+		ok &= list.number_elements() == n_set * (end - 1);
+
+		// changing one set does not change the others (copy on write)
+		list.add_element(n_set / 2, end - 1);
+		check[n_set / 2].insert(end - 1);
+		list.clear(n_set - 1);
+		check[n_set - 1].clear();
+		ok &= check_sets(list, check);
+
+		return ok;
+	}
+}
+
+bool sparse_list(void)
+{	bool ok = true;
+	ok     &= random_operations();
+	ok     &= shared_memory();
+	return ok;
+}
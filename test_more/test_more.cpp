@@ -23,6 +23,7 @@ extern bool adfun_copy(void);
 extern bool Add(void);
 extern bool AddEq(void);
 extern bool AddZero(void);
+extern bool alloc_statistics(void);
 extern bool alloc_openmp(void);
 extern bool Asin(void);
 extern bool assign(void);
@@ -67,6 +68,7 @@ extern bool Neg(void);
 extern bool ode_err_control(void);
 extern bool optimize(void);
 extern bool parameter(void);
+extern bool pod_arena(void);
 extern bool Poly(void);
 extern bool Pow(void);
 extern bool PowInt(void);
@@ -83,7 +85,9 @@ extern bool Sin(void);
 extern bool SinCos(void);
 extern bool Sinh(void);
 extern bool sparse_hessian(void);
+extern bool sparse_hybrid(void);
 extern bool sparse_jacobian(void);
+extern bool sparse_list(void);
 extern bool sparse_vec_ad(void);
 extern bool Sqrt(void);
 extern bool std_math(void);
@@ -137,6 +141,7 @@ int main(void)
 	ok &= Run( Add,             "Add"            );
 	ok &= Run( AddEq,           "AddEq"          );
 	ok &= Run( AddZero,         "AddZero"        );
+	ok &= Run( alloc_statistics, "alloc_statistics");
 	ok &= Run( Asin,            "Asin"           );
 	ok &= Run( assign,          "assign"         );
 	ok &= Run( Atan,            "Atan"           );
@@ -176,6 +181,7 @@ int main(void)
 	ok &= Run( ode_err_control, "ode_err_control");
 	ok &= Run( optimize,        "optimize"       );
 	ok &= Run( parameter,       "parameter"      );
+	ok &= Run( pod_arena,       "pod_arena"      );
 	ok &= Run( Poly,            "Poly"           );
 	ok &= Run( Pow,             "Pow"            );
 	ok &= Run( PowInt,          "PowInt"         );
@@ -192,7 +198,9 @@ int main(void)
 	ok &= Run( SinCos,          "SinCos"         );
 	ok &= Run( Sinh,            "Sinh"           );
 	ok &= Run( sparse_hessian,  "sparse_hessian" );
+	ok &= Run( sparse_hybrid,   "sparse_hybrid"  );
 	ok &= Run( sparse_jacobian, "sparse_jacobian");
+	ok &= Run( sparse_list,     "sparse_list"    );
 	ok &= Run( sparse_vec_ad,   "sparse_vec_ad"  );
 	ok &= Run( Sqrt,            "Sqrt"           );
 	ok &= Run( std_math,        "std_math"       );